@@ -13,7 +13,7 @@ demo_create_feature_debugbox(gui_handle_p parent, uint8_t protect) {
     gui_protect(protect);
     
     /* Create debug box */
-    h = gui_debugbox_create(0, 0, 0, 1, 1, parent, debugbox_callback, GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE);
+    h = gui_debugbox_create(ID_DEBUGBOX, 0, 0, 1, 1, parent, debugbox_callback, GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE);
     gui_widget_setpositionpercent(h, 1, 1);
     gui_widget_setsizepercent(h, 98, 98);
     gui_debugbox_setmaxitems(h, 100);
@@ -14,7 +14,7 @@ demo_create_feature_progbar(gui_handle_p parent, uint8_t protect) {
     gui_protect(protect);
 
     /* First progbar */
-    h = gui_progbar_create(0, 0, 0, 0, 0, parent, progbar_callback, GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE);
+    h = gui_progbar_create(ID_PROGBAR, 0, 0, 0, 0, parent, progbar_callback, GUI_FLAG_WIDGET_CREATE_IGNORE_INVALIDATE);
     gui_widget_setsizepercent(h, 98, 8.5f);
     gui_widget_setpositionpercent(h, 1, 1);
     gui_progbar_setmin(h, 0);
@@ -13,7 +13,7 @@ extern "C" {
  * \brief           Window data structure
  */
 typedef struct {
-    gui_dim_t id;
+    gui_id_t id;
     const gui_char* title;
     void(*feature_create_fn)(gui_handle_p parent, uint8_t protect);
 } win_data_t;
@@ -54,9 +54,11 @@ typedef struct {
 #define ID_WIN_CHECKBOX                     (ID_WIN_BASIC + 0x00E)
 #define ID_WIN_DEBUGBOX                     (ID_WIN_BASIC + 0x00F)
 
-/* Graph ID */
+/* Widget IDs */
 #define ID_WIDGET_BASIC                     (GUI_ID_USER + 0x300)
 #define ID_GRAPH                            (ID_WIDGET_BASIC + 0x001)
+#define ID_DEBUGBOX                         (ID_WIDGET_BASIC + 0x002)
+#define ID_PROGBAR                          (ID_WIDGET_BASIC + 0x003)
 
 /* List of fonts */
 extern gui_const gui_font_t GUI_Font_Calibri_Bold_8;
@@ -34,6 +34,8 @@
 #include "gui/gui_private.h"
 #include "gui/gui.h"
 #include "system/gui_sys.h"
+#include "gui/gui_render.h"
+#include "gui/gui_profiler.h"
 
 /**
  * \brief           GUI global structure
@@ -108,135 +110,189 @@ check_disp_clipping(gui_handle_p h) {
 #endif /* !GUI_CFG_USE_POS_SIZE_CACHE */
 }
 
+static uint32_t redraw_widgets(gui_handle_p parent, uint8_t force_redraw);
+
 /**
- * \brief           Redraw all widgets of selected parent
- * \param[in]       parent: Parent widget handle to draw widgets on
- * \param[in]       force_redraw: Set to 1 to force drawing all widgets on linked list
+ * \brief           Redraw widget and its children inside current clipping region
+ * \param[in]       h: Widget handle to redraw
+ * \param[in]       force_redraw: Set to 1 to force drawing widget even if not marked for redraw
  * \return          Number of widgets redrawn
  */
 static uint32_t
-redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
-    gui_handle_p h;
+redraw_widget(gui_handle_p h, uint8_t force_redraw) {
     uint32_t cnt = 0;
     static uint32_t level = 0;
 
-    /* Go through all elements of parent */
-    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
-        if (!guii_widget_isvisible(h)) {            /* Check if visible */
-            guii_widget_clrflag(h, GUI_FLAG_REDRAW);/* Clear flag to be sure */
-            continue;                               /* Ignore hidden elements */
-        }
-        if (guii_widget_isinsideclippingregion(h, 1)) { /* If widget is inside clipping region and not fully covered by any of its siblings */
-            /* Draw main widget if required */
-            if (guii_widget_getflag(h, GUI_FLAG_REDRAW) || force_redraw) {    /* Check if redraw required */
+    if (!guii_widget_isvisible(h)) {            /* Check if visible */
+        guii_widget_clrflag(h, GUI_FLAG_REDRAW);/* Clear flag to be sure */
+        return 0;                               /* Ignore hidden elements */
+    }
+    if (guii_widget_isinsideclippingregion(h, 1)) { /* If widget is inside clipping region and not fully covered by any of its siblings */
+        /* Draw main widget if required */
+        if (guii_widget_getflag(h, GUI_FLAG_REDRAW) || h->redraw_frame == GUI.redraw_stats.frames || force_redraw) {  /* Check if redraw required */
 #if GUI_CFG_USE_ALPHA
-                gui_layer_t* layerPrev = GUI.lcd.drawing_layer; /* Save drawing layer */
-                uint8_t transparent = 0;
+            gui_layer_t* layerPrev = GUI.lcd.drawing_layer; /* Save drawing layer */
+            uint8_t transparent = 0;
 #endif /* GUI_CFG_USE_ALPHA */
-                
-                guii_widget_clrflag(h, GUI_FLAG_REDRAW);    /* Clear flag for drawing on widget */
-                
-                /* Prepare clipping region for this widget drawing */
-                check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
+            
+            guii_widget_clrflag(h, GUI_FLAG_REDRAW);    /* Clear flag for drawing on widget */
+            h->redraw_frame = GUI.redraw_stats.frames;  /* Widget must be redrawn in remaining dirty rectangles too */
+            
+            /* Prepare clipping region for this widget drawing */
+            check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
 
 #if GUI_CFG_USE_ALPHA
-                /* Check alpha and check if blending function exists to merge layers later together */
-                if (guii_widget_hasalpha(h) /* && GUI.ll.CopyBlend != NULL */) {
-                    gui_dim_t width = GUI.display_temp.x2 - GUI.display_temp.x1;
-                    gui_dim_t height = GUI.display_temp.y2 - GUI.display_temp.y1;
-                    
-                    /* Try to allocate memory for new virtual layer for temporary usage */
-                    GUI.lcd.drawing_layer = GUI_MEMALLOC(sizeof(*GUI.lcd.drawing_layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size);
-                    
-                    if (GUI.lcd.drawing_layer != NULL) {/* Check if allocation was successful */
-                        GUI.lcd.drawing_layer->width = width;
-                        GUI.lcd.drawing_layer->height = height;
-                        GUI.lcd.drawing_layer->x_pos = GUI.display_temp.x1;
-                        GUI.lcd.drawing_layer->y_pos = GUI.display_temp.y1;
-                        GUI.lcd.drawing_layer->start_address = ((uint8_t *)GUI.lcd.drawing_layer) + sizeof(*GUI.lcd.drawing_layer);
-                        transparent = 1;            /* We are going to transparent drawing mode */
-                    } else {
-                        GUI.lcd.drawing_layer = layerPrev;  /* Reset layer back */
-                    }
-                }
-#endif /* GUI_CFG_USE_ALPHA */
+            /* Check alpha and check if blending function exists to merge layers later together */
+            if (guii_widget_hasalpha(h) /* && GUI.ll.CopyBlend != NULL */) {
+                gui_dim_t width = GUI.display_temp.x2 - GUI.display_temp.x1;
+                gui_dim_t height = GUI.display_temp.y2 - GUI.display_temp.y1;
                 
-                /* Draw widget itself normally, don't care on layer offset and size */
-                GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &GUI.display_temp;
-                guii_widget_callback(h, GUI_EVT_DRAW, &GUI.evt_param, &GUI.evt_result);
+                /* Try to allocate memory for new virtual layer for temporary usage */
+                GUI.lcd.drawing_layer = GUI_MEMALLOC(sizeof(*GUI.lcd.drawing_layer) + (size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size);
                 
-                /* Check if there are children widgets in this widget */
-                if (guii_widget_haschildren(h)) {   /* Check if widget has children */
-                    /* ...now call function for actual redrawing process */
-                    /* Force children redraw operation, even if no redraw flag set */
-                    level++;
-                    cnt += redraw_widgets(h, 1);    /* Redraw children widgets */
-                    level--;
+                if (GUI.lcd.drawing_layer != NULL) {/* Check if allocation was successful */
+                    GUI.lcd.drawing_layer->width = width;
+                    GUI.lcd.drawing_layer->height = height;
+                    GUI.lcd.drawing_layer->x_pos = GUI.display_temp.x1;
+                    GUI.lcd.drawing_layer->y_pos = GUI.display_temp.y1;
+                    GUI.lcd.drawing_layer->start_address = ((uint8_t *)GUI.lcd.drawing_layer) + sizeof(*GUI.lcd.drawing_layer);
+                    transparent = 1;            /* We are going to transparent drawing mode */
+                } else {
+                    GUI.lcd.drawing_layer = layerPrev;  /* Reset layer back */
                 }
-                
-                /* TODO: Copy previous temporary variables instead of calling function again */
-                /* Prepare clipping region for this widget drawing */
-                check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
-                
-                /* Draw widget itself normally, don't care on layer offset and size */
+            }
+#endif /* GUI_CFG_USE_ALPHA */
+            
+            /* Draw widget itself normally, don't care on layer offset and size */
+            /* Skip part of widget which is overpainted by its opaque children anyway */
+#if GUI_CFG_USE_ALPHA
+            if (transparent || guii_widget_clipopaquechildren(h, &GUI.display_temp))
+#else /* GUI_CFG_USE_ALPHA */
+            if (guii_widget_clipopaquechildren(h, &GUI.display_temp))
+#endif /* !GUI_CFG_USE_ALPHA */
+            {
                 GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &GUI.display_temp;
-                guii_widget_callback(h, GUI_EVT_DRAWAFTER, &GUI.evt_param, &GUI.evt_result);
-                
+                GUI_PROFILER_BEGIN();
+                guii_widget_callback(h, GUI_EVT_DRAW, &GUI.evt_param, &GUI.evt_result);
+                GUI_PROFILER_END(GUI_PROFILER_EVT_WIDGET, h,
+                    (uint32_t)(GUI.display_temp.x2 - GUI.display_temp.x1) * (uint32_t)(GUI.display_temp.y2 - GUI.display_temp.y1), 0);
+            }
+            
+            /* Check if there are children widgets in this widget */
+            if (guii_widget_haschildren(h)) {   /* Check if widget has children */
+                /* ...now call function for actual redrawing process */
+                /* Force children redraw operation, even if no redraw flag set */
+                level++;
+                cnt += redraw_widgets(h, 1);    /* Redraw children widgets */
+                level--;
+            }
+            
+            /* TODO: Copy previous temporary variables instead of calling function again */
+            /* Prepare clipping region for this widget drawing */
+            check_disp_clipping(h);             /* Check coordinates for drawings only particular widget */
+            
+            /* Draw widget itself normally, don't care on layer offset and size */
+            GUI_EVT_PARAMTYPE_DISP(&GUI.evt_param) = &GUI.display_temp;
+            guii_widget_callback(h, GUI_EVT_DRAWAFTER, &GUI.evt_param, &GUI.evt_result);
+            
 #if GUI_CFG_USE_ALPHA
-                /* If transparent mode is used on widget, copy content back */
-                if (transparent) {                  /* If we are in transparent mode */
-                    /* Copy layers with blending */
-                    if (GUI.ll.CopyBlend != NULL) { /* Hardware way */
-                        GUI.ll.CopyBlend(&GUI.lcd, GUI.lcd.drawing_layer,
-                            (void *)(((uint8_t *)layerPrev->start_address) +
-                                GUI.lcd.pixel_size * (layerPrev->width * (GUI.lcd.drawing_layer->y_pos - layerPrev->y_pos) + (GUI.lcd.drawing_layer->x_pos - layerPrev->x_pos))),
-                            (void *)GUI.lcd.drawing_layer->start_address,
-                            gui_widget_getalpha(h), 0xFF,
-                            GUI.lcd.drawing_layer->width, GUI.lcd.drawing_layer->height,
-                            layerPrev->width - GUI.lcd.drawing_layer->width, 0
-                        );
-                    } else {                        /* Software way, ugly and slow way */
-                        gui_dim_t x, y, dxo, dyo;
-                        gui_color_t fg, bg;
-                        uint8_t r, g, b;
-                        float a;
-
-                        /* Get difference in offset */
-                        dxo = GUI.lcd.drawing_layer->x_pos - layerPrev->x_pos;
-                        dyo = GUI.lcd.drawing_layer->y_pos - layerPrev->y_pos;;
-
-                        a = GUI_FLOAT(gui_widget_getalpha(h)) / GUI_FLOAT(0xFF);
-                        for (y = 0; y < GUI.lcd.drawing_layer->height; y++) {
-                            for (x = 0; x < GUI.lcd.drawing_layer->width; x++) {
-                                fg = GUI.ll.GetPixel(&GUI.lcd, GUI.lcd.drawing_layer, x, y);
-                                bg = GUI.ll.GetPixel(&GUI.lcd, layerPrev, dxo + x, dyo + y);
-
-                                r = GUI_U8(((fg >> 16) & 0xFF) * a + (1.0f - a) * ((bg >> 16) & 0xFF));
-                                g = GUI_U8(((fg >> 8) & 0xFF) * a + (1.0f - a) * ((bg >> 8) & 0xFF));
-                                b = GUI_U8(((fg >> 0) & 0xFF) * a + (1.0f - a) * ((bg >> 0) & 0xFF));
-                                
-                                fg = (gui_color_t)(0xFF000000UL | (uint8_t)r << 16 | (uint8_t)g << 8 | (uint8_t)b);
-                                
-                                GUI.ll.SetPixel(&GUI.lcd, layerPrev, dxo + x, dyo + y, fg);
-                            }
-                        }                        
-                    }
-                    
-                    GUI_MEMFREE(GUI.lcd.drawing_layer); /* Free memory for virtual layer */
-                    GUI.lcd.drawing_layer = layerPrev;  /* Reset layer pointer */
+            /* If transparent mode is used on widget, copy content back */
+            if (transparent) {                  /* If we are in transparent mode */
+                /* Copy layers with blending */
+                if (GUI.ll.CopyBlend != NULL) { /* Hardware way */
+                    GUI.ll.CopyBlend(&GUI.lcd, GUI.lcd.drawing_layer,
+                        (void *)(((uint8_t *)layerPrev->start_address) +
+                            GUI.lcd.pixel_size * (layerPrev->width * (GUI.lcd.drawing_layer->y_pos - layerPrev->y_pos) + (GUI.lcd.drawing_layer->x_pos - layerPrev->x_pos))),
+                        (void *)GUI.lcd.drawing_layer->start_address,
+                        gui_widget_getalpha(h), 0xFF,
+                        GUI.lcd.drawing_layer->width, GUI.lcd.drawing_layer->height,
+                        layerPrev->width - GUI.lcd.drawing_layer->width, 0
+                    );
+                } else {                        /* Software way, ugly and slow way */
+                    gui_dim_t x, y, dxo, dyo;
+                    gui_color_t fg, bg;
+                    uint8_t r, g, b;
+                    float a;
+
+                    /* Get difference in offset */
+                    dxo = GUI.lcd.drawing_layer->x_pos - layerPrev->x_pos;
+                    dyo = GUI.lcd.drawing_layer->y_pos - layerPrev->y_pos;;
+
+                    a = GUI_FLOAT(gui_widget_getalpha(h)) / GUI_FLOAT(0xFF);
+                    for (y = 0; y < GUI.lcd.drawing_layer->height; y++) {
+                        for (x = 0; x < GUI.lcd.drawing_layer->width; x++) {
+                            fg = GUI.ll.GetPixel(&GUI.lcd, GUI.lcd.drawing_layer, x, y);
+                            bg = GUI.ll.GetPixel(&GUI.lcd, layerPrev, dxo + x, dyo + y);
+
+                            r = GUI_U8(((fg >> 16) & 0xFF) * a + (1.0f - a) * ((bg >> 16) & 0xFF));
+                            g = GUI_U8(((fg >> 8) & 0xFF) * a + (1.0f - a) * ((bg >> 8) & 0xFF));
+                            b = GUI_U8(((fg >> 0) & 0xFF) * a + (1.0f - a) * ((bg >> 0) & 0xFF));
+                            
+                            fg = (gui_color_t)(0xFF000000UL | (uint8_t)r << 16 | (uint8_t)g << 8 | (uint8_t)b);
+                            
+                            GUI.ll.SetPixel(&GUI.lcd, layerPrev, dxo + x, dyo + y, fg);
+                        }
+                    }                        
                 }
+                
+                GUI_MEMFREE(GUI.lcd.drawing_layer); /* Free memory for virtual layer */
+                GUI.lcd.drawing_layer = layerPrev;  /* Reset layer pointer */
+            }
 #endif /* GUI_CFG_USE_ALPHA */
 
-                cnt++;
-            /* Check if any child widget needs drawing */
-            } else if (guii_widget_haschildren(h)) {
-                cnt += redraw_widgets(h, 0);        /* Redraw children widgets */
-            }
+            cnt++;
+        /* Check if any child widget needs drawing */
+        } else if (guii_widget_haschildren(h)) {
+            cnt += redraw_widgets(h, 0);        /* Redraw children widgets */
         }
     }
     return cnt;                                     /* Return number of redrawn objects */
 }
 
+/**
+ * \brief           Redraw all widgets of selected parent
+ * \param[in]       parent: Parent widget handle to draw widgets on
+ * \param[in]       force_redraw: Set to 1 to force drawing all widgets on linked list
+ * \return          Number of widgets redrawn
+ */
+static uint32_t
+redraw_widgets(gui_handle_p parent, uint8_t force_redraw) {
+    gui_handle_p h;
+    uint32_t cnt = 0;
+
+    /* Go through all elements of parent */
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        cnt += redraw_widget(h, force_redraw);
+    }
+    return cnt;                                     /* Return number of redrawn objects */
+}
+
+/**
+ * \brief           Redraw widgets inside current clipping region
+ * \param[in]       h: Widget marked for redraw to draw together with its children.
+ *                      Set to `NULL` to check all widgets
+ * \return          Number of widgets redrawn
+ */
+static uint32_t
+redraw_display(gui_handle_p h) {
+    gui_handle_p p;
+    
+    if (h == NULL) {
+        return redraw_widgets(NULL, 0);
+    }
+    if (!guii_widget_isinsideclippingregion(h, 0)) {
+        return 0;                                   /* Widget not in current region */
+    }
+    
+    /* Widget is hidden also when any of its parents is covered by its siblings */
+    for (p = guii_widget_getparent(h); p != NULL; p = guii_widget_getparent(p)) {
+        if (!guii_widget_isinsideclippingregion(p, 1)) {
+            return 0;
+        }
+    }
+    return redraw_widget(h, 1);
+}
+
 #if GUI_CFG_USE_TOUCH
 
 /**
@@ -444,6 +500,9 @@ process_touch(guii_touch_data_t* const touch, gui_touch_data_t* const touch_old,
     static uint8_t isKeyboard = 0;
     uint8_t dialogOnly = 0;
     guii_touch_status_t tStat = touchCONTINUE;
+#if GUI_CFG_USE_POS_SIZE_CACHE
+    gui_widget_grid_t grid_touch = guii_widget_getgridmask(parent, touch->ts.x[0], touch->ts.y[0], touch->ts.x[0], touch->ts.y[0]);
+#endif /* GUI_CFG_USE_POS_SIZE_CACHE */
     
     /*
      * To handle touch events, process widgets in reverse order,
@@ -473,6 +532,13 @@ process_touch(guii_touch_data_t* const touch, gui_touch_data_t* const touch_old,
             break;
         }
         
+#if GUI_CFG_USE_POS_SIZE_CACHE
+        /* Fast reject of widget and all its children when touch is outside grid cells of widget */
+        if (!(guii_widget_getgrid(h) & grid_touch)) {
+            continue;
+        }
+#endif /* GUI_CFG_USE_POS_SIZE_CACHE */
+        
         /* Check for keyboard mode */
         if (h->id == GUI_ID_KEYBOARD_BASE) {
             isKeyboard = 1;                         /* Set keyboard mode as 1 */
@@ -577,6 +643,7 @@ gui_process_touch(void) {
     gui_widget_evt_t rresult;
     
     if (guii_input_touchavailable()) {              /* Check if any touch available */
+        GUI_PROFILER_BEGIN();
         while (guii_input_touchread(&GUI.touch.ts)) {   /* Process all touch events possible */
             /* Set relative coordinates for new widget directly */
             if (GUI.active_widget != NULL && GUI.touch.ts.status) {
@@ -673,6 +740,7 @@ gui_process_touch(void) {
             
             memcpy((void *)&GUI.touch_old, (void *)&GUI.touch.ts, sizeof(GUI.touch_old));   /* Copy current touch to last touch status */
         }
+        GUI_PROFILER_END(GUI_PROFILER_EVT_TOUCH, NULL, 0, 0);
     } else {                                        /* No new touch events, periodically call touch event thread */
         __TouchEvents_Thread(&GUI.touch, &GUI.touch_old, 0, &rresult);   /* Call thread for touch process periodically, handle long presses or timeouts */
         __ProcessAfterTouchEventsThread();          /* Process after event macro */
@@ -733,31 +801,61 @@ process_redraw(void) {
     gui_layer_t* active = GUI.lcd.active_layer;
     gui_layer_t* drawing = GUI.lcd.drawing_layer;
     uint8_t result = 1;
-    gui_display_t* dispA = &active->display;
+    gui_display_t* dispA;
+    uint32_t widgets = 0, pixels = 0;
+    size_t i;
     
     if ((GUI.lcd.flags & GUI_FLAG_LCD_WAIT_LAYER_CONFIRM) || !(GUI.flags & GUI_FLAG_REDRAW)) {  /* Check if anything to draw first */
         return;
     }
     
     GUI.flags &= ~GUI_FLAG_REDRAW;                  /* Clear redraw flag */
+    guii_widget_layout();                           /* Changes from touch and keyboard events */
 
     /* Copy from currently active layer to drawing layer only changes on layer */
-    if (dispA->x1 < GUI.lcd.width && dispA->x2 >= 0 && dispA->y1 < GUI.lcd.height && dispA->y2 >= 0) {
-        GUI.ll.Copy(&GUI.lcd, drawing, 
-            (void *)(((uint8_t *)drawing->start_address) + GUI.lcd.pixel_size * (dispA->y1 * drawing->width + dispA->x1)),   /* Destination address */
-            (void *)(((uint8_t *)active->start_address) + GUI.lcd.pixel_size * (dispA->y1 * active->width + dispA->x1)), /* Source address */
-            dispA->x2 - dispA->x1,                  /* Area width */
-            dispA->y2 - dispA->y1,                  /* Area height */
-            drawing->width - (dispA->x2 - dispA->x1),   /* Offline destination */
-            active->width - (dispA->x2 - dispA->x1) /* Offline source */
-        );
+    for (i = 0; i < active->display_count; i++) {
+        dispA = &active->display[i];
+        if (dispA->x1 < GUI.lcd.width && dispA->x2 >= 0 && dispA->y1 < GUI.lcd.height && dispA->y2 >= 0) {
+            GUI.ll.Copy(&GUI.lcd, drawing, 
+                (void *)(((uint8_t *)drawing->start_address) + GUI.lcd.pixel_size * (dispA->y1 * drawing->width + dispA->x1)),   /* Destination address */
+                (void *)(((uint8_t *)active->start_address) + GUI.lcd.pixel_size * (dispA->y1 * active->width + dispA->x1)), /* Source address */
+                dispA->x2 - dispA->x1,              /* Area width */
+                dispA->y2 - dispA->y1,              /* Area height */
+                drawing->width - (dispA->x2 - dispA->x1),   /* Offline destination */
+                active->width - (dispA->x2 - dispA->x1) /* Offline source */
+            );
+        }
     }
     
-    redraw_widgets(NULL, 0);                        /* Redraw all widgets now on drawing layer */
+    /*
+     * Move dirty rectangles to drawing layer.
+     * Any invalidation during redraw process is saved for next redraw
+     */
+    memcpy(drawing->display, GUI.display_dirty, sizeof(GUI.display_dirty[0]) * GUI.display_dirty_count);
+    drawing->display_count = GUI.display_dirty_count;
+    GUI.display_dirty_count = 0;
+    
+    GUI.redraw_stats.frames++;                      /* Start new frame, widgets redrawn in it are stamped with its number */
+    GUI_PROFILER_BEGIN();
+    for (i = 0; i < drawing->display_count; i++) {
+        pixels += (uint32_t)(drawing->display[i].x2 - drawing->display[i].x1) * (uint32_t)(drawing->display[i].y2 - drawing->display[i].y1);
+    }
+
+    /* Redraw all widgets now on drawing layer, separately for each dirty rectangle */
+#if GUI_CFG_USE_RENDER_TILES
+    widgets = gui_render_tiles(drawing, redraw_display);
+#else /* GUI_CFG_USE_RENDER_TILES */
+    for (i = 0; i < drawing->display_count; i++) {
+        memcpy(&GUI.display, &drawing->display[i], sizeof(GUI.display));
+        widgets += redraw_display(NULL);
+    }
+#endif /* !GUI_CFG_USE_RENDER_TILES */
     drawing->pending = 1;                           /* Set drawing layer as pending */
+    GUI_PROFILER_END(GUI_PROFILER_EVT_REDRAW, NULL, pixels, widgets);
 
-    /* Draw clipping area rectangle on screen for debug */
-    //gui_draw_rectangle(&GUI.display, GUI.display.x1, GUI.display.y1, GUI.display.x2, GUI.display.y2, GUI_COLOR_RED);
+    GUI.redraw_stats.widgets = widgets;             /* Save statistics of this frame */
+    GUI.redraw_stats.rects = (uint32_t)drawing->display_count;
+    GUI.redraw_stats.pixels = pixels;
     
     /* Notify low-level about layer change */
     GUI.lcd.flags |= GUI_FLAG_LCD_WAIT_LAYER_CONFIRM;
@@ -768,9 +866,7 @@ process_redraw(void) {
     GUI.lcd.active_layer = drawing;
     GUI.lcd.drawing_layer = active;
     
-    memcpy(&GUI.lcd.active_layer->display, &GUI.display, sizeof(GUI.display));  /* Copy clipping data to region */
-    
-    /* Invalid clipping region(s) for next drawing process */
+    /* Invalid clipping region for next drawing process */
     GUI.display.x1 = GUI_DIM_MAX;
     GUI.display.y1 = GUI_DIM_MAX;
     GUI.display.x2 = GUI_DIM_MIN;
@@ -793,7 +889,7 @@ default_event_cb(void) {
 static void
 gui_thread(void * const argument) {
     if (argument != NULL) {                         /* If argument exists */
-        *((volatile uint8_t *)argument) = 0x01;     /* Set it to 1, indicate thread started */
+        gui_sys_sem_release((gui_sys_sem_t *)argument); /* Indicate thread started */
     }
     while (1) {
         gui_process();                              /* Process graphical update */
@@ -825,6 +921,9 @@ gui_init(void) {
     result = 1;
     gui_ll_control(&GUI.lcd, GUI_LL_Command_Init, &GUI.ll, &result);/* Call low-level initialization */
     GUI.ll.Init(&GUI.lcd);                          /* Call user LCD driver function */
+#if GUI_CFG_USE_PROFILER
+    guii_profiler_init();                           /* Start counting low-level calls */
+#endif /* GUI_CFG_USE_PROFILER */
     
     /* Check situation with layers */
     if (GUI.lcd.layer_count >= 1) {
@@ -854,11 +953,12 @@ gui_init(void) {
 #if GUI_CFG_OS
     /* Create graphical thread */
     if (GUI.OS.thread_id == NULL) {
-        volatile uint8_t started = 0;
-        if (gui_sys_thread_create(&GUI.OS.thread_id, "gui_thread", gui_thread, (void *)&started, GUI_SYS_THREAD_SS, GUI_SYS_THREAD_PRIO)) {
-            while (!started) {                      /* Wait for thread to start */
-
+        gui_sys_sem_t started;
+        if (gui_sys_sem_create(&started, 0)) {
+            if (gui_sys_thread_create(&GUI.OS.thread_id, "gui_thread", gui_thread, (void *)&started, GUI_SYS_THREAD_SS, GUI_SYS_THREAD_PRIO)) {
+                gui_sys_sem_wait(&started, 0);      /* Wait for thread to start */
             }
+            gui_sys_sem_delete(&started);
         }
     }
 #endif /* GUI_CFG_OS */
@@ -886,8 +986,10 @@ gui_process(void) {
 #endif /* GUI_CFG_OS */
    
     GUI_CORE_PROTECT(1);
+    GUI_PROFILER_BEGIN();
     guii_timer_process();                           /* Process all timers */
     guii_widget_executeremove();                    /* Delete widgets */
+    guii_widget_layout();                           /* Apply pending position/size changes */
 #if GUI_CFG_USE_TOUCH
     gui_process_touch();                            /* Process touch inputs */
 #endif /* GUI_CFG_USE_TOUCH */
@@ -895,6 +997,7 @@ gui_process(void) {
     process_keyboard();                             /* Process keyboard inputs */
 #endif /* GUI_CFG_USE_KEYBOARD */
     process_redraw();                               /* Redraw widgets */
+    GUI_PROFILER_END(GUI_PROFILER_EVT_PROCESS, NULL, 0, 0);
     GUI_CORE_UNPROTECT(1);
     
     return 0;                                       /* Return number of elements updated on GUI */
@@ -915,6 +1018,25 @@ gui_seteventcallback(gui_eventcallback_t cb) {
     return 1;
 }
 
+/**
+ * \brief           Get redraw statistics of last drawn frame
+ *
+ *                  Statistics can be used to measure cost of screen changes,
+ *                  such as number of widgets drawn after user input
+ *
+ * \param[out]      stats: Pointer to \ref gui_redrawstats_t structure to fill
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_getredrawstats(gui_redrawstats_t* stats) {
+    GUI_ASSERTPARAMS(stats != NULL);
+
+    GUI_CORE_PROTECT(1);
+    *stats = GUI.redraw_stats;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
 #if GUI_CFG_OS || __DOXYGEN__
 
 /**
@@ -67,6 +67,79 @@ typedef struct {
     uint8_t isfinal;                                /*!< Status indicating we should do line check and finish */
 } gui_stringrectvars_t;
 
+/**
+ * \brief           Polygon edge in edge table for scanline fill
+ */
+typedef struct {
+    gui_dim_t ys;                                   /*!< First scanline where edge is active */
+    gui_dim_t ye;                                   /*!< Last scanline where edge is active, inclusive */
+    gui_dim_t ya;                                   /*!< Y position of top edge point */
+    gui_dim_t xa;                                   /*!< X position of top edge point, left point for horizontal edge */
+    gui_dim_t xb;                                   /*!< X position of right point for horizontal edge */
+    int32_t x;                                      /*!< Rounded X position on current scanline */
+    int32_t err;                                    /*!< Error term for exact X stepping */
+    int32_t q;                                      /*!< Integer part of X step per scanline */
+    int32_t r;                                      /*!< Remainder of X step per scanline, scaled by `2` */
+    int32_t d;                                      /*!< Step denominator, `2 * dy`. Set to `0` for horizontal edge */
+} gui_poly_edge_t;
+
+/**
+ * \brief           Image data reader, decodes encoded image pixel by pixel
+ */
+typedef struct {
+    const gui_image_desc_t* img;                    /*!< Image descriptor */
+    const uint8_t* data;                            /*!< Pointer to next data byte */
+    uint8_t bits;                                   /*!< Number of bits already read from current byte of indexed image */
+    uint8_t repeat;                                 /*!< Status indicating current run repeats single pixel */
+    uint32_t run;                                   /*!< Number of pixels left in current run */
+    gui_color_t value;                              /*!< Repeated or last decoded pixel */
+    gui_color_t index[64];                          /*!< Array of previously seen pixels for QOI format */
+} gui_image_reader_t;
+
+/**
+ * \brief           Source of scaled or rotated image
+ */
+typedef struct {
+    const gui_image_desc_t* img;                    /*!< Image descriptor */
+    gui_color_t* pixels;                            /*!< Window of up to `2` decoded rows for RLE and QOI images, `NULL` otherwise */
+    gui_dim_t x;                                    /*!< X position of decoded pixels in image */
+    gui_dim_t y;                                    /*!< Y position of first decoded row in image */
+    gui_dim_t width;                                /*!< Width of decoded pixels */
+    gui_dim_t height;                               /*!< Number of decoded rows in window */
+    gui_image_reader_t* reader;                     /*!< Sequential reader of encoded image */
+    uint32_t pos;                                   /*!< Index of next pixel of reader in image */
+} gui_image_source_t;
+
+/* Sine values for 0 - 90 degrees, scaled by 16384 */
+static const int16_t
+sin_table[] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+/* Number of polygon points filled without memory allocation */
+#define POLY_STACK_POINTS   8
+
+/* Number of decoded image pixels passed to low-level driver at a time */
+#define IMAGE_LINE_PIXELS   64
+
+/* QOI format operation codes */
+#define QOI_OP_INDEX        0x00
+#define QOI_OP_DIFF         0x40
+#define QOI_OP_LUMA         0x80
+#define QOI_OP_RUN          0xC0
+#define QOI_OP_RGB          0xFE
+#define QOI_OP_RGBA         0xFF
+#define QOI_HEADER_SIZE     14
+
 #define CH_CR           GUI_KEY_CR
 #define CH_LF           GUI_KEY_LF
 #define CH_WS           GUI_KEY_WS
@@ -219,6 +292,7 @@ string_rectangle(gui_stringrect_t* rect, gui_string_t* str, uint8_t onlyToNextLi
                 } else {                            /* Try to get character size */
                     /* Try to fit character in current line */
                     gui_text_getcharsize(rect->Font, var.ch, &w, &h);   /* Get character dimensions */
+                    w += gui_text_getkerning(rect->Font, var.lastCh, var.ch);   /* Apply kerning for character pair */
                     if ((var.cW + w) < rect->StringDraw->width) {   /* Do we have enough memory available */
                         var.cW += w;                /* Increase total line width */
                         if (CH_WS == var.ch) {      /* Check if character is white space */
@@ -268,6 +342,8 @@ string_rectangle(gui_stringrect_t* rect, gui_string_t* str, uint8_t onlyToNextLi
         var.cW = 0;
         while (gui_string_getch(&var.s, &var.ch, &i)) { /* Get next character from string */
             gui_text_getcharsize(rect->Font, var.ch, &w, &h);   /* Get character width and height */
+            w += gui_text_getkerning(rect->Font, var.lastCh, var.ch);   /* Apply kerning for character pair */
+            var.lastCh = var.ch;
             if (!(rect->StringDraw->flags & GUI_FLAG_TEXT_RIGHTALIGN) && (var.cW + w) > rect->StringDraw->width) {  /* Check if end now */
                 break;
             }
@@ -284,15 +360,165 @@ string_rectangle(gui_stringrect_t* rect, gui_string_t* str, uint8_t onlyToNextLi
     return var.cnt;                                 /* Return number of characters to read in current line */
 }
 
+/**
+ * \brief           Copy block of character alpha values to drawing layer with low-level `CopyChar` function
+ * \param[in]       disp: Display clipping region
+ * \param[in]       draw: Text drawing parameters
+ * \param[in]       x: Top left X position of block on screen
+ * \param[in]       y: Top left Y position of block on screen
+ * \param[in]       ptr: Pointer to alpha values, one byte per pixel
+ * \param[in]       width: Block width and number of alpha values per line
+ * \param[in]       height: Block height
+ */
+static void
+copy_char_block(const gui_display_t* disp, const gui_draw_text_t* draw, gui_dim_t x, gui_dim_t y, const uint8_t* ptr, gui_dim_t width, gui_dim_t height) {
+    gui_dim_t offlineSrc, offlineDst, tmpx, stride = width, lines = height;
+    uint8_t* dst;
+    
+    tmpx = x;                                       /* Start X */
+    dst = (uint8_t *)(((uint8_t *)GUI.lcd.drawing_layer->start_address) + ((y - GUI.lcd.drawing_layer->y_pos) * GUI.lcd.drawing_layer->width + (x - GUI.lcd.drawing_layer->x_pos)) * GUI.lcd.pixel_size);
+    
+    if (y < disp->y1) {                             /* Start Y position if outside visible area */
+        ptr += (disp->y1 - y) * stride;             /* Set offset for number of lines */
+        dst += (disp->y1 - y) * GUI.lcd.drawing_layer->width * GUI.lcd.pixel_size;  /* Set offset for number of LCD lines */
+        height -= disp->y1 - y;                     /* Decrease effective height */
+    }
+    if ((y + lines) > disp->y2) {
+        height -= y + lines - disp->y2;             /* Decrease effective height */
+    }
+    if (x < disp->x1) {                             /* Set offset start address if required */
+        ptr += (disp->x1 - x);                      /* Set offset of start address in X direction */
+        dst += (disp->x1 - x) * GUI.lcd.pixel_size; /* Set offset of start address in X direction */
+        width -= disp->x1 - x;                      /* Increase source offline */
+        tmpx += disp->x1 - x;                       /* Increase effective start X position */
+    }
+    if ((x + stride) > disp->x2) {
+        width -= x + stride - disp->x2;             /* Decrease effective width */
+    }
+    if (width <= 0 || height <= 0) {                /* Nothing left to draw */
+        return;
+    }
+    
+    offlineSrc = stride - width;                    /* Set offline source */
+    offlineDst = GUI.lcd.drawing_layer->width - width;  /* Set offline destination */
+    
+    /* Check if character must be drawn with 2 colors, on the middle of color switch */
+    if (tmpx < (draw->x + draw->color1width) && (tmpx + width) > (draw->x + draw->color1width)) {
+        gui_dim_t firstWidth = (draw->x + draw->color1width) - tmpx;
+        
+        /* First part draw */
+        GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst, ptr, 
+            firstWidth, height,
+            offlineDst + width - firstWidth, offlineSrc + width - firstWidth, draw->color1);
+        
+        /* Second part draw */
+        GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst + firstWidth * GUI.lcd.pixel_size, ptr + firstWidth, 
+            width - firstWidth, height,
+            offlineDst + firstWidth, offlineSrc + firstWidth, draw->color2);
+    } else {
+        /* Draw entire character with single color */
+        GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst, ptr, 
+            width, height,
+            offlineDst, offlineSrc, (draw->x + draw->color1width) > x ? draw->color1 : draw->color2);
+    }
+}
+
+/**
+ * \brief           Blend foreground color over background color
+ * \param[in]       fg: Foreground color
+ * \param[in]       bg: Background color, its alpha channel is kept
+ * \param[in]       a: Foreground alpha between `0x00` and `0xFF`
+ * \return          Blended color
+ */
+static gui_color_t
+blend_color(gui_color_t fg, gui_color_t bg, uint8_t a) {
+    uint32_t rb, g, a1;
+    
+    a1 = (uint32_t)a + (a >> 7);                    /* Scale alpha to 0..256 for division with shift */
+    rb = (((fg & 0x00FF00FFUL) * a1 + (bg & 0x00FF00FFUL) * (256 - a1)) >> 8) & 0x00FF00FFUL;
+    g  = (((fg & 0x0000FF00UL) * a1 + (bg & 0x0000FF00UL) * (256 - a1)) >> 8) & 0x0000FF00UL;
+    return (bg & 0xFF000000UL) | rb | g;
+}
+
+/**
+ * \brief           Blend color over single pixel of drawing layer, without clipping
+ * \note            Layers with `4` bytes per pixel are accessed directly as ARGB8888 memory,
+ *                  others use low-level pixel functions
+ * \param[in]       layer: Drawing layer
+ * \param[in]       x: X position relative to layer
+ * \param[in]       y: Y position relative to layer
+ * \param[in]       color: Color used for drawing operation
+ * \param[in]       a: Pixel coverage between `0x01` and `0xFF`
+ */
+static void
+blend_layer_pixel(gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_color_t color, uint8_t a) {
+    if (GUI.lcd.pixel_size == 4) {                  /* Direct memory access */
+        uint32_t* dst = (uint32_t *)layer->start_address + y * layer->width + x;
+        *dst = a == 0xFF ? color : blend_color(color, *dst, a);
+    } else {
+        if (a != 0xFF) {
+            color = blend_color(color, GUI.ll.GetPixel(&GUI.lcd, layer, x, y), a);
+        }
+        GUI.ll.SetPixel(&GUI.lcd, layer, x, y, color);
+    }
+}
+
+/**
+ * \brief           Blend color over single pixel with coverage value
+ * \param[in]       disp: Display clipping region
+ * \param[in]       x: X position on screen
+ * \param[in]       y: Y position on screen
+ * \param[in]       color: Color used for drawing operation
+ * \param[in]       a: Pixel coverage between `0x00` and `0xFF`
+ */
+static void
+blend_pixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_color_t color, uint8_t a) {
+    gui_layer_t* layer = GUI.lcd.drawing_layer;
+
+    if (a == 0 || y < disp->y1 || y >= disp->y2 || x < disp->x1 || x >= disp->x2) {
+        return;
+    }
+    blend_layer_pixel(layer, x - layer->x_pos, y - layer->y_pos, color, a);
+}
+
+/**
+ * \brief           Blend single line of character alpha values to drawing layer
+ * \param[in]       disp: Display clipping region
+ * \param[in]       draw: Text drawing parameters
+ * \param[in]       x: Line start X position on screen
+ * \param[in]       y: Line Y position on screen
+ * \param[in]       line: Pointer to alpha values, one byte per pixel
+ * \param[in]       width: Number of alpha values in line
+ */
+static void
+blend_char_line(const gui_display_t* disp, const gui_draw_text_t* draw, gui_dim_t x, gui_dim_t y, const uint8_t* line, gui_dim_t width) {
+    gui_layer_t* layer = GUI.lcd.drawing_layer;
+    gui_dim_t i, start, end, split;
+    
+    start = x < disp->x1 ? disp->x1 - x : 0;        /* Clip line to visible area */
+    end = (x + width) > disp->x2 ? disp->x2 - x : width;
+    split = draw->x + draw->color1width - x;        /* First index drawn with second color */
+    
+    x -= layer->x_pos;                              /* Position relative to layer */
+    y -= layer->y_pos;
+    for (i = start; i < end; i++) {
+        if (line[i]) {
+            blend_layer_pixel(layer, x + i, y, i < split ? draw->color1 : draw->color2, line[i]);
+        }
+    }
+}
+
 /* Draw character to screen */
 /* X and Y coordinates are TOP LEFT coordinates for character */
 static void
 draw_char(const gui_display_t* disp, const gui_font_t* font, const gui_draw_text_t* draw, gui_dim_t x, gui_dim_t y, const gui_font_char_t* c) {
-    uint8_t i, b, k, columns;
-    gui_dim_t x1;
+    guii_text_glyphreader_t reader;
+    uint8_t line[0x100];
+    gui_dim_t i, k;
     
     while (!GUI.ll.IsReady(&GUI.lcd));              /* Wait till ready */
     
+    x += c->x_pos;                                  /* Set X position */
     y += c->y_pos;                                  /* Set Y position */
     
     if (!GUI_RECT_MATCH(
@@ -302,7 +528,8 @@ draw_char(const gui_display_t* disp, const gui_font_t* font, const gui_draw_text
         return;
     }
     
-    if (GUI.ll.CopyChar != NULL) {                  /* If copying character function exists in low-level part */
+    /* Use cache entry for not compressed fonts */
+    if (GUI.ll.CopyChar != NULL && !(font->flags & GUI_FLAG_FONT_RLE)) {
         gui_font_charentry_t* entry = NULL;
         
         entry = gui_text_getcharentry(font, c);     /* Get char entry from font and character for fast alpha drawing operations */
@@ -310,131 +537,24 @@ draw_char(const gui_display_t* disp, const gui_font_t* font, const gui_draw_text
             entry = gui_text_createcharentry(font, c);  /* Create new entry */
         }
         if (entry != NULL) {                        /* We have valid data */
-            gui_dim_t width, height, offlineSrc, offlineDst, tmpx;
-            uint8_t* dst = 0;
-            uint8_t* ptr = (uint8_t *)entry;        /* Get pointer */
-            
-            tmpx = x;                               /* Start X */
-            
-            ptr += sizeof(*entry);                  /* Go to start of data array */
-            dst = (uint8_t *)(((uint8_t *)GUI.lcd.drawing_layer->start_address) + ((y - GUI.lcd.drawing_layer->y_pos) * GUI.lcd.drawing_layer->width + (x - GUI.lcd.drawing_layer->x_pos)) * GUI.lcd.pixel_size);
-            
-            width = c->x_size;                      /* Get X size */
-            height = c->y_size;                     /* Get Y size */
-            
-            if (y < disp->y1) {                     /* Start Y position if outside visible area */
-                ptr += (disp->y1 - y) * c->x_size;  /* Set offset for number of lines */
-                dst += (disp->y1 - y) * GUI.lcd.drawing_layer->width * GUI.lcd.pixel_size;  /* Set offset for number of LCD lines */
-                height -= disp->y1 - y;             /* Decrease effective height */
-            }
-            if ((y + c->y_size) > disp->y2) {
-                height -= y + c->y_size - disp->y2; /* Decrease effective height */
-            }
-            if (x < disp->x1) {                     /* Set offset start address if required */
-                ptr += (disp->x1 - x);              /* Set offset of start address in X direction */
-                dst += (disp->x1 - x) * GUI.lcd.pixel_size; /* Set offset of start address in X direction */
-                width -= disp->x1 - x;              /* Increase source offline */
-                tmpx += disp->x1 - x;               /* Increase effective start X position */
-            }
-            if ((x + c->x_size) > disp->x2) {
-                width -= x + c->x_size - disp->x2;  /* Decrease effective width */
-            }
-            
-            offlineSrc = c->x_size - width;         /* Set offline source */
-            offlineDst = GUI.lcd.drawing_layer->width - width;   /* Set offline destination */
-            
-            /* Check if character must be drawn with 2 colors, on the middle of color switch */
-            if (tmpx < (draw->x + draw->color1width) && (tmpx + width) > (draw->x + draw->color1width)) {
-                gui_dim_t firstWidth = (draw->x + draw->color1width) - tmpx;
-                
-                /* First part draw */
-                GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst, ptr, 
-                    firstWidth, height,
-                    offlineDst + width - firstWidth, offlineSrc + width - firstWidth, draw->color1);
-                
-                /* Second part draw */
-                GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst + firstWidth * GUI.lcd.pixel_size, ptr + firstWidth, 
-                    width - firstWidth, height,
-                    offlineDst + firstWidth, offlineSrc + firstWidth, draw->color2);
-            } else {
-                /* Draw entire character with single color */
-                GUI.ll.CopyChar(&GUI.lcd, GUI.lcd.drawing_layer, dst, ptr, 
-                    width, height,
-                    offlineDst, offlineSrc, (draw->x + draw->color1width) > x ? draw->color1 : draw->color2);
-            }
+            copy_char_block(disp, draw, x, y, (uint8_t *)entry + GUI_MEM_ALIGN(sizeof(*entry)), c->x_size, c->y_size);
             return;
         }
     }
     
-    if (font->flags & GUI_FLAG_FONT_AA) {           /* Font has anti alliasing enabled */
-        gui_color_t color;                          /* Temporary color for AA */
-        uint8_t tmp, r1, g1, b1;
-        
-        columns = c->x_size / 4;                    /* Calculate number of bytes used for single character line */
-        if (c->x_size % 4) {                        /* If only 1 column used */
-            columns++;
+    /* Decode character line by line and draw each visible line */
+    guii_text_glyphreader_init(&reader, font, c);
+    for (k = 0; k < c->y_size && (y + k) < disp->y2; k++) {
+        for (i = 0; i < c->x_size; i++) {
+            line[i] = guii_text_glyphreader_get(&reader);
         }
-        
-        for (i = 0; i < columns * c->y_size; i++) { /* Go through all data bytes */
-            if (y >= disp->y1 && y <= disp->y2 && y < (draw->y + draw->height)) {   /* Do not draw when we are outside clipping are */            
-                b = c->data[i];                     /* Get character byte */
-                for (k = 0; k < 4; k++) {           /* Scan each bit in byte */
-                    gui_color_t baseColor;
-                    x1 = x + (i % columns) * 4 + k; /* Get new X value for pixel draw */
-                    if (x1 < disp->x1 || x1 > disp->x2) {
-                        continue;
-                    }
-                    if (x1 < (draw->x + draw->color1width)) {
-                        baseColor = draw->color1;
-                    } else {
-                        baseColor = draw->color2;
-                    }
-                    tmp = (b >> (6 - 2 * k)) & 0x03;/* Get temporary bits on bottom */
-                    if (tmp == 0x03) {              /* Draw solid color if both bits are enabled */
-                        gui_draw_setpixel(disp, x1, y, baseColor);
-                    } else if (tmp) {               /* Calculate new color */
-                        float t = (float)tmp / 3.0f;
-                        color = gui_draw_getpixel(disp, x1, y); /* Read current color */
-                        
-                        /* Calculate new values for pixel */
-                        r1 = GUI_U8((float)t * (float)((color >> 16) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >> 16) & 0xFF));
-                        g1 = GUI_U8((float)t * (float)((color >>  8) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  8) & 0xFF));
-                        b1 = GUI_U8((float)t * (float)((color >>  0) & 0xFF) + (float)(1.0f - (float)t) * (float)((baseColor >>  0) & 0xFF));
-                        
-                        /* Draw actual pixel to screen */
-                        gui_draw_setpixel(disp, x1, y, (color & 0xFF000000UL) | r1 << 16 | g1 << 8 | b1);
-                    }
-                }
-            }
-            if ((i % columns) == (columns - 1)) {   /* Check for next line */
-                y++;
-            }
+        if ((y + k) < disp->y1) {
+            continue;
         }
-    } else {
-        columns = c->x_size / 8;
-        if (c->x_size % 8) {
-            columns++;
-        }
-        for (i = 0; i < columns * c->y_size; i++) { /* Go through all data bytes */
-            if (y >= disp->y1 && y <= disp->y2 && y < (draw->y + draw->height)) {   /* Do not draw when we are outside clipping are */
-                b = c->data[i];                     /* Get character byte */
-                for (k = 0; k < 8; k++) {           /* Scan each bit in byte */
-                    if (b & (1 << (7 - k))) {       /* If bit is set, draw pixel */
-                        x1 = x + (i % columns) * 8 + k; /* Get new X value for pixel draw */
-                        if (x1 < disp->x1 || x1 > disp->x2) {
-                            continue;
-                        }
-                        if (x1 <= (draw->x + draw->color1width)) {
-                            gui_draw_setpixel(disp, x1, y, draw->color1);
-                        } else {
-                            gui_draw_setpixel(disp, x1, y, draw->color2);
-                        }
-                    }
-                }
-            }
-            if ((i % columns) == (columns - 1)) {   /* Check for next line */
-                y++;
-            }
+        if (GUI.ll.CopyChar != NULL) {
+            copy_char_block(disp, draw, x, y + k, line, c->x_size, 1);
+        } else if ((y + k) < (draw->y + draw->height)) {
+            blend_char_line(disp, draw, x, y + k, line, c->x_size);
         }
     }
 }
@@ -467,6 +587,9 @@ string_get_pointer_for_width(const gui_font_t* font, gui_string_t* str, gui_draw
 /* Fill screen with color on specific coordinates */
 static void
 gui_draw_fill(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_color_t color) {
+    if (disp->x2 <= disp->x1 || disp->y2 <= disp->y1) { /* Empty clipping region */
+        return;
+    }
     if (                                            /* Check if redraw is inside area */
         !GUI_RECT_MATCH(x, y, x + width, y + height,
             disp->x1, disp->y1, disp->x2, disp->y2)) {
@@ -558,7 +681,10 @@ gui_draw_getpixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y) {
  */
 void
 gui_draw_vline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
-    if (x >= disp->x2 || x < disp->x1 || y > disp->y2 || (y + length) < disp->y1) {
+    if (disp->x2 <= disp->x1 || disp->y2 <= disp->y1) { /* Empty clipping region */
+        return;
+    }
+    if (length <= 0 || x >= disp->x2 || x < disp->x1 || y >= disp->y2 || (y + length) <= disp->y1) {
         return;
     }
     if (y < disp->y1) {
@@ -582,7 +708,10 @@ gui_draw_vline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t le
  */
 void
 gui_draw_hline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
-    if (y >= disp->y2 || y < disp->y1 || x > disp->x2 || (x + length) < disp->x1) {
+    if (disp->x2 <= disp->x1 || disp->y2 <= disp->y1) { /* Empty clipping region */
+        return;
+    }
+    if (length <= 0 || y >= disp->y2 || y < disp->y1 || x >= disp->x2 || (x + length) <= disp->x1) {
         return;
     }
     if (x < disp->x1) {
@@ -684,6 +813,98 @@ gui_draw_line(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x
     }
 }
 
+/**
+ * \brief           Blend line pixel given in major and minor axis coordinates
+ * \param[in]       disp: Display clipping region
+ * \param[in]       u: Position on major axis
+ * \param[in]       v: Position on minor axis
+ * \param[in]       steep: Set to `1` when Y is major axis
+ * \param[in]       color: Color used for drawing operation
+ * \param[in]       a: Pixel coverage between `0x00` and `0xFF`
+ */
+static void
+blend_line_pixel(const gui_display_t* disp, gui_dim_t u, gui_dim_t v, uint8_t steep, gui_color_t color, uint8_t a) {
+    if (steep) {
+        blend_pixel(disp, v, u, color, a);
+    } else {
+        blend_pixel(disp, u, v, color, a);
+    }
+}
+
+/**
+ * \brief           Draw anti-aliased line from point 1 to point 2
+ * \note            Line is drawn with Wu's algorithm, each step on major axis
+ *                  blends 2 pixels with 16-bit fixed point error accumulator.
+ *                  Horizontal, vertical and diagonal lines are drawn with \ref gui_draw_line
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x1: Line start X position
+ * \param[in]       y1: Line start Y position
+ * \param[in]       x2: Line end X position
+ * \param[in]       y2: Line end Y position
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_line
+ */
+void
+gui_draw_line_aa(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_color_t color) {
+    gui_dim_t u1, v1, u2, v2, du, dv, u, end, step, t;
+    uint32_t acc = 0, adj;
+    uint8_t steep, a;
+
+    du = GUI_ABS(x2 - x1);
+    dv = GUI_ABS(y2 - y1);
+    if (du == 0 || dv == 0 || du == dv) {           /* Nothing to blend on straight lines */
+        gui_draw_line(disp, x1, y1, x2, y2, color);
+        return;
+    }
+    if (!GUI_RECT_MATCH(
+        GUI_MIN(x1, x2) - 1, GUI_MIN(y1, y2) - 1, GUI_MAX(x1, x2) + 1, GUI_MAX(y1, y2) + 1,
+        disp->x1, disp->y1, disp->x2, disp->y2
+    )) {
+        return;
+    }
+
+    /* Walk over major axis from lower to higher position */
+    steep = dv > du;
+    if (steep) {
+        u1 = y1, v1 = x1, u2 = y2, v2 = x2;
+        u = disp->y1, end = disp->y2;
+        du = dv;
+    } else {
+        u1 = x1, v1 = y1, u2 = x2, v2 = y2;
+        u = disp->x1, end = disp->x2;
+    }
+    if (u1 > u2) {
+        t = u1, u1 = u2, u2 = t;
+        t = v1, v1 = v2, v2 = t;
+    }
+    dv = GUI_ABS(v2 - v1);
+    step = v2 > v1 ? 1 : -1;
+    adj = ((uint32_t)dv << 16) / (uint32_t)du;      /* Minor axis move per step, fraction of pixel */
+
+    blend_line_pixel(disp, u1, v1, steep, color, 0xFF);
+    blend_line_pixel(disp, u2, v2, steep, color, 0xFF);
+
+    /* Skip steps before visible area, limit to its end */
+    if (u > u1 + 1) {
+        acc = adj * (uint32_t)(u - u1 - 1);
+        v1 += step * (gui_dim_t)(acc >> 16);
+        acc &= 0xFFFFUL;
+    } else {
+        u = u1 + 1;
+    }
+    end = GUI_MIN(end, u2);
+    for (; u < end; u++) {
+        acc += adj;
+        if (acc > 0xFFFFUL) {                       /* Move to next pixel on minor axis */
+            acc -= 0x10000UL;
+            v1 += step;
+        }
+        a = (uint8_t)(acc >> 8);                    /* Coverage of second pixel */
+        blend_line_pixel(disp, u, v1, steep, color, a ^ 0xFF);
+        blend_line_pixel(disp, u, v1 + step, steep, color, a);
+    }
+}
+
 /**
  * \brief           Draw rectangle extended function
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
@@ -763,196 +984,832 @@ gui_draw_rectangle3d(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_di
 }
 
 /**
- * \brief           Draw rectangle with rounded corners
+ * \brief           Get number of circle pixels on each side of center on single line
+ * \note            Circle center is top-left corner of pixel at center position
+ *                  and pixel is part of circle when its center is inside circle
+ * \param[in]       r: Circle radius
+ * \param[in]       j: Line index from center, `0` for first line above or below center
+ * \param[in]       w: Result for previous line or `r` for first line
+ * \return          Half width of line
+ */
+static gui_dim_t
+circle_halfwidth(gui_dim_t r, gui_dim_t j, gui_dim_t w) {
+    uint32_t rr = 4UL * (uint32_t)r * (uint32_t)r, yy = (uint32_t)(2 * j + 1) * (uint32_t)(2 * j + 1);
+
+    if (j >= r) {
+        return 0;
+    }
+    while (w > 0 && (uint32_t)(2 * w - 1) * (uint32_t)(2 * w - 1) + yy > rr) {
+        w--;
+    }
+    return w;
+}
+
+/**
+ * \brief           Draw vertical outline part of all 4 rounded corners
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
  * \param[in]       x: Top left X position
  * \param[in]       y: Top left Y position
  * \param[in]       width: Rectangle width
  * \param[in]       height: Rectangle height
- * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       r: Corner radius
+ * \param[in]       w: Half width of corner lines in vertical part
+ * \param[in]       j0: First line index from corner center
+ * \param[in]       j1: Line index after last line
  * \param[in]       color: Color used for drawing operation
- * \sa              gui_draw_rectangle, gui_draw_filledrectangle, gui_draw_filledroundedrectangle
  */
-void
-gui_draw_roundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
-    if (r >= (height / 2)) {
-        r = height / 2 - 1;
+static void
+draw_rounded_vpart(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height,
+                    gui_dim_t r, gui_dim_t w, gui_dim_t j0, gui_dim_t j1, gui_color_t color) {
+    if (j1 > j0) {
+        gui_draw_vline(disp, x + r - w, y + r - j1, j1 - j0, color);
+        gui_draw_vline(disp, x + width - r + w - 1, y + r - j1, j1 - j0, color);
+        gui_draw_vline(disp, x + r - w, y + height - r + j0, j1 - j0, color);
+        gui_draw_vline(disp, x + width - r + w - 1, y + height - r + j0, j1 - j0, color);
     }
-    if (r >= (width / 2)) {
-        r = width / 2 - 1;
+}
+
+/**
+ * \brief           Draw rectangle with rounded corners, one span per line on each side
+ * \note            Corners are quarters of circle with radius `r`, circle and
+ *                  filled circle are rounded rectangles with size of `2 * r`.
+ *                  Outline contains pixels with at least one neighbour outside the shape,
+ *                  its vertical parts are drawn with vertical lines
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, limited to half of shorter side
+ * \param[in]       filled: Set to `1` to fill shape or `0` to draw outline only
+ * \param[in]       color: Color used for drawing operation
+ */
+static void
+draw_rounded(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, uint8_t filled, gui_color_t color) {
+    gui_dim_t j, j0 = 0, w, wn, a, x1, len, yt, yb;
+
+    if (width <= 0 || height <= 0 || !GUI_RECT_MATCH(
+        x, y, x + width, y + height,
+        disp->x1, disp->y1, disp->x2, disp->y2
+    )) {
+        return;
     }
-    if (r) {
-        gui_draw_hline(disp, x + r,         y,              width - 2 * r,  color);
-        gui_draw_vline(disp, x + width - 1, y + r,          height - 2 * r, color);
-        gui_draw_hline(disp, x + r,         y + height - 1, width - 2 * r,  color);
-        gui_draw_vline(disp, x,             y + r,          height - 2 * r, color);
-        
-        gui_draw_circlecorner(disp, x + r,             y + r,              r, GUI_DRAW_CIRCLE_TL, color);
-        gui_draw_circlecorner(disp, x + width - r - 1, y + r,              r, GUI_DRAW_CIRCLE_TR, color);
-        gui_draw_circlecorner(disp, x + r,             y + height - r - 1, r, GUI_DRAW_CIRCLE_BL, color);
-        gui_draw_circlecorner(disp, x + width - r - 1, y + height - r - 1, r, GUI_DRAW_CIRCLE_BR, color);
-    } else {
+    r = GUI_MIN(r, GUI_MIN(width, height) / 2);
+    if (r <= 0 && !filled) {
         gui_draw_rectangle(disp, x, y, width, height, color);
+        return;
+    }
+
+    /* Straight part between corners */
+    if (filled) {
+        gui_draw_fill(disp, x, y + r, width, height - 2 * r, color);
+    } else if (height > 2 * r) {
+        gui_draw_vline(disp, x, y + r, height - 2 * r, color);
+        gui_draw_vline(disp, x + width - 1, y + r, height - 2 * r, color);
+    }
+
+    /* Corner lines, from center to top and bottom edge */
+    w = circle_halfwidth(r, 0, r);
+    for (j = 0; j < r; j++) {
+        wn = circle_halfwidth(r, j + 1, w);
+        yt = y + r - 1 - j;
+        yb = y + height - r + j;
+        x1 = x + r - w;
+        len = width - 2 * r + 2 * w;
+        a = GUI_MIN(wn, w - 1);                     /* Pixels with neighbour outside shape start here */
+        if (filled || wn == 0 || width - 2 * r + 2 * a <= 0) {
+            gui_draw_hline(disp, x1, yt, len, color);
+            gui_draw_hline(disp, x1, yb, len, color);
+        } else if (w - a == 1) {                    /* Single pixel, continue vertical part */
+            if (wn != w) {
+                draw_rounded_vpart(disp, x, y, width, height, r, w, j0, j + 1, color);
+                j0 = j + 1;
+            }
+            w = wn;
+            continue;
+        } else {
+            gui_draw_hline(disp, x1, yt, w - a, color);
+            gui_draw_hline(disp, x1 + len - (w - a), yt, w - a, color);
+            gui_draw_hline(disp, x1, yb, w - a, color);
+            gui_draw_hline(disp, x1 + len - (w - a), yb, w - a, color);
+        }
+        j0 = j + 1;
+        w = wn;
     }
 }
 
 /**
- * \brief           Draw filled rectangle with rounded corners
+ * \brief           Get distance from circle center to its edge on single line
+ * \note            Circle center is top-left corner of pixel at center position,
+ *                  distance is measured at center of line
+ * \param[in]       r: Circle radius
+ * \param[in]       j: Line index from center, `0` for first line above or below center
+ * \return          Distance in units of `1/256` pixel
+ */
+static uint32_t
+circle_edge(gui_dim_t r, gui_dim_t j) {
+    uint32_t n, s = 0, b = 1UL << 30;
+
+    if (j >= r) {
+        return 0;
+    }
+    n = 4UL * (uint32_t)r * (uint32_t)r - (uint32_t)(2 * j + 1) * (uint32_t)(2 * j + 1);
+
+    /* Integer square root, n is left with remainder */
+    while (b > n) {
+        b >>= 2;
+    }
+    for (; b > 0; b >>= 2) {
+        if (n >= s + b) {
+            n -= s + b;
+            s = (s >> 1) + b;
+        } else {
+            s >>= 1;
+        }
+    }
+    return (s << 7) + (n << 7) / (2 * s + 1);       /* Half of root with interpolated fraction */
+}
+
+/**
+ * \brief           Blend pixel in all 4 corners of rounded rectangle
+ * \param[in]       disp: Display clipping region
+ * \param[in]       xl: X position of left corners center
+ * \param[in]       xr: X position of right corners center
+ * \param[in]       yt: Y position of top corners center
+ * \param[in]       yb: Y position of bottom corners center
+ * \param[in]       dx: Horizontal pixel index from corner center
+ * \param[in]       dy: Vertical pixel index from corner center
+ * \param[in]       color: Color used for drawing operation
+ * \param[in]       a: Pixel coverage between `0x00` and `0xFF`
+ */
+static void
+blend_corners(const gui_display_t* disp, gui_dim_t xl, gui_dim_t xr, gui_dim_t yt, gui_dim_t yb,
+                gui_dim_t dx, gui_dim_t dy, gui_color_t color, uint8_t a) {
+    blend_pixel(disp, xr + dx, yb + dy, color, a);
+    blend_pixel(disp, xl - 1 - dx, yb + dy, color, a);
+    blend_pixel(disp, xr + dx, yt - 1 - dy, color, a);
+    blend_pixel(disp, xl - 1 - dx, yt - 1 - dy, color, a);
+}
+
+/**
+ * \brief           Draw anti-aliased rectangle with rounded corners
+ * \note            Corner geometry is the same as with \ref draw_rounded function.
+ *                  Each corner octant is scanned once and coverage of edge pixels is
+ *                  computed on columns in flat part and on lines in steep part of curve.
+ *                  Only edge pixels are blended, inside of filled shape is drawn with spans
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
  * \param[in]       x: Top left X position
  * \param[in]       y: Top left Y position
  * \param[in]       width: Rectangle width
  * \param[in]       height: Rectangle height
- * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       r: Corner radius, limited to half of shorter side
+ * \param[in]       filled: Set to `1` to fill shape or `0` to draw `1` pixel wide outline
  * \param[in]       color: Color used for drawing operation
- * \sa              gui_draw_rectangle, gui_draw_filledrectangle, gui_draw_roundedrectangle
  */
-void
-gui_draw_filledroundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
-    if (r >= (height / 2)) {
-        r = height / 2 - 1;
+static void
+draw_rounded_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, uint8_t filled, gui_color_t color) {
+    gui_dim_t i, k, e, en, lo, xl, xr, yt, yb;
+    uint32_t vo, vi, c;
+
+    if (width <= 0 || height <= 0 || !GUI_RECT_MATCH(
+        x, y, x + width, y + height,
+        disp->x1, disp->y1, disp->x2, disp->y2
+    )) {
+        return;
+    }
+    r = GUI_MIN(r, GUI_MIN(width, height) / 2);
+    if (r <= 0) {
+        if (filled) {
+            gui_draw_fill(disp, x, y, width, height, color);
+        } else {
+            gui_draw_rectangle(disp, x, y, width, height, color);
+        }
+        return;
     }
-    if (r >= (width / 2)) {
-        r = width / 2 - 1;
+    xl = x + r;                                     /* Corner centers */
+    xr = x + width - r;
+    yt = y + r;
+    yb = y + height - r;
+
+    /* Straight part between corners */
+    if (filled) {
+        gui_draw_fill(disp, x, yt, width, yb - yt, color);
+    } else {
+        gui_draw_hline(disp, xl, y, xr - xl, color);
+        gui_draw_hline(disp, xl, y + height - 1, xr - xl, color);
+        gui_draw_vline(disp, x, yt, yb - yt, color);
+        gui_draw_vline(disp, x + width - 1, yt, yb - yt, color);
     }
-    if (r) {
-        if ((gui_dim_t)(width - 2 * r) > 0) {
-            gui_draw_filledrectangle(disp, x + r,         y,     width - 2 * r, height,         color);
+
+    /*
+     * Index i is column in flat octant and line in steep octant.
+     * Pixels at distance k >= i from center are part of column,
+     * pixels with k > i are part of line, so each pixel is visited once
+     */
+    vo = circle_edge(r, 0);
+    for (i = 0; (e = (gui_dim_t)(vo >> 8)) >= i; i++) {
+        vi = filled ? (vo & ~0xFFUL) : circle_edge(r - 1, i);
+        for (k = GUI_MAX((gui_dim_t)(vi >> 8), i); k <= e; k++) {
+            c = GUI_MIN(vo, (uint32_t)(k + 1) << 8) - GUI_MAX(vi, (uint32_t)k << 8);
+            c = GUI_MIN(c, 0xFF);
+            blend_corners(disp, xl, xr, yt, yb, i, k, color, (uint8_t)c);
+            if (k > i) {
+                blend_corners(disp, xl, xr, yt, yb, k, i, color, (uint8_t)c);
+            }
         }
-        if ((gui_dim_t)(height - 2 * r) > 0) {
-            gui_draw_filledrectangle(disp, x,             y + r, r,             height - 2 * r, color);
-            gui_draw_filledrectangle(disp, x + width - r, y + r, r,             height - 2 * r, color);
+        vo = circle_edge(r, i + 1);
+        if (filled && e > i) {
+            /* Line i is in steep part, filled up to edge pixel */
+            gui_draw_hline(disp, xl - e, yt - 1 - i, xr - xl + 2 * e, color);
+            gui_draw_hline(disp, xl - e, yb + i, xr - xl + 2 * e, color);
+
+            /* Lines in flat part where column i is last inside pixel */
+            en = (gui_dim_t)(vo >> 8);
+            lo = GUI_MAX(en, i + 1);
+            gui_draw_fill(disp, xl - i - 1, yt - e, xr - xl + 2 * (i + 1), e - lo, color);
+            gui_draw_fill(disp, xl - i - 1, yb + lo, xr - xl + 2 * (i + 1), e - lo, color);
         }
-        
-        gui_draw_filledcirclecorner(disp, x + r,             y + r,              r, GUI_DRAW_CIRCLE_TL, color);
-        gui_draw_filledcirclecorner(disp, x + width - r - 1, y + r,              r, GUI_DRAW_CIRCLE_TR, color);
-        gui_draw_filledcirclecorner(disp, x + r,             y + height - r - 1, r, GUI_DRAW_CIRCLE_BL, color);
-        gui_draw_filledcirclecorner(disp, x + width - r - 1, y + height - r - 1, r, GUI_DRAW_CIRCLE_BR, color);
-    } else {
-        gui_draw_filledrectangle(disp, x, y, width, height, color);
     }
 }
 
 /**
- * \brief           Draw circle
- * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
- * \param[in]       x: X position of circle center
- * \param[in]       y: X position of circle center
- * \param[in]       r: Circle radius
- * \param[in]       color: Color used for drawing operation 
- * \sa              gui_draw_filledcircle, gui_draw_circlecorner, gui_draw_filledcirclecorner
+ * \brief           Get sine of angle
+ * \param[in]       a: Angle in units of degrees
+ * \return          Sine value, scaled by `16384`
  */
-void
-gui_draw_circle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
-    gui_draw_circlecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TL, color);
-    gui_draw_circlecorner(disp, x - 1, y, r, GUI_DRAW_CIRCLE_TR, color);
-    gui_draw_circlecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BL, color);
-    gui_draw_circlecorner(disp, x - 1, y - 1, r, GUI_DRAW_CIRCLE_BR, color);
+static int32_t
+sin_deg(int32_t a) {
+    a %= 360;
+    if (a < 0) {
+        a += 360;
+    }
+    if (a <= 90) {
+        return sin_table[a];
+    } else if (a <= 180) {
+        return sin_table[180 - a];
+    } else if (a <= 270) {
+        return -sin_table[a - 180];
+    }
+    return -sin_table[360 - a];
 }
 
 /**
- * \brief           Draw filled circle
- * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
- * \param[in]       x: X position of circle center
- * \param[in]       y: X position of circle center
- * \param[in]       r: Circle radius
- * \param[in]       color: Color used for drawing operation 
- * \sa              gui_draw_circle, gui_draw_circlecorner, gui_draw_filledcirclecorner
+ * \brief           Division with result rounded towards negative infinity
+ * \param[in]       a: Dividend
+ * \param[in]       b: Divisor, must be greater than `0`
+ * \return          Result of division
  */
-void
-gui_draw_filledcircle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
-    gui_draw_filledcirclecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TL, color);
-    gui_draw_filledcirclecorner(disp, x, y, r, GUI_DRAW_CIRCLE_TR, color);
-    gui_draw_filledcirclecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BL, color);
-    gui_draw_filledcirclecorner(disp, x, y - 1, r, GUI_DRAW_CIRCLE_BR, color);
+static int32_t
+floor_div(int32_t a, int32_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
 }
 
 /**
- * \brief           Draw triangle
- * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
- * \param[in]       x1: Triangle point 1 X position
- * \param[in]       y1: Triangle point 1 Y position
- * \param[in]       x2: Triangle point 2 X position
- * \param[in]       y2: Triangle point 2 Y position
- * \param[in]       x3: Triangle point 3 X position
- * \param[in]       y3: Triangle point 3 Y position
- * \param[in]       color: Color used for drawing operation 
- * \sa              gui_draw_filledtriangle
+ * \brief           Get range of pixels on line where `a * (2 * i + 1) <= b`,
+ *                  `i` is pixel offset from center and `2 * i + 1` pixel center in units of half pixels
+ * \param[in]       a: Line equation factor
+ * \param[in]       b: Line equation constant
+ * \param[out]      lo: First pixel offset in range
+ * \param[out]      hi: Last pixel offset in range
  */
-void
-gui_draw_triangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1,  gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color) {
-    gui_draw_line(disp, x1, y1, x2, y2, color);
-    gui_draw_line(disp, x1, y1, x3, y3, color);
-    gui_draw_line(disp, x2, y2, x3, y3, color);
+static void
+halfplane_range(int32_t a, int32_t b, int32_t* lo, int32_t* hi) {
+    *lo = GUI_DIM_MIN;
+    *hi = GUI_DIM_MAX;
+    if (a > 0) {
+        *hi = floor_div(floor_div(b, a) - 1, 2);
+    } else if (a < 0) {
+        b = -floor_div(b, -a);                      /* Smallest pixel center in units of half pixels */
+        *lo = -floor_div(1 - b, 2);
+    } else if (b < 0) {
+        *lo = GUI_DIM_MAX;                          /* Empty range */
+        *hi = GUI_DIM_MIN;
+    }
 }
 
 /**
- * \brief           Draw filled triangle
+ * \brief           Draw arc, pie or ring
+ * \note            Angles are in units of degrees, `0` is on the right side of center and angle grows clockwise.
+ *                  Area from start angle to end angle is drawn, end angle is not included
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
- * \param[in]       x1: Triangle point 1 X position
- * \param[in]       y1: Triangle point 1 Y position
- * \param[in]       x2: Triangle point 2 X position
- * \param[in]       y2: Triangle point 2 Y position
- * \param[in]       x3: Triangle point 3 X position
- * \param[in]       y3: Triangle point 3 Y position
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Outer radius
+ * \param[in]       ri: Inner radius, set to `0` for pie
+ * \param[in]       start: Start angle
+ * \param[in]       end: End angle
+ * \param[in]       color: Color used for drawing operation
+ */
+static void
+draw_arc(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_dim_t ri, int32_t start, int32_t end, gui_color_t color) {
+    int32_t cs, ss, ce, se, sweep, y2, sl[2], sh[2], al[2], ah[2], l1, h1, l2, h2, lo, hi;
+    gui_dim_t j, w, wn, wi, e, yl;
+    size_t scnt, acnt, k, m, side;
+
+    if (r <= 0 || !GUI_RECT_MATCH(
+        x - r, y - r, x + r, y + r,
+        disp->x1, disp->y1, disp->x2, disp->y2
+    )) {
+        return;
+    }
+    ri = GUI_MAX(ri, 0);
+    sweep = end - start;
+    if (sweep <= 0 && sweep > -360) {               /* End before start wraps around full circle */
+        sweep += 360;
+    }
+    if (sweep <= 0 || start == end) {
+        return;
+    }
+    cs = sin_deg(start + 90);
+    ss = sin_deg(start);
+    ce = sin_deg(end + 90);
+    se = sin_deg(end);
+
+    w = circle_halfwidth(r, 0, r);
+    wi = ri;
+    for (j = 0; j < r; j++) {
+        wn = circle_halfwidth(r, j + 1, w);
+        wi = circle_halfwidth(ri, j, wi);
+        e = GUI_MIN(wi, GUI_MIN(wn, w - 1));        /* Keep thin rings connected */
+        if (ri == 0) {
+            e = 0;
+        }
+
+        /* Ring ranges on line */
+        acnt = 0;
+        if (e == 0) {
+            al[acnt] = -w;
+            ah[acnt++] = w - 1;
+        } else {
+            al[acnt] = -w;
+            ah[acnt++] = -e - 1;
+            al[acnt] = e;
+            ah[acnt++] = w - 1;
+        }
+
+        for (side = 0; side < 2; side++) {
+            yl = side ? y + j : y - 1 - j;
+            if (yl < disp->y1 || yl >= disp->y2) {
+                continue;
+            }
+            y2 = side ? 2 * j + 1 : -(2 * j + 1);
+
+            /* Angle ranges on line, from half planes of start and end angle */
+            scnt = 0;
+            if (sweep >= 360) {
+                sl[scnt] = GUI_DIM_MIN;
+                sh[scnt++] = GUI_DIM_MAX;
+            } else {
+                halfplane_range(ss, cs * y2, &l1, &h1);         /* Clockwise from start */
+                halfplane_range(-se, -ce * y2 - 1, &l2, &h2);   /* Counter-clockwise from end */
+                if (sweep <= 180) {
+                    lo = GUI_MAX(l1, l2);
+                    hi = GUI_MIN(h1, h2);
+                    if (lo <= hi) {
+                        sl[scnt] = lo;
+                        sh[scnt++] = hi;
+                    }
+                } else {                            /* Union of ranges, sorted and merged */
+                    if (l1 <= h1) {
+                        sl[scnt] = l1;
+                        sh[scnt++] = h1;
+                    }
+                    if (l2 <= h2) {
+                        sl[scnt] = l2;
+                        sh[scnt++] = h2;
+                    }
+                    if (scnt == 2 && sl[1] < sl[0]) {
+                        lo = sl[0];
+                        hi = sh[0];
+                        sl[0] = sl[1];
+                        sh[0] = sh[1];
+                        sl[1] = lo;
+                        sh[1] = hi;
+                    }
+                    if (scnt == 2 && sl[1] <= sh[0] + 1) {
+                        sh[0] = GUI_MAX(sh[0], sh[1]);
+                        scnt = 1;
+                    }
+                }
+            }
+
+            /* Draw intersections of angle and ring ranges */
+            for (k = 0; k < scnt; k++) {
+                for (m = 0; m < acnt; m++) {
+                    lo = GUI_MAX(sl[k], al[m]);
+                    hi = GUI_MIN(sh[k], ah[m]);
+                    if (lo <= hi) {
+                        gui_draw_hline(disp, (gui_dim_t)(x + lo), yl, (gui_dim_t)(hi - lo + 1), color);
+                    }
+                }
+            }
+        }
+        w = wn;
+    }
+}
+
+/**
+ * \brief           Draw rectangle with rounded corners
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_rectangle, gui_draw_filledrectangle, gui_draw_filledroundedrectangle
+ */
+void
+gui_draw_roundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
+    draw_rounded(disp, x, y, width, height, r, 0, color);
+}
+
+/**
+ * \brief           Draw filled rectangle with rounded corners
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_rectangle, gui_draw_filledrectangle, gui_draw_roundedrectangle
+ */
+void
+gui_draw_filledroundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
+    draw_rounded(disp, x, y, width, height, r, 1, color);
+}
+
+/**
+ * \brief           Draw circle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: X position of circle center
+ * \param[in]       r: Circle radius
  * \param[in]       color: Color used for drawing operation 
- * \sa              gui_draw_triangle
+ * \sa              gui_draw_filledcircle, gui_draw_circlecorner, gui_draw_filledcirclecorner
  */
 void
-gui_draw_filledtriangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color) {
-    gui_dim_t deltax = 0, deltay = 0, x = 0, y = 0, xinc1 = 0, xinc2 = 0, 
-    yinc1 = 0, yinc2 = 0, den = 0, num = 0, numadd = 0, numpixels = 0, 
-    curpixel = 0;
+gui_draw_circle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
+    if (r > 0) {
+        draw_rounded(disp, x - r, y - r, 2 * r, 2 * r, r, 0, color);
+    }
+}
 
-    deltax = GUI_ABS(x2 - x1);
-    deltay = GUI_ABS(y2 - y1);
-    x = x1;
-    y = y1;
+/**
+ * \brief           Draw filled circle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: X position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       color: Color used for drawing operation 
+ * \sa              gui_draw_circle, gui_draw_circlecorner, gui_draw_filledcirclecorner
+ */
+void
+gui_draw_filledcircle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
+    if (r > 0) {
+        draw_rounded(disp, x - r, y - r, 2 * r, 2 * r, r, 1, color);
+    }
+}
 
-    if (x2 >= x1) {
-        xinc1 = 1;
-        xinc2 = 1;
-    } else {
-        xinc1 = -1;
-        xinc2 = -1;
+/**
+ * \brief           Draw arc with line width
+ * \note            Angles are in units of degrees, `0` is on the right side of center and angle grows clockwise.
+ *                  Arc is drawn from start to end angle, end angle is not included so that arcs
+ *                  with common angle do not overlap. Arc with `360` degrees or more is full ring
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Outer radius
+ * \param[in]       width: Arc line width in units of pixels
+ * \param[in]       start: Start angle
+ * \param[in]       end: End angle. When smaller than start angle, arc goes over `0` degrees
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_pie, gui_draw_ring
+ */
+void
+gui_draw_arc(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_dim_t width, int16_t start, int16_t end, gui_color_t color) {
+    if (width > 0) {
+        draw_arc(disp, x, y, r, r - width, start, end, color);
     }
+}
 
-    if (y2 >= y1) {
-        yinc1 = 1;
-        yinc2 = 1;
-    } else {
-        yinc1 = -1;
-        yinc2 = -1;
+/**
+ * \brief           Draw filled circle sector
+ * \note            Angles are in units of degrees, same as for \ref gui_draw_arc function
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       start: Start angle
+ * \param[in]       end: End angle. When smaller than start angle, sector goes over `0` degrees
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_arc, gui_draw_filledcircle
+ */
+void
+gui_draw_pie(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, int16_t start, int16_t end, gui_color_t color) {
+    draw_arc(disp, x, y, r, 0, start, end, color);
+}
+
+/**
+ * \brief           Draw ring, circle with line width
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Outer radius
+ * \param[in]       width: Ring line width in units of pixels
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_arc, gui_draw_circle
+ */
+void
+gui_draw_ring(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_dim_t width, gui_color_t color) {
+    if (width > 0) {
+        draw_arc(disp, x, y, r, r - width, 0, 360, color);
     }
+}
 
-    if (deltax >= deltay){
-        xinc1 = 0;
-        yinc2 = 0;
-        den = deltax;
-        num = deltax / 2;
-        numadd = deltay;
-        numpixels = deltax;
-    } else {
-        xinc2 = 0;
-        yinc1 = 0;
-        den = deltay;
-        num = deltay / 2;
-        numadd = deltax;
-        numpixels = deltay;
+/**
+ * \brief           Draw anti-aliased rectangle with rounded corners
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_roundedrectangle, gui_draw_filledroundedrectangle_aa
+ */
+void
+gui_draw_roundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
+    draw_rounded_aa(disp, x, y, width, height, r, 0, color);
+}
+
+/**
+ * \brief           Draw anti-aliased filled rectangle with rounded corners
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       width: Rectangle width
+ * \param[in]       height: Rectangle height
+ * \param[in]       r: Corner radius, max value can be r = MIN(width, height) / 2
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_filledroundedrectangle, gui_draw_roundedrectangle_aa
+ */
+void
+gui_draw_filledroundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color) {
+    draw_rounded_aa(disp, x, y, width, height, r, 1, color);
+}
+
+/**
+ * \brief           Draw anti-aliased circle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_circle, gui_draw_filledcircle_aa
+ */
+void
+gui_draw_circle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
+    if (r > 0) {
+        draw_rounded_aa(disp, x - r, y - r, 2 * r, 2 * r, r, 0, color);
     }
+}
 
-    for (curpixel = 0; curpixel <= numpixels; curpixel++) {
-        gui_draw_line(disp, x, y, x3, y3, color);
+/**
+ * \brief           Draw anti-aliased filled circle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: X position of circle center
+ * \param[in]       y: Y position of circle center
+ * \param[in]       r: Circle radius
+ * \param[in]       color: Color used for drawing operation
+ * \sa              gui_draw_filledcircle, gui_draw_circle_aa
+ */
+void
+gui_draw_filledcircle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color) {
+    if (r > 0) {
+        draw_rounded_aa(disp, x - r, y - r, 2 * r, 2 * r, r, 1, color);
+    }
+}
 
-        num += numadd;
-        if (num >= den) {
-            num -= den;
-            x += xinc1;
-            y += yinc1;
+/**
+ * \brief           Move polygon edge to next scanline
+ * \param[in,out]   e: Edge to move
+ */
+static void
+poly_edge_step(gui_poly_edge_t* e) {
+    e->x += e->q;
+    e->err += e->r;
+    if (e->err >= e->d) {
+        e->err -= e->d;
+        e->x++;
+    }
+}
+
+/**
+ * \brief           Fill polygon with edge table scanline algorithm
+ * \note            Line is filled between pairs of edge crossings using even-odd rule,
+ *                  crossings are rounded to nearest pixel. Horizontal edges are added as spans.
+ *                  Each span is drawn with single horizontal line, spans never overlap
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       points: Polygon points, last point is connected to first one
+ * \param[in]       len: Number of points
+ * \param[in]       edges: Memory for `len` edges
+ * \param[in]       buff: Memory for `3 * len` values for crossings and spans
+ * \param[in]       color: Color used for drawing operation
+ */
+static void
+fill_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_poly_edge_t* edges, gui_dim_t* buff, gui_color_t color) {
+    gui_dim_t *xs = buff, *sx1 = buff + len, *sx2 = buff + 2 * len;
+    gui_dim_t y, ymin = GUI_DIM_MAX, ymax = GUI_DIM_MIN, t1, t2;
+    size_t i, k, prev, first = 0, count = 0, xcnt, scnt;
+    const gui_draw_poly_t *a, *b;
+    gui_poly_edge_t* e, tmp;
+    int32_t dx, dy;
+
+    if (len < 2 || color == GUI_COLOR_TRANS) {
+        return;
+    }
+
+    /* Build edge table, edge i connects point i with next point */
+    for (i = 0; i < len; i++) {
+        a = &points[i];
+        b = &points[(i + 1) % len];
+        e = &edges[i];
+        if (a->y == b->y) {                         /* Horizontal edge is drawn as span on its line */
+            e->ys = e->ye = a->y;
+            e->xa = GUI_MIN(a->x, b->x);
+            e->xb = GUI_MAX(a->x, b->x);
+            e->d = 0;
+        } else {
+            if (a->y > b->y) {                      /* Start edge at top point */
+                a = b;
+                b = &points[i];
+            }
+            e->ys = e->ya = a->y;
+            e->ye = b->y;
+            e->xa = a->x;
+            dx = (int32_t)b->x - a->x;
+            dy = (int32_t)b->y - a->y;
+            e->q = dx / dy;                         /* Floor division of X step */
+            e->r = dx % dy;
+            if (e->r < 0) {
+                e->q--;
+                e->r += dy;
+            }
+            e->r *= 2;
+            e->d = 2 * dy;
         }
-        x += xinc2;
-        y += yinc2;
+        ymin = GUI_MIN(ymin, e->ys);
+        ymax = GUI_MAX(ymax, e->ye);
     }
+
+    /*
+     * Vertex where polygon continues in the same vertical direction
+     * is shared by 2 edges and must be counted only once,
+     * remove it from edge which starts at this vertex.
+     * Horizontal edges between both edges are skipped
+     */
+    for (prev = len; prev > 0 && points[prev - 1].y == points[prev % len].y; prev--) {}
+    if (prev > 0) {
+        prev--;
+        for (i = 0; i < len; i++) {
+            a = &points[i];
+            b = &points[(i + 1) % len];
+            if (a->y == b->y) {
+                continue;
+            }
+            if ((points[(prev + 1) % len].y > points[prev].y) == (b->y > a->y)) {
+                if (b->y > a->y) {
+                    edges[i].ys++;
+                } else {
+                    edges[i].ye--;
+                }
+            }
+            prev = i;
+        }
+    }
+
+    /* Sort edge table by first scanline */
+    for (i = 1; i < len; i++) {
+        tmp = edges[i];
+        for (k = i; k > 0 && edges[k - 1].ys > tmp.ys; k--) {
+            edges[k] = edges[k - 1];
+        }
+        edges[k] = tmp;
+    }
+
+    ymin = GUI_MAX(ymin, disp->y1);
+    ymax = GUI_MIN(ymax, disp->y2 - 1);
+    for (y = ymin; y <= ymax; y++) {
+        /* Add new edges to active list and remove finished ones */
+        for (; count < len && edges[count].ys <= y; count++) {
+            e = &edges[count];
+            if (e->d != 0 && e->ye >= y) {
+                e->x = e->xa;
+                e->err = e->d / 2;                  /* Rounded X position */
+                for (t1 = e->ya; t1 < y; t1++) {
+                    poly_edge_step(e);
+                }
+            }
+        }
+        for (i = first; i < count; i++) {
+            if (edges[i].ye < y) {
+                tmp = edges[i];
+                edges[i] = edges[first];
+                edges[first++] = tmp;
+            }
+        }
+
+        /* Collect crossings and horizontal edges */
+        xcnt = 0;
+        scnt = 0;
+        for (i = first; i < count; i++) {
+            e = &edges[i];
+            if (e->d == 0) {
+                sx1[scnt] = e->xa;
+                sx2[scnt++] = e->xb;
+            } else {
+                xs[xcnt++] = (gui_dim_t)e->x;
+                poly_edge_step(e);
+            }
+        }
+        for (i = 1; i < xcnt; i++) {
+            t1 = xs[i];
+            for (k = i; k > 0 && xs[k - 1] > t1; k--) {
+                xs[k] = xs[k - 1];
+            }
+            xs[k] = t1;
+        }
+        for (i = 0; i + 1 < xcnt; i += 2) {         /* Pairs of crossings are inside polygon */
+            sx1[scnt] = xs[i];
+            sx2[scnt++] = xs[i + 1];
+        }
+
+        /* Sort spans, merge overlapping and draw each with single line */
+        for (i = 1; i < scnt; i++) {
+            t1 = sx1[i];
+            t2 = sx2[i];
+            for (k = i; k > 0 && sx1[k - 1] > t1; k--) {
+                sx1[k] = sx1[k - 1];
+                sx2[k] = sx2[k - 1];
+            }
+            sx1[k] = t1;
+            sx2[k] = t2;
+        }
+        for (i = 0; i < scnt;) {
+            t1 = sx1[i];
+            t2 = sx2[i];
+            for (i++; i < scnt && sx1[i] <= t2 + 1; i++) {
+                t2 = GUI_MAX(t2, sx2[i]);
+            }
+            gui_draw_hline(disp, t1, y, t2 - t1 + 1, color);
+        }
+    }
+}
+
+/**
+ * \brief           Draw triangle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x1: Triangle point 1 X position
+ * \param[in]       y1: Triangle point 1 Y position
+ * \param[in]       x2: Triangle point 2 X position
+ * \param[in]       y2: Triangle point 2 Y position
+ * \param[in]       x3: Triangle point 3 X position
+ * \param[in]       y3: Triangle point 3 Y position
+ * \param[in]       color: Color used for drawing operation 
+ * \sa              gui_draw_filledtriangle
+ */
+void
+gui_draw_triangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1,  gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color) {
+    gui_draw_line(disp, x1, y1, x2, y2, color);
+    gui_draw_line(disp, x1, y1, x3, y3, color);
+    gui_draw_line(disp, x2, y2, x3, y3, color);
+}
+
+/**
+ * \brief           Draw filled triangle
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x1: Triangle point 1 X position
+ * \param[in]       y1: Triangle point 1 Y position
+ * \param[in]       x2: Triangle point 2 X position
+ * \param[in]       y2: Triangle point 2 Y position
+ * \param[in]       x3: Triangle point 3 X position
+ * \param[in]       y3: Triangle point 3 Y position
+ * \param[in]       color: Color used for drawing operation 
+ * \sa              gui_draw_triangle, gui_draw_filledpoly
+ */
+void
+gui_draw_filledtriangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color) {
+    gui_draw_poly_t p[3];
+
+    p[0].x = x1;
+    p[0].y = y1;
+    p[1].x = x2;
+    p[1].y = y2;
+    p[2].x = x3;
+    p[2].y = y3;
+    gui_draw_filledpoly(disp, p, GUI_COUNT_OF(p), color);
 }
 
 /**
@@ -1055,50 +1912,308 @@ gui_draw_filledcirclecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y
         ddF_x += 2;
         f += ddF_x;
 
-        if (c & GUI_DRAW_CIRCLE_TL) {               /* Top left */            
-            gui_draw_hline(disp, x0 - x, y0 - y, x, color);
-            gui_draw_hline(disp, x0 - y, y0 - x, y, color);
-        }
-        if (c & GUI_DRAW_CIRCLE_TR) {               /* Top right */
-            gui_draw_hline(disp, x0, y0 - y, x, color);
-            gui_draw_hline(disp, x0, y0 - x, y, color);
+        if (c & GUI_DRAW_CIRCLE_TL) {               /* Top left */            
+            gui_draw_hline(disp, x0 - x, y0 - y, x, color);
+            gui_draw_hline(disp, x0 - y, y0 - x, y, color);
+        }
+        if (c & GUI_DRAW_CIRCLE_TR) {               /* Top right */
+            gui_draw_hline(disp, x0, y0 - y, x, color);
+            gui_draw_hline(disp, x0, y0 - x, y, color);
+        }
+        if (c & GUI_DRAW_CIRCLE_BL) {               /* Bottom left */
+            gui_draw_hline(disp, x0 - y, y0 + x, y, color);
+            gui_draw_hline(disp, x0 - x, y0 + y, x, color);
+        }
+        if (c & GUI_DRAW_CIRCLE_BR) {               /* Bottom right */
+            gui_draw_hline(disp, x0, y0 + x, y, color);
+            gui_draw_hline(disp, x0, y0 + y, x, color);
+        }
+    }
+}
+
+/**
+ * \brief           Read 32-bit color stored least significant byte first
+ * \param[in]       d: Pointer to color data
+ * \return          Color value
+ */
+static gui_color_t
+read_color32(const uint8_t* d) {
+    return (gui_color_t)d[0] | ((gui_color_t)d[1] << 8) | ((gui_color_t)d[2] << 16) | ((gui_color_t)d[3] << 24);
+}
+
+/**
+ * \brief           Prepare reader for encoded image, positioned to first pixel
+ * \param[out]      r: Image reader to initialize
+ * \param[in]       img: Image descriptor
+ */
+static void
+image_reader_init(gui_image_reader_t* r, const gui_image_desc_t* img) {
+    memset(r, 0x00, sizeof(*r));
+    r->img = img;
+    r->data = img->image;
+    if (img->format == GUI_IMAGE_FORMAT_QOI) {
+        r->data += QOI_HEADER_SIZE;                 /* Image size is taken from descriptor */
+        r->value = 0xFF000000UL;                    /* Previous pixel is opaque black at start */
+    }
+}
+
+/**
+ * \brief           Set reader to start of line in indexed image
+ * \param[in,out]   r: Image reader
+ * \param[in]       y: Line index
+ */
+static void
+image_reader_seekline(gui_image_reader_t* r, gui_dim_t y) {
+    r->data = r->img->image + (size_t)y * (((size_t)r->img->x_size * r->img->bpp + 7) >> 3);
+    r->bits = 0;
+}
+
+/**
+ * \brief           Decode next operation of QOI image
+ * \note            Decoded pixel is saved to `value` member
+ *                  and `run` member is set to number of pixels with this value
+ * \param[in,out]   r: Image reader
+ */
+static void
+qoi_decode(gui_image_reader_t* r) {
+    const uint8_t* d = r->data;
+    gui_color_t c = r->value;
+    uint32_t vg;
+    uint8_t b;
+
+    r->run = 1;
+    b = *d++;
+    if (b == QOI_OP_RGB) {
+        c = (c & 0xFF000000UL) | ((uint32_t)d[0] << 16) | ((uint32_t)d[1] << 8) | d[2];
+        d += 3;
+    } else if (b == QOI_OP_RGBA) {
+        c = ((uint32_t)d[3] << 24) | ((uint32_t)d[0] << 16) | ((uint32_t)d[1] << 8) | d[2];
+        d += 4;
+    } else {
+        switch (b & 0xC0) {
+            case QOI_OP_INDEX:
+                c = r->index[b];
+                break;
+            case QOI_OP_DIFF:                       /* Differences between -2 and 1, with wrap around */
+                c = (c & 0xFF000000UL)
+                    | ((((c >> 16) + ((b >> 4) & 0x03) - 2) & 0xFF) << 16)
+                    | ((((c >> 8) + ((b >> 2) & 0x03) - 2) & 0xFF) << 8)
+                    | ((c + (b & 0x03) - 2) & 0xFF);
+                break;
+            case QOI_OP_LUMA:                       /* Green difference and red and blue relative to it */
+                vg = (uint32_t)(b & 0x3F) - 32;
+                b = *d++;
+                c = (c & 0xFF000000UL)
+                    | ((((c >> 16) + vg - 8 + (b >> 4)) & 0xFF) << 16)
+                    | ((((c >> 8) + vg) & 0xFF) << 8)
+                    | ((c + vg - 8 + (b & 0x0F)) & 0xFF);
+                break;
+            default:
+                r->run = (b & 0x3F) + 1;
+                break;
+        }
+    }
+    r->index[(((c >> 16) & 0xFF) * 3 + ((c >> 8) & 0xFF) * 5 + (c & 0xFF) * 7 + (c >> 24) * 11) & 0x3F] = c;
+    r->value = c;
+    r->data = d;
+}
+
+/**
+ * \brief           Read next pixels from encoded image
+ * \param[in,out]   r: Image reader
+ * \param[out]      buff: Buffer for ARGB8888 pixels. Set to `NULL` to skip pixels
+ * \param[in]       count: Number of pixels to read
+ */
+static void
+image_reader_read(gui_image_reader_t* r, gui_color_t* buff, uint32_t count) {
+    const uint8_t* d = r->data;
+    uint32_t n;
+    uint8_t v, bpp = r->img->bpp;
+
+    switch (r->img->format) {
+        case GUI_IMAGE_FORMAT_INDEXED: {
+            if (buff == NULL) {                     /* Pixels have fixed size, skip them directly */
+                n = r->bits + count * bpp;
+                d += n >> 3;
+                r->bits = (uint8_t)(n & 0x07);
+                break;
+            }
+            v = (uint8_t)((1U << bpp) - 1);         /* Index mask */
+            for (; count > 0; count--) {
+                r->bits += bpp;
+                *buff++ = r->img->palette[(*d >> (8 - r->bits)) & v];
+                if (r->bits == 8) {
+                    r->bits = 0;
+                    d++;
+                }
+            }
+            break;
+        }
+        case GUI_IMAGE_FORMAT_RLE: {
+            while (count > 0) {
+                if (!r->run) {                      /* Start of new run */
+                    v = *d++;
+                    r->run = (v & (GUI_IMAGE_RLE_RUN_MAX - 1)) + 1;
+                    r->repeat = (v & GUI_IMAGE_RLE_REPEAT) == GUI_IMAGE_RLE_REPEAT;
+                    if (r->repeat) {
+                        r->value = read_color32(d);
+                        d += 4;
+                    }
+                }
+                n = GUI_MIN(r->run, count);
+                r->run -= n;
+                count -= n;
+                if (buff == NULL) {
+                    d += r->repeat ? 0 : 4 * n;
+                } else if (r->repeat) {
+                    for (; n > 0; n--) {
+                        *buff++ = r->value;
+                    }
+                } else {
+                    for (; n > 0; n--, d += 4) {
+                        *buff++ = read_color32(d);
+                    }
+                }
+            }
+            break;
+        }
+        case GUI_IMAGE_FORMAT_QOI: {
+            while (count > 0) {
+                if (!r->run) {
+                    r->data = d;
+                    qoi_decode(r);
+                    d = r->data;
+                }
+                n = GUI_MIN(r->run, count);
+                r->run -= n;
+                count -= n;
+                if (buff != NULL) {
+                    for (; n > 0; n--) {
+                        *buff++ = r->value;
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    r->data = d;
+}
+
+/**
+ * \brief           Draw line of ARGB8888 pixels with low-level `DrawImage32` function
+ * \note            Pixels are converted in place to 32-bit image format of low-level driver.
+ *                  Caller must wait for low-level driver to be ready before buffer is reused
+ * \param[in]       x: Start X position on screen
+ * \param[in]       y: Start Y position on screen
+ * \param[in]       img: Image descriptor, passed to low-level function
+ * \param[in,out]   line: Pixels to draw, up to \ref IMAGE_LINE_PIXELS
+ * \param[in]       n: Number of pixels to draw
+ * \param[in]       vertical: Set to `1` to draw pixels from top to bottom, `0` from left to right
+ */
+static void
+draw_image_line(gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, gui_color_t* line, gui_dim_t n, uint8_t vertical) {
+    gui_layer_t* layer = GUI.lcd.drawing_layer;
+    gui_color_t c;
+    uint8_t* dst;
+    uint8_t* p;
+    gui_dim_t k;
+
+    for (k = 0, p = (uint8_t *)line; k < n; k++, p += 4) {
+        c = line[k];
+        p[0] = (uint8_t)(c >> 16);
+        p[1] = (uint8_t)(c >> 8);
+        p[2] = (uint8_t)c;
+        p[3] = (uint8_t)(0xFF - (c >> 24));
+    }
+    dst = (uint8_t *)layer->start_address + GUI.lcd.pixel_size * ((size_t)(y - layer->y_pos) * layer->width + (x - layer->x_pos));
+    if (vertical) {
+        GUI.ll.DrawImage32(&GUI.lcd, layer, img, dst, line, 1, n, layer->width - 1, 0);
+    } else {
+        GUI.ll.DrawImage32(&GUI.lcd, layer, img, dst, line, n, 1, 0, 0);
+    }
+}
+
+/**
+ * \brief           Draw encoded image, decoded line by line to visible area
+ * \note            Lines above visible area are skipped without conversion, decoding stops
+ *                  after last visible line. Decoded pixels are passed to low-level `DrawImage32` function
+ *                  in blocks of up to \ref IMAGE_LINE_PIXELS pixels
+ * \param[in]       disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       img: Image descriptor
+ */
+static void
+draw_image_encoded(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img) {
+    gui_image_reader_t r;
+    gui_color_t line[IMAGE_LINE_PIXELS];
+    gui_dim_t x1, x2, y1, y2, row, i, n;
+
+    if (GUI.ll.DrawImage32 == NULL || img->image == NULL
+        || (img->format == GUI_IMAGE_FORMAT_INDEXED && img->palette == NULL)) {
+        return;
+    }
+    x1 = GUI_MAX(x, disp->x1) - x;                  /* Visible part, relative to image */
+    x2 = GUI_MIN(x + img->x_size, disp->x2) - x;
+    y1 = GUI_MAX(y, disp->y1) - y;
+    y2 = GUI_MIN(y + img->y_size, disp->y2) - y;
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    image_reader_init(&r, img);
+    if (img->format != GUI_IMAGE_FORMAT_INDEXED) {
+        image_reader_read(&r, NULL, (uint32_t)y1 * (uint32_t)img->x_size);
+    }
+    for (row = y1; row < y2; row++) {
+        if (img->format == GUI_IMAGE_FORMAT_INDEXED) {
+            image_reader_seekline(&r, row);
         }
-        if (c & GUI_DRAW_CIRCLE_BL) {               /* Bottom left */
-            gui_draw_hline(disp, x0 - y, y0 + x, y, color);
-            gui_draw_hline(disp, x0 - x, y0 + y, x, color);
+        image_reader_read(&r, NULL, x1);
+        for (i = x1; i < x2; i += n) {
+            n = GUI_MIN(x2 - i, IMAGE_LINE_PIXELS);
+            while (!GUI.ll.IsReady(&GUI.lcd));      /* Line buffer may still be used by previous transfer */
+            image_reader_read(&r, line, n);
+            draw_image_line(x + i, y + row, img, line, n, 0);
         }
-        if (c & GUI_DRAW_CIRCLE_BR) {               /* Bottom right */
-            gui_draw_hline(disp, x0, y0 + x, y, color);
-            gui_draw_hline(disp, x0, y0 + y, x, color);
+        if (img->format != GUI_IMAGE_FORMAT_INDEXED && row + 1 < y2) {
+            image_reader_read(&r, NULL, img->x_size - x2);
         }
     }
+    while (!GUI.ll.IsReady(&GUI.lcd));              /* Wait before line buffer is released */
 }
 
 /**
- * \brief           Draw image to display of any depth and size
- * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \brief           Draw complete image at position, without image offset
+ * \param[in]       disp: Pointer to \ref gui_display_t structure for display operations
  * \param[in]       x: Top left X position
  * \param[in]       y: Top left Y position
- * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description 
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description
  */
-void
-gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img) {
-    uint8_t bytes = img->bpp >> 3;                  /* Get number of bytes per pixel on image */
-    
+static void
+draw_image(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img) {
+    uint8_t bytes;
     gui_layer_t* layer;
     const uint8_t* src;
     const uint8_t* dst;
     gui_dim_t width, height;
     gui_dim_t offlineSrc, offlineDst;
     
-    if (!img || !GUI_RECT_MATCH(
+    if (!GUI_RECT_MATCH(
         disp->x1, disp->y1, disp->x2, disp->y2,
         x, y, x + img->x_size, y + img->y_size
     )) {
         return;
     }
+    if (img->format != GUI_IMAGE_FORMAT_RAW) {      /* Encoded images are decoded line by line */
+        draw_image_encoded(disp, x, y, img);
+        return;
+    }
     
     layer = GUI.lcd.drawing_layer;                  /* Set layer pointer */
+    bytes = img->bpp >> 3;                          /* Get number of bytes per pixel on image */
     
     width = img->x_size;                            /* Set default width */
     height = img->y_size;                           /* Set default height */
@@ -1106,10 +2221,9 @@ gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_de
     src = (uint8_t *)(img->image);                  /* Set source address */
     dst = (uint8_t *)(((uint8_t *)layer->start_address) + GUI.lcd.pixel_size * ((y - layer->y_pos) * layer->width + (x - layer->x_pos)));
     
-    //TODO: Check proper coordinates for memory!
     if (y < disp->y1) {
         src += (disp->y1 - y) * img->x_size * bytes;/* Set offset for number of image lines */
-        dst += (disp->y1 - y) * GUI.lcd.width * GUI.lcd.pixel_size;  /* Set offset for number of LCD lines */
+        dst += (disp->y1 - y) * layer->width * GUI.lcd.pixel_size;  /* Set offset for number of layer lines */
         height -= disp->y1 - y;                     /* Decrease effective height */
     }
     if ((y + img->y_size) > disp->y2) {
@@ -1145,12 +2259,498 @@ gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_de
     }
 }
 
+/**
+ * \brief           Get pixel of source image for scaled or rotated drawing
+ * \param[in]       s: Image source
+ * \param[in]       x: X position in image
+ * \param[in]       y: Y position in image
+ * \return          ARGB8888 color
+ */
+static gui_color_t
+image_source_getpixel(const gui_image_source_t* s, gui_dim_t x, gui_dim_t y) {
+    const gui_image_desc_t* img = s->img;
+    const uint8_t* p;
+    uint32_t v, r, g, b;
+
+    if (s->pixels != NULL) {                        /* Decoded part of encoded image */
+        return s->pixels[(size_t)(y - s->y) * s->width + (x - s->x)];
+    }
+    if (img->format == GUI_IMAGE_FORMAT_INDEXED) {
+        p = img->image + (size_t)y * (((size_t)img->x_size * img->bpp + 7) >> 3) + (((size_t)x * img->bpp) >> 3);
+        v = (*p >> (8 - img->bpp - ((x * img->bpp) & 0x07))) & ((1U << img->bpp) - 1);
+        return img->palette[v];
+    }
+    p = img->image + ((size_t)y * img->x_size + x) * (img->bpp >> 3);
+    switch (img->bpp) {
+        case 16:                                    /* Red in lower bits */
+            v = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+            r = v & 0x1F;
+            g = (v >> 5) & 0x3F;
+            b = v >> 11;
+            return 0xFF000000UL | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+        case 24:
+            return 0xFF000000UL | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+        default:
+            return ((uint32_t)(0xFF - p[3]) << 24) | ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    }
+}
+
+/**
+ * \brief           Decode window of two rows of encoded image
+ * \note            Encoded image is read sequentially, reader is restarted
+ *                  only when window moves back to rows before it
+ * \param[in,out]   s: Image source with memory for two rows
+ * \param[in]       y: First row of window in image data, next row is decoded too when it exists
+ */
+static void
+image_source_loadrows(gui_image_source_t* s, gui_dim_t y) {
+    const gui_image_desc_t* img = s->img;
+    gui_dim_t row, n;
+    uint32_t start;
+
+    n = GUI_MIN(2, img->y_size - y);
+    if (s->height && y == s->y && n == s->height) {
+        return;                                     /* Rows are already decoded */
+    }
+    row = 0;
+    if (s->height == 2 && y == s->y + 1) {          /* Move by one row, keep second row */
+        memcpy(s->pixels, s->pixels + s->width, sizeof(*s->pixels) * s->width);
+        row = 1;
+    } else if (y < s->y || (s->height && s->pos > (uint32_t)y * img->x_size + s->x)) {
+        image_reader_init(s->reader, img);          /* Rows before window, restart reader */
+        s->pos = 0;
+    }
+    s->y = y;
+    s->height = n;
+    for (; row < n; row++) {
+        start = (uint32_t)(y + row) * img->x_size + s->x;
+        image_reader_read(s->reader, NULL, start - s->pos);
+        image_reader_read(s->reader, s->pixels + (size_t)row * s->width, s->width);
+        s->pos = start + s->width;
+    }
+}
+
+/**
+ * \brief           Get row in image data for row or column of rotated source rectangle,
+ *                  which is mapped to rows of source rectangle
+ * \param[in]       s: Image source
+ * \param[in]       b: Blit parameters with rotation and source rectangle
+ * \param[in]       t: Y position in rotated source for `0` and `180` degrees rotation, X position otherwise
+ * \return          Row in image data, may be outside of image data
+ */
+static gui_dim_t
+image_source_getrow(const gui_image_source_t* s, const gui_image_blit_t* b, gui_dim_t t) {
+    if (b->rotate == GUI_IMAGE_ROTATE_90 || b->rotate == GUI_IMAGE_ROTATE_180) {
+        t = b->src_height - 1 - t;
+    }
+    return t + b->src_y - s->img->y_offset;
+}
+
+/**
+ * \brief           Get source pixel from position in rotated source rectangle
+ * \note            Pixels in trimmed border of image are transparent
+ * \param[in]       s: Image source
+ * \param[in]       b: Blit parameters with rotation and source rectangle
+ * \param[in]       u: X position in rotated source rectangle
+ * \param[in]       v: Y position in rotated source rectangle
+ * \return          ARGB8888 color
+ */
+static gui_color_t
+image_source_getrotated(const gui_image_source_t* s, const gui_image_blit_t* b, gui_dim_t u, gui_dim_t v) {
+    gui_dim_t x = u, y = v;
+
+    switch (b->rotate) {
+        case GUI_IMAGE_ROTATE_90:   x = v;                      y = b->src_height - 1 - u;  break;
+        case GUI_IMAGE_ROTATE_180:  x = b->src_width - 1 - u;   y = b->src_height - 1 - v;  break;
+        case GUI_IMAGE_ROTATE_270:  x = b->src_width - 1 - v;   y = u;                      break;
+        default: break;
+    }
+    x += b->src_x - s->img->x_offset;               /* Position in image data */
+    y += b->src_y - s->img->y_offset;
+    if (x < 0 || y < 0 || x >= s->img->x_size || y >= s->img->y_size) {
+        return 0;
+    }
+    return image_source_getpixel(s, x, y);
+}
+
+/**
+ * \brief           Interpolate 4 pixels with bilinear filter
+ * \note            Colors are weighted by their alpha, so transparent pixels do not darken edges
+ * \param[in]       c: Top left, top right, bottom left and bottom right pixels
+ * \param[in]       fu: Horizontal fraction between `0` and `255`
+ * \param[in]       fv: Vertical fraction between `0` and `255`
+ * \param[in]       premul: Set to `1` when pixels have premultiplied alpha
+ * \return          Interpolated color
+ */
+static gui_color_t
+image_bilinear(const gui_color_t* c, uint32_t fu, uint32_t fv, uint8_t premul) {
+    uint32_t w[4], a, sum_a = 0, sum_r = 0, sum_g = 0, sum_b = 0;
+    uint8_t i;
+
+    if (!((c[0] ^ c[1]) | (c[0] ^ c[2]) | (c[0] ^ c[3]))) {
+        return c[0];                                /* All pixels are equal */
+    }
+    if (!(((c[0] ^ c[1]) | (c[0] ^ c[2]) | (c[0] ^ c[3])) >> 24)) {
+        premul = 1;                                 /* Equal alpha, weighting by alpha is not needed */
+    }
+    w[0] = ((256 - fu) * (256 - fv)) >> 8;          /* Weights with sum of 256 */
+    w[1] = (fu * (256 - fv)) >> 8;
+    w[2] = ((256 - fu) * fv) >> 8;
+    w[3] = 256 - w[0] - w[1] - w[2];
+    for (i = 0; i < 4; i++) {
+        a = premul ? w[i] : w[i] * (c[i] >> 24);
+        sum_a += w[i] * (c[i] >> 24);
+        sum_r += a * ((c[i] >> 16) & 0xFF);
+        sum_g += a * ((c[i] >> 8) & 0xFF);
+        sum_b += a * (c[i] & 0xFF);
+    }
+    if (premul) {
+        return ((sum_a >> 8) << 24) | ((sum_r >> 8) << 16) | ((sum_g >> 8) << 8) | (sum_b >> 8);
+    }
+    if (!sum_a) {
+        return 0;
+    }
+    return ((sum_a >> 8) << 24) | ((sum_r / sum_a) << 16) | ((sum_g / sum_a) << 8) | (sum_b / sum_a);
+}
+
+/**
+ * \brief           Draw scaled and rotated image with software
+ * \note            Pixels are passed to low-level `DrawImage32` function line by line.
+ *                  RLE and QOI images are decoded once, to temporary memory of two image rows
+ * \param[in]       disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position on screen
+ * \param[in]       y: Top left Y position on screen
+ * \param[in]       img: Image descriptor
+ * \param[in]       b: Blit parameters with all sizes set and source rectangle inside original image
+ */
+static void
+draw_image_transformed(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, const gui_image_blit_t* b) {
+    gui_image_source_t s;
+    gui_image_reader_t r;
+    gui_color_t line[IMAGE_LINE_PIXELS], c[4];
+    gui_dim_t x1, x2, y1, y2, rw, rh, m, pos, i, i1, i2, n, k, u0, v0, u1, v1, t0, t1, w0, r0, r1;
+    gui_dim_t dx1, dx2, dy1, dy2, ru1, ru2, rv1, rv2;
+    int32_t fx, fy, t, w, half;
+    uint32_t fu, fv, ft;
+    uint8_t rotated, reverse;
+    uint8_t premul = (img->flags & GUI_IMAGE_FLAG_PREMULTIPLIED) == GUI_IMAGE_FLAG_PREMULTIPLIED;
+
+    if (GUI.ll.DrawImage32 == NULL || img->image == NULL
+        || (img->format == GUI_IMAGE_FORMAT_INDEXED && img->palette == NULL)) {
+        return;
+    }
+
+    /* Part of source rectangle with image data, trimmed border around it is transparent */
+    dx1 = GUI_MAX(img->x_offset - b->src_x, 0);
+    dx2 = GUI_MIN(img->x_offset + img->x_size - b->src_x, b->src_width);
+    dy1 = GUI_MAX(img->y_offset - b->src_y, 0);
+    dy2 = GUI_MIN(img->y_offset + img->y_size - b->src_y, b->src_height);
+    if (dx1 >= dx2 || dy1 >= dy2) {
+        return;
+    }
+
+    /* Same part in rotated source rectangle */
+    switch (b->rotate) {
+        case GUI_IMAGE_ROTATE_90:   ru1 = b->src_height - dy2;  ru2 = b->src_height - dy1;  rv1 = dx1;                  rv2 = dx2;                  break;
+        case GUI_IMAGE_ROTATE_180:  ru1 = b->src_width - dx2;   ru2 = b->src_width - dx1;   rv1 = b->src_height - dy2;  rv2 = b->src_height - dy1;  break;
+        case GUI_IMAGE_ROTATE_270:  ru1 = dy1;                  ru2 = dy2;                  rv1 = b->src_width - dx2;   rv2 = b->src_width - dx1;   break;
+        default:                    ru1 = dx1;                  ru2 = dx2;                  rv1 = dy1;                  rv2 = dy2;                  break;
+    }
+
+    /* Size of rotated source and 16.16 fixed point step between screen pixels */
+    rw = b->rotate == GUI_IMAGE_ROTATE_90 || b->rotate == GUI_IMAGE_ROTATE_270 ? b->src_height : b->src_width;
+    rh = b->rotate == GUI_IMAGE_ROTATE_90 || b->rotate == GUI_IMAGE_ROTATE_270 ? b->src_width : b->src_height;
+
+    /* Visible area on screen, limited to image data with one source pixel margin for filter */
+    x1 = GUI_MAX(x, disp->x1);
+    x2 = GUI_MIN(x + b->width, disp->x2);
+    y1 = GUI_MAX(y, disp->y1);
+    y2 = GUI_MIN(y + b->height, disp->y2);
+    if (ru1 > 0) {
+        x1 = GUI_MAX(x1, x + (gui_dim_t)((int32_t)(ru1 - 1) * b->width / rw) - 1);
+    }
+    if (ru2 < rw) {
+        x2 = GUI_MIN(x2, x + (gui_dim_t)((int32_t)(ru2 + 1) * b->width / rw) + 2);
+    }
+    if (rv1 > 0) {
+        y1 = GUI_MAX(y1, y + (gui_dim_t)((int32_t)(rv1 - 1) * b->height / rh) - 1);
+    }
+    if (rv2 < rh) {
+        y2 = GUI_MIN(y2, y + (gui_dim_t)((int32_t)(rv2 + 1) * b->height / rh) + 2);
+    }
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    memset(&s, 0x00, sizeof(s));
+    s.img = img;
+    if (img->format == GUI_IMAGE_FORMAT_RLE || img->format == GUI_IMAGE_FORMAT_QOI) {
+        s.x = b->src_x + dx1 - img->x_offset;       /* Decode only columns with image data */
+        s.width = dx2 - dx1;
+        s.pixels = GUI_MEMALLOC(sizeof(*s.pixels) * 2 * s.width);
+        if (s.pixels == NULL) {
+            return;
+        }
+        s.reader = &r;
+        image_reader_init(&r, img);
+    }
+
+    fx = (int32_t)(((uint32_t)rw << 16) / (uint32_t)b->width);
+    fy = (int32_t)(((uint32_t)rh << 16) / (uint32_t)b->height);
+
+    /*
+     * Screen rows are processed for 0 and 180 degrees rotation, screen columns otherwise.
+     * They are processed in order of rising rows of image data,
+     * so encoded image is decoded only once, with window of two rows for bilinear filter
+     */
+    rotated = b->rotate == GUI_IMAGE_ROTATE_90 || b->rotate == GUI_IMAGE_ROTATE_270;
+    reverse = b->rotate == GUI_IMAGE_ROTATE_90 || b->rotate == GUI_IMAGE_ROTATE_180;
+    half = b->filter == GUI_IMAGE_FILTER_BILINEAR ? 0x8000 : 0; /* Bilinear filter is relative to source pixel centers */
+    for (m = 0; m < (rotated ? x2 - x1 : y2 - y1); m++) {
+        /* Position on major axis, sampled in center of screen pixel */
+        if (rotated) {
+            pos = reverse ? x2 - 1 - m : x1 + m;
+            t = fx / 2 + (pos - x) * fx - half;
+            t0 = GUI_MIN(GUI_DIM(t < 0 ? 0 : t >> 16), rw - 1);
+            t1 = GUI_MIN(t0 + 1, rw - 1);
+        } else {
+            pos = reverse ? y2 - 1 - m : y1 + m;
+            t = fy / 2 + (pos - y) * fy - half;
+            t0 = GUI_MIN(GUI_DIM(t < 0 ? 0 : t >> 16), rh - 1);
+            t1 = GUI_MIN(t0 + 1, rh - 1);
+        }
+        ft = t < 0 ? 0 : (t >> 8) & 0xFF;
+        if (s.pixels != NULL) {                     /* Decode rows used by this row or column */
+            r0 = image_source_getrow(&s, b, t0);
+            r1 = image_source_getrow(&s, b, t1);
+            r0 = GUI_MIN(r0, r1);
+            if (r0 + 1 >= 0 && r0 < img->y_size) {
+                image_source_loadrows(&s, GUI_MAX(r0, 0));
+            }
+        }
+
+        /* Pixels on minor axis */
+        i1 = rotated ? y1 : x1;
+        i2 = rotated ? y2 : x2;
+        for (i = i1; i < i2; i += n) {
+            n = GUI_MIN(i2 - i, IMAGE_LINE_PIXELS);
+            w = rotated ? fy / 2 + (i - y) * fy - half : fx / 2 + (i - x) * fx - half;
+            while (!GUI.ll.IsReady(&GUI.lcd));      /* Line buffer may still be used by previous transfer */
+            for (k = 0; k < n; k++, w += rotated ? fy : fx) {
+                w0 = GUI_MIN(GUI_DIM(w < 0 ? 0 : w >> 16), (rotated ? rh : rw) - 1);
+                if (rotated) {
+                    u0 = t0; u1 = t1; v0 = w0; v1 = GUI_MIN(w0 + 1, rh - 1);
+                    fu = ft; fv = w < 0 ? 0 : (w >> 8) & 0xFF;
+                } else {
+                    u0 = w0; u1 = GUI_MIN(w0 + 1, rw - 1); v0 = t0; v1 = t1;
+                    fu = w < 0 ? 0 : (w >> 8) & 0xFF; fv = ft;
+                }
+                if (b->filter != GUI_IMAGE_FILTER_BILINEAR) {
+                    line[k] = image_source_getrotated(&s, b, u0, v0);
+                    continue;
+                }
+                c[0] = image_source_getrotated(&s, b, u0, v0);
+                c[1] = image_source_getrotated(&s, b, u1, v0);
+                c[2] = image_source_getrotated(&s, b, u0, v1);
+                c[3] = image_source_getrotated(&s, b, u1, v1);
+                line[k] = image_bilinear(c, fu, fv, premul);
+            }
+            if (rotated) {
+                draw_image_line(pos, i, img, line, n, 1);
+            } else {
+                draw_image_line(i, pos, img, line, n, 0);
+            }
+        }
+    }
+    while (!GUI.ll.IsReady(&GUI.lcd));              /* Wait before line buffer is released */
+    if (s.pixels != NULL) {
+        GUI_MEMFREE(s.pixels);
+    }
+}
+
+/**
+ * \brief           Draw image to display of any depth and size
+ * \note            Image offset of trimmed images is added to position
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position
+ * \param[in]       y: Top left Y position
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description 
+ * \sa              gui_draw_image_blit
+ */
+void
+gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img) {
+    if (img == NULL) {
+        return;
+    }
+    draw_image(disp, x + img->x_offset, y + img->y_offset, img);
+}
+
+/**
+ * \brief           Initializes \ref gui_image_blit_t structure to draw complete image without scaling and rotation
+ * \param[out]      blit: Pointer to \ref gui_image_blit_t to initialize
+ */
+void
+gui_draw_image_blit_init(gui_image_blit_t* blit) {
+    memset(blit, 0x00, sizeof(*blit));              /* Reset structure */
+}
+
+/**
+ * \brief           Draw part of image with scaling and rotation
+ * \note            Low-level `DrawImageScaled` or `DrawImageRotated` function is used when set
+ *                  and image is not trimmed, otherwise image is drawn with software and clipped to display.
+ *                  Source rectangle is in coordinates of original image, trimmed border is transparent
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position on screen
+ * \param[in]       y: Top left Y position on screen
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description
+ * \param[in]       blit: Pointer to \ref gui_image_blit_t parameters. Source rectangle is limited to original image
+ */
+void
+gui_draw_image_blit(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, const gui_image_blit_t* blit) {
+    gui_image_blit_t b;
+    gui_display_t clip;
+    gui_dim_t rw, rh, iw, ih;
+    uint8_t rotated;
+
+    if (img == NULL || blit == NULL) {
+        return;
+    }
+    iw = GUI_IMAGE_WIDTH(img);                      /* Size of original image */
+    ih = GUI_IMAGE_HEIGHT(img);
+    b = *blit;
+    if (!b.src_width) {
+        b.src_width = iw - b.src_x;
+    }
+    if (!b.src_height) {
+        b.src_height = ih - b.src_y;
+    }
+    if (b.src_x < 0) {                              /* Limit source rectangle to image */
+        b.src_width += b.src_x;
+        b.src_x = 0;
+    }
+    if (b.src_y < 0) {
+        b.src_height += b.src_y;
+        b.src_y = 0;
+    }
+    b.src_width = GUI_MIN(b.src_width, iw - b.src_x);
+    b.src_height = GUI_MIN(b.src_height, ih - b.src_y);
+    if (b.src_width <= 0 || b.src_height <= 0) {
+        return;
+    }
+    rotated = b.rotate == GUI_IMAGE_ROTATE_90 || b.rotate == GUI_IMAGE_ROTATE_270;
+    rw = rotated ? b.src_height : b.src_width;
+    rh = rotated ? b.src_width : b.src_height;
+    if (!b.width) {
+        b.width = rw;
+    }
+    if (!b.height) {
+        b.height = rh;
+    }
+    if (b.width <= 0 || b.height <= 0) {
+        return;
+    }
+    if (!GUI_RECT_MATCH(
+        disp->x1, disp->y1, disp->x2, disp->y2,
+        x, y, x + b.width, y + b.height
+    )) {
+        return;
+    }
+
+    /* Part of image in original size is complete image moved and clipped to part */
+    if (b.rotate == GUI_IMAGE_ROTATE_0 && b.width == b.src_width && b.height == b.src_height) {
+        clip.x1 = GUI_MAX(disp->x1, x);
+        clip.y1 = GUI_MAX(disp->y1, y);
+        clip.x2 = GUI_MIN(disp->x2, x + b.width);
+        clip.y2 = GUI_MIN(disp->y2, y + b.height);
+        draw_image(&clip, x - b.src_x + img->x_offset, y - b.src_y + img->y_offset, img);
+        return;
+    }
+    if (GUI_IMAGE_ISTRIMMED(img)) {
+        /* Low-level functions draw only complete image data */
+    } else if (b.rotate != GUI_IMAGE_ROTATE_0) {
+        if (GUI.ll.DrawImageRotated != NULL && GUI.ll.DrawImageRotated(&GUI.lcd, GUI.lcd.drawing_layer, img, &b, disp, x, y)) {
+            return;
+        }
+    } else if (GUI.ll.DrawImageScaled != NULL && GUI.ll.DrawImageScaled(&GUI.lcd, GUI.lcd.drawing_layer, img, &b, disp, x, y)) {
+        return;
+    }
+    draw_image_transformed(disp, x, y, img, &b);
+}
+
+/**
+ * \brief           Draw complete image scaled to width and height
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position on screen
+ * \param[in]       y: Top left Y position on screen
+ * \param[in]       width: Width on screen
+ * \param[in]       height: Height on screen
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description
+ * \param[in]       filter: Scaling filter
+ * \sa              gui_draw_image_blit
+ */
+void
+gui_draw_image_scaled(gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, const gui_image_desc_t* img, gui_image_filter_t filter) {
+    gui_image_blit_t b;
+
+    gui_draw_image_blit_init(&b);
+    b.width = width;
+    b.height = height;
+    b.filter = filter;
+    gui_draw_image_blit(disp, x, y, img, &b);
+}
+
+/**
+ * \brief           Draw part of image in original size, such as single image of sprite sheet
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position on screen
+ * \param[in]       y: Top left Y position on screen
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description
+ * \param[in]       src_x: Source rectangle X position in original image, before trimming
+ * \param[in]       src_y: Source rectangle Y position in original image, before trimming
+ * \param[in]       width: Source rectangle width
+ * \param[in]       height: Source rectangle height
+ * \sa              gui_draw_image_blit
+ */
+void
+gui_draw_image_part(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, gui_dim_t src_x, gui_dim_t src_y, gui_dim_t width, gui_dim_t height) {
+    gui_image_blit_t b;
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    gui_draw_image_blit_init(&b);
+    b.src_x = src_x;
+    b.src_y = src_y;
+    b.src_width = width;
+    b.src_height = height;
+    gui_draw_image_blit(disp, x, y, img, &b);
+}
+
+/**
+ * \brief           Draw complete image rotated in clockwise direction
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       x: Top left X position of rotated image on screen
+ * \param[in]       y: Top left Y position of rotated image on screen
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure with image description
+ * \param[in]       rotate: Image rotation
+ * \sa              gui_draw_image_blit
+ */
+void
+gui_draw_image_rotated(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, gui_image_rotate_t rotate) {
+    gui_image_blit_t b;
+
+    gui_draw_image_blit_init(&b);
+    b.rotate = rotate;
+    gui_draw_image_blit(disp, x, y, img, &b);
+}
+
 /**
  * \brief           Draw polygon lines
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
  * \param[in]       points: Pointer to array of \ref gui_draw_poly_t points to draw lines between
  * \param[in]       len: Number of points in array. There must be at least 2 points
  * \param[in]       color: Color to use for drawing 
+ * \sa              gui_draw_filledpoly
  */
 void
 gui_draw_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color) {
@@ -1171,26 +2771,85 @@ gui_draw_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t l
 }
 
 /**
- * \brief           Write text to screen
+ * \brief           Draw filled polygon
+ * \note            Polygon may be concave or self-intersecting, area is filled with even-odd rule.
+ *                  Points are pixel positions and on each line, pixels nearest to edges are filled too,
+ *                  so filled polygon covers the same lines and columns as \ref gui_draw_poly outline
  * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       points: Pointer to array of \ref gui_draw_poly_t points. Last point is connected to first one
+ * \param[in]       len: Number of points in array. There must be at least 2 points
+ * \param[in]       color: Color to use for drawing
+ * \sa              gui_draw_poly, gui_draw_filledtriangle
+ */
+void
+gui_draw_filledpoly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color) {
+    gui_poly_edge_t edges[POLY_STACK_POINTS], *e;
+    gui_dim_t buff[3 * POLY_STACK_POINTS];
+
+    if (len < 2) {
+        return;
+    }
+    if (len <= POLY_STACK_POINTS) {                 /* Small polygons do not need memory allocation */
+        fill_poly(disp, points, len, edges, buff, color);
+    } else if ((e = GUI_MEMALLOC(len * (sizeof(*e) + 3 * sizeof(gui_dim_t)))) != NULL) {
+        fill_poly(disp, points, len, e, (gui_dim_t *)&e[len], color);
+        GUI_MEMFREE(e);
+    }
+}
+
+#if GUI_CFG_USE_TEXT_CACHE
+
+/**
+ * \brief           Add character to text layout cache
+ * \param[in]       draw: Text drawing structure with valid cache pointer
+ * \param[in]       c: Character descriptor
+ * \param[in]       x: Absolute X position of character
+ * \param[in]       y: Absolute Y position of character
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+add_text_cache_glyph(gui_draw_text_t* draw, const gui_font_char_t* c, gui_dim_t x, gui_dim_t y) {
+    gui_draw_text_cache_t* cache = draw->cache;
+    gui_draw_text_glyph_t* g;
+    
+    if (cache->count == cache->size) {              /* Array is full, make it bigger */
+        size_t size = cache->size ? cache->size * 2 : 16;
+        
+        g = GUI_MEMREALLOC(cache->glyphs, size * sizeof(*g));
+        if (g == NULL) {
+            return 0;
+        }
+        cache->glyphs = g;
+        cache->size = size;
+    }
+    g = &cache->glyphs[cache->count++];
+    g->c = c;
+    g->x = x - draw->x;                             /* Save position relative to text rectangle */
+    g->y = y - draw->y;
+    return 1;
+}
+
+#endif /* GUI_CFG_USE_TEXT_CACHE */
+
+/**
+ * \brief           Process text layout and draw characters or save them to layout cache
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations.
+ *                      Set to `NULL` when saving characters to cache
  * \param[in]       font: Pointer to \ref gui_font_t structure with font to use
  * \param[in]       str: Pointer to string to draw on screen
  * \param[in]       draw: Pointer to \ref gui_draw_text_t structure with specifications about drawing style 
+ * \return          `1` on success, `0` otherwise
  */
-void
-gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw) {
+static uint8_t
+process_text(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw) {
     gui_dim_t x, y;
-    uint32_t ch;
+    uint32_t ch, prev;
     uint8_t i;
     size_t cnt;
     const gui_font_char_t* c;
     gui_stringrect_t rect = {0};                    /* Get string object */
     gui_string_t currStr;
     
-    if (!draw->lineheight) {                        /* When line height is not set */
-        draw->lineheight = font->size;              /* Set font size */
-    }
-    
     rect.Font = font;                               /* Save font structure */
     rect.StringDraw = draw;                         /* Set drawing pointer */
     rect.IsEditMode = (draw->flags & GUI_FLAG_TEXT_EDITMODE) == GUI_FLAG_TEXT_EDITMODE; /* Check if in edit mode */
@@ -1230,6 +2889,7 @@ gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_
     gui_string_prepare(&currStr, str);              /* Prepare string again */
     while ((cnt = string_rectangle(&rect, &currStr, 1)) > 0) {
         x = draw->x;                                       
+        prev = 0;                                   /* No kerning at line start */
         if ((draw->align & GUI_HALIGN_MASK) == GUI_HALIGN_CENTER) { /* Check for horizontal align center */
             x += (draw->width - rect.width) / 2;    /* Align center of drawing area */
         } else if ((draw->align & GUI_HALIGN_MASK) == GUI_HALIGN_RIGHT) {   /* Check for horizontal align right */
@@ -1241,23 +2901,139 @@ gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_
             }
             rect.ReadDraw--;                        /* Decrease number of drawn elements */
             
-            if (x > disp->x2) {                     /* Check if X over line */
+            ch = get_char_from_value(ch);           /* Get char from char value */
+            x += gui_text_getkerning(font, prev, ch);   /* Apply kerning for character pair */
+            prev = ch;
+            
+            if (disp != NULL && x > disp->x2) {     /* Check if X over line */
                 continue;
             }
             
-            ch = get_char_from_value(ch);           /* Get char from char value */
             if ((c = gui_text_getchardesc(font, ch)) == 0) {/* Get character pointer */
                 continue;                           /* Character is not known */
             }
-            draw_char(disp, font, draw, x, y, c);   /* Draw actual char */
+#if GUI_CFG_USE_TEXT_CACHE
+            if (disp == NULL) {                     /* Save character to cache */
+                if (!add_text_cache_glyph(draw, c, x, y)) {
+                    return 0;
+                }
+            } else
+#endif /* GUI_CFG_USE_TEXT_CACHE */
+            {
+                draw_char(disp, font, draw, x, y, c);   /* Draw actual char */
+            }
             
-            x += c->x_size + c->x_margin;           /* Increase X position */
+            x += c->x_pos + c->x_size + c->x_margin;/* Increase X position */
         }
         y += draw->lineheight;                      /* Go to next line */
-        if (!(draw->flags & GUI_FLAG_TEXT_MULTILINE) || y > disp->y2) { /* Not multiline or over visible Y area */
+        if (!(draw->flags & GUI_FLAG_TEXT_MULTILINE) || (disp != NULL && y > disp->y2)) {   /* Not multiline or over visible Y area */
             break;
         }
     }
+    return 1;
+}
+
+
+#if GUI_CFG_USE_TEXT_CACHE
+
+/**
+ * \brief           Check if text layout cache is valid for text and drawing parameters
+ * \param[in]       font: Font used for drawing
+ * \param[in]       str: Pointer to string to draw
+ * \param[in]       draw: Text drawing structure with valid cache pointer
+ * \return          `1` if cache can be used, `0` otherwise
+ */
+static uint8_t
+is_text_cache_valid(const gui_font_t* font, const gui_char* str, const gui_draw_text_t* draw) {
+    const gui_draw_text_cache_t* cache = draw->cache;
+    
+    return cache->valid && cache->str == str && cache->font == font
+        && cache->width == draw->width && cache->height == draw->height
+        && cache->lineheight == draw->lineheight && cache->scrolly == draw->scrolly
+        && cache->align == draw->align && cache->flags == draw->flags;
+}
+
+/**
+ * \brief           Process text layout and save it to cache
+ * \param[in]       font: Font used for drawing
+ * \param[in]       str: Pointer to string to draw
+ * \param[in]       draw: Text drawing structure with valid cache pointer
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+build_text_cache(const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw) {
+    gui_draw_text_cache_t* cache = draw->cache;
+    
+    cache->valid = 0;
+    cache->count = 0;
+    if (!process_text(NULL, font, str, draw)) {     /* Save characters to cache */
+        return 0;
+    }
+    cache->str = str;
+    cache->font = font;
+    cache->width = draw->width;
+    cache->height = draw->height;
+    cache->lineheight = draw->lineheight;
+    cache->scrolly = draw->scrolly;
+    cache->align = draw->align;
+    cache->flags = draw->flags;
+    cache->valid = 1;
+    return 1;
+}
+
+#endif /* GUI_CFG_USE_TEXT_CACHE */
+
+/**
+ * \brief           Free memory used by text layout cache
+ * \note            Cache structure itself is not freed
+ * \param[in]       cache: Pointer to text layout cache
+ */
+void
+gui_draw_text_cachefree(gui_draw_text_cache_t* cache) {
+    if (cache->glyphs != NULL) {
+        GUI_MEMFREE(cache->glyphs);
+    }
+    cache->valid = 0;
+    cache->count = 0;
+    cache->size = 0;
+}
+
+/**
+ * \brief           Write text to screen
+ * \note            When layout cache is set in drawing structure,
+ *                  unchanged text is drawn directly from cache
+ * \param[in,out]   disp: Pointer to \ref gui_display_t structure for display operations
+ * \param[in]       font: Pointer to \ref gui_font_t structure with font to use
+ * \param[in]       str: Pointer to string to draw on screen
+ * \param[in]       draw: Pointer to \ref gui_draw_text_t structure with specifications about drawing style 
+ */
+void
+gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw) {
+    if (!draw->lineheight) {                        /* When line height is not set */
+        draw->lineheight = font->size;              /* Set font size */
+    }
+    
+#if GUI_CFG_USE_TEXT_CACHE
+    if (draw->cache != NULL) {                      /* Layout cache is available */
+        if (is_text_cache_valid(font, str, draw) || build_text_cache(font, str, draw)) {
+            const gui_draw_text_glyph_t* g;
+            size_t i;
+            
+            for (i = 0, g = draw->cache->glyphs; i < draw->cache->count; i++, g++) {
+                if (draw->y + g->y > disp->y2) {    /* Lines are in order, stop on first below visible area */
+                    break;
+                }
+                if (draw->x + g->x > disp->x2) {    /* Check if X over line */
+                    continue;
+                }
+                draw_char(disp, font, draw, draw->x + g->x, draw->y + g->y, g->c);
+            }
+            return;
+        }
+        gui_draw_text_cachefree(draw->cache);       /* Not enough memory, process text directly */
+    }
+#endif /* GUI_CFG_USE_TEXT_CACHE */
+    process_text(disp, font, str, draw);
 }
 
 /**
@@ -313,6 +313,7 @@ keyboard_btn_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
         case GUI_EVT_DRAW: {                        /* Draw button */
             gui_char str[10] = {0};
             const key_btn_t* kbtn;
+            uint8_t ignore;
             
             kbtn = (const key_btn_t *)gui_widget_getuserdata(h);/* Get user data */
             
@@ -346,7 +347,9 @@ keyboard_btn_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                     }
                     break;
             }
-                                                
+
+            ignore = guii_widget_getflag(h, GUI_FLAG_IGNORE_INVALIDATE) ? 1 : 0;  /* Save current state */
+            gui_widget_setignoreinvalidate(h, 1, 0);    /* Font and text changes must not trigger new redraw */
             if (keyboard.font != NULL) {            /* Check if widget font is set */
                 gui_widget_setfont(h, keyboard.font);   /* Set drawing font */
             } else {
@@ -354,6 +357,7 @@ keyboard_btn_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
             }
             
             gui_widget_settext(h, str);             /* Temporary set text */
+            gui_widget_setignoreinvalidate(h, ignore, 0);   /* Restore previous state */
             gui_widget_processdefaultcallback(h, evt, param, result);  /* Process default callback with drawing */
             return 1;
         }
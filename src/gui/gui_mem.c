@@ -34,11 +34,6 @@
 #include "gui/gui.h"
 #include "gui/gui_mem.h"
 
-typedef struct MemBlock {
-    struct MemBlock* NextFreeBlock;                 /*!< Pointer to next free block */
-    size_t Size;                                    /*!< Size of block */
-} MemBlock_t;
-
 /**
  * \brief           Memory alignment bits and absolute number
  */
@@ -46,15 +41,33 @@ typedef struct MemBlock {
 #define MEM_ALIGN_NUM               ((size_t)GUI_CFG_MEM_ALIGNMENT)
 #define MEM_ALIGN(x)                GUI_MEM_ALIGN(x)
 
+/**
+ * \brief           Region header, placed at the beginning of every assigned region
+ */
+typedef struct MemRegion {
+    struct MemRegion* Next;                         /*!< Pointer to next region */
+    uint8_t* End;                                   /*!< First address after last block in region */
+} MemRegion_t;
+
+static MemRegion_t* Regions = 0;                    /* List of assigned regions, in rising address order */
+static size_t MemAvailableBytes = 0;
+static size_t MemMinAvailableBytes = 0;
+static size_t MemTotalSize = 0;                     /* Size of memory in units of bytes */
+
+#if !GUI_CFG_MEM_USE_TLSF
+
+typedef struct MemBlock {
+    struct MemBlock* NextFreeBlock;                 /*!< Pointer to next free block */
+    size_t Size;                                    /*!< Size of block */
+} MemBlock_t;
+
 #define MEMBLOCK_METASIZE           MEM_ALIGN(sizeof(MemBlock_t))
+#define MEMREGION_METASIZE          MEM_ALIGN(sizeof(MemRegion_t))
 
 static MemBlock_t StartBlock;
 static MemBlock_t* EndBlock = 0;
-static size_t MemAvailableBytes = 0;
-static size_t MemMinAvailableBytes = 0;
 static size_t MemAllocBit = 0;
 
-static size_t MemTotalSize = 0;                     /* Size of memory in units of bytes */
 /* Insert block to list of free blocks */
 static void
 mem_insertfreeblock(MemBlock_t* newBlock) {
@@ -100,103 +113,91 @@ mem_insertfreeblock(MemBlock_t* newBlock) {
     }
 }
 
-uint8_t
-mem_assignmem(const mem_region_t* regions, size_t len) {
-    uint8_t* MemStartAddr;
-    size_t MemSize;
+/* Add new region to free chain, called in rising address order */
+static MemRegion_t*
+mem_addregion(uint8_t* MemStartAddr, size_t MemSize) {
+    MemRegion_t* region;
     MemBlock_t* FirstBlock;
-    MemBlock_t* PreviousEndBlock = 0;
-    size_t i;
-    
-    if (EndBlock != NULL) {                         /* Regions already defined */
-        return 0;
+    MemBlock_t* PreviousEndBlock;
+
+    /* Check minimum region size */
+    if (MemSize < (MEM_ALIGN_NUM + MEMBLOCK_METASIZE + MEMREGION_METASIZE)) {
+        return NULL;
+    }
+
+    /*
+     * Get start address and check memory alignment
+     * if necessary, decrease memory region size
+     */
+    if ((size_t)MemStartAddr & MEM_ALIGN_BITS) {    /* Check alignment boundary */
+        MemSize -= MEM_ALIGN_NUM - ((size_t)MemStartAddr & MEM_ALIGN_BITS);
+        MemStartAddr += MEM_ALIGN_NUM - ((size_t)MemStartAddr & MEM_ALIGN_BITS);
     }
     
-    /* Check if region address are linear and rising */
-    MemStartAddr = (uint8_t *)0;
-    for (i = 0; i < len; i++) {
-        if (MemStartAddr >= (uint8_t *)regions[i].start_address) {  /* Check if previous greater than current */
-            return 0;                               /* Return as invalid and failed */
-        }
-        MemStartAddr = (uint8_t *)regions[i].start_address; /* Save as previous address */
+    /* Check memory size alignment if match */
+    if (MemSize & MEM_ALIGN_BITS) {
+        MemSize &= ~MEM_ALIGN_BITS;                 /* Clear lower bits of memory size only */
+    }
+    if (MemSize < (MEM_ALIGN_NUM + MEMBLOCK_METASIZE + MEMREGION_METASIZE)) {
+        return NULL;
     }
 
-    while (len--) {
-        /* Check minimum region size */
-        MemSize = regions->size;
-        if (MemSize < (MEM_ALIGN_NUM + MEMBLOCK_METASIZE)) {
-            regions++;
-            continue;
-        }
-        /*
-         * Get start address and check memory alignment
-         * if necessary, decrease memory region size
-         */
-        MemStartAddr = (uint8_t *)regions->start_address;   /* Actual heap memory address */
-        if ((size_t)MemStartAddr & MEM_ALIGN_BITS) {    /* Check alignment boundary */
-            MemStartAddr += MEM_ALIGN_NUM - ((size_t)MemStartAddr & MEM_ALIGN_BITS);
-            MemSize -= MemStartAddr - (uint8_t *)regions->start_address;
-        }
-        
-        /* Check memory size alignment if match */
-        if (MemSize & MEM_ALIGN_BITS) {
-            MemSize &= ~MEM_ALIGN_BITS;             /* Clear lower bits of memory size only */
-        }
+    /* Region header takes first bytes of region */
+    region = (MemRegion_t *)MemStartAddr;
+    MemStartAddr += MEMREGION_METASIZE;
+    MemSize -= MEMREGION_METASIZE;
 
-        /*
-         * StartBlock is fixed variable for start list of free blocks
-         *
-         * Set free blocks linked list on initialized
-         *
-         * Set Start block only if end block is not yet defined = first run
-         */
-        if (!EndBlock) {
-            StartBlock.NextFreeBlock = (MemBlock_t *)MemStartAddr;
-            StartBlock.Size = 0;
-        }
-        
-        PreviousEndBlock = EndBlock;                /* Save previous end block to set next block later */
-        
-        /*
-         * Set pointer to end of free memory - block region memory
-         * Calculate new end block in region
-         */
-        EndBlock = (MemBlock_t *)((uint8_t *)MemStartAddr + MemSize - MEMBLOCK_METASIZE);
-        EndBlock->NextFreeBlock = 0;                /* No more free blocks after end is reached */
-        EndBlock->Size = 0;                         /* Empty block */
+    /*
+     * StartBlock is fixed variable for start list of free blocks
+     *
+     * Set free blocks linked list on initialized
+     *
+     * Set Start block only if end block is not yet defined = first run
+     */
+    if (!EndBlock) {
+        StartBlock.NextFreeBlock = (MemBlock_t *)MemStartAddr;
+        StartBlock.Size = 0;
+    }
+    
+    PreviousEndBlock = EndBlock;                    /* Save previous end block to set next block later */
+    
+    /*
+     * Set pointer to end of free memory - block region memory
+     * Calculate new end block in region
+     */
+    EndBlock = (MemBlock_t *)((uint8_t *)MemStartAddr + MemSize - MEMBLOCK_METASIZE);
+    EndBlock->NextFreeBlock = 0;                    /* No more free blocks after end is reached */
+    EndBlock->Size = 0;                             /* Empty block */
 
-        /*
-         * Initialize start of region memory
-         * Create first block in region
-         */
-        FirstBlock = (MemBlock_t *)MemStartAddr;
-        FirstBlock->Size = MemSize - MEMBLOCK_METASIZE; /* Exclude end block in chain */
-        FirstBlock->NextFreeBlock = EndBlock;       /* Last block is next free in chain */
+    /*
+     * Initialize start of region memory
+     * Create first block in region
+     */
+    FirstBlock = (MemBlock_t *)MemStartAddr;
+    FirstBlock->Size = MemSize - MEMBLOCK_METASIZE; /* Exclude end block in chain */
+    FirstBlock->NextFreeBlock = EndBlock;           /* Last block is next free in chain */
 
-        /*
-         * If we have previous end block
-         * End block of previous region
-         *
-         * Set previous end block to start of next region
-         */
-        if (PreviousEndBlock) {
-            PreviousEndBlock->NextFreeBlock = FirstBlock;
-        }
-        
-        /* Set number of free bytes available to allocate in region */
-        MemAvailableBytes += FirstBlock->Size;
-        
-        regions++;                                  /* Go to next region */
+    /*
+     * If we have previous end block
+     * End block of previous region
+     *
+     * Set previous end block to start of next region
+     */
+    if (PreviousEndBlock) {
+        PreviousEndBlock->NextFreeBlock = FirstBlock;
     }
     
-    MemMinAvailableBytes = MemAvailableBytes;       /* Save minimum ever available bytes in region */
+    /* Set number of free bytes available to allocate in region */
+    MemAvailableBytes += FirstBlock->Size;
     
     /*
      * Set upper bit in memory allocation bit
      */
     MemAllocBit = (size_t)((size_t)1 << ((sizeof(size_t) * 8 - 1)));
-    
-    return 1;                                       /* Regions set as expected */
+
+    region->Next = NULL;
+    region->End = MemStartAddr + MemSize;
+    return region;
 }
 
 static void*
@@ -260,7 +261,7 @@ mem_alloc(size_t size) {
         Curr->Size |= MemAllocBit;                  /* Set allocated bit = memory is allocated */
         Curr->NextFreeBlock = 0;                    /* Clear next free block pointer as there is no one */
 
-        MemAvailableBytes -= size;                  /* Decrease available memory */
+        MemAvailableBytes -= Curr->Size & ~MemAllocBit; /* Decrease available memory */
         if (MemAvailableBytes < MemMinAvailableBytes) { /* Check if current available memory is less than ever before */
             MemMinAvailableBytes = MemAvailableBytes;   /* Update minimal available memory */
         }
@@ -311,6 +312,411 @@ mem_getusersize(void* ptr) {
     return 0;
 }
 
+/* Walk all physical blocks of region and add them to statistics */
+static void
+mem_walkregion(const MemRegion_t* region, gui_mem_stats_t* stats, size_t* largest) {
+    MemBlock_t* block;
+    size_t size;
+
+    block = (MemBlock_t *)((uint8_t *)region + MEMREGION_METASIZE);
+    while ((uint8_t *)block < region->End) {
+        size = block->Size & ~MemAllocBit;
+        if (!size) {                                /* End block of region */
+            block = (MemBlock_t *)((uint8_t *)block + MEMBLOCK_METASIZE);
+            continue;
+        }
+        stats->total += size;
+        if (block->Size & MemAllocBit) {
+            stats->used_blocks++;
+        } else {
+            stats->free += size;
+            stats->free_blocks++;
+            if (size > *largest) {
+                *largest = size;
+            }
+        }
+        block = (MemBlock_t *)((uint8_t *)block + size);
+    }
+}
+
+#define MEM_BLOCK_METASIZE          MEMBLOCK_METASIZE
+
+#else /* !GUI_CFG_MEM_USE_TLSF */
+
+/*
+ * Two-level segregated fit allocator
+ *
+ * Free blocks are kept in lists, indexed by first level (power of 2 of block size)
+ * and second level (linear subdivision of first level range to TLSF_SL_COUNT parts).
+ * Bitmaps of non-empty lists allow to find suitable free block in constant time,
+ * physical neighbours are merged on free using previous physical block pointer.
+ */
+
+typedef struct TlsfBlock {
+    struct TlsfBlock* PrevPhys;                     /*!< Pointer to previous physical block, `NULL` for first block in pool */
+    size_t Size;                                    /*!< Size of block including header, lowest bit is set when block is free */
+    struct TlsfBlock* NextFree;                     /*!< Pointer to next free block in list, valid only for free block */
+    struct TlsfBlock* PrevFree;                     /*!< Pointer to previous free block in list, valid only for free block */
+} TlsfBlock_t;
+
+#define TLSF_ALIGN_NUM              (MEM_ALIGN_NUM > sizeof(void *) ? MEM_ALIGN_NUM : sizeof(void *))
+#define TLSF_ALIGN(x)               (((x) + TLSF_ALIGN_NUM - 1) & ~(TLSF_ALIGN_NUM - 1))
+
+#define TLSF_SL_BITS                4
+#define TLSF_SL_COUNT               (1 << TLSF_SL_BITS)
+#define TLSF_FL_COUNT               20
+#define TLSF_SMALL_SIZE             (TLSF_SL_COUNT * TLSF_ALIGN_NUM)
+
+#define TLSF_FREE_BIT               ((size_t)0x01)
+#define TLSF_METASIZE               TLSF_ALIGN(sizeof(void *) + sizeof(size_t))
+#define TLSF_BLOCK_MIN              TLSF_ALIGN(sizeof(TlsfBlock_t))
+#define TLSF_BLOCK_MAX              (((size_t)TLSF_SMALL_SIZE << (TLSF_FL_COUNT - 1)) - TLSF_ALIGN_NUM)
+#define MEMREGION_METASIZE          TLSF_ALIGN(sizeof(MemRegion_t))
+
+#define TLSF_SIZE(b)                ((b)->Size & ~TLSF_FREE_BIT)
+#define TLSF_NEXT(b)                ((TlsfBlock_t *)((uint8_t *)(b) + TLSF_SIZE(b)))
+
+static size_t TlsfFlBitmap;                         /* Bit is set when any list on first level is not empty */
+static uint32_t TlsfSlBitmap[TLSF_FL_COUNT];        /* Bit is set when second level list is not empty */
+static TlsfBlock_t* TlsfBlocks[TLSF_FL_COUNT][TLSF_SL_COUNT];   /* Heads of free lists */
+
+/* Get position of most significant set bit, value must not be 0 */
+static uint8_t
+tlsf_fls(size_t x) {
+    uint8_t n = 0, s;
+
+    for (s = sizeof(size_t) * 4; s > 0; s >>= 1) {
+        if (x >> s) {
+            x >>= s;
+            n += s;
+        }
+    }
+    return n;
+}
+
+/* Get position of least significant set bit, value must not be 0 */
+static uint8_t
+tlsf_ffs(size_t x) {
+    return tlsf_fls(x & (~x + 1));
+}
+
+/* Get first and second level indexes for block size */
+static void
+tlsf_mapping(size_t size, uint8_t* fl, uint8_t* sl) {
+    uint8_t bit;
+
+    if (size < TLSF_SMALL_SIZE) {                   /* Small blocks are linear on first level */
+        *fl = 0;
+        *sl = (uint8_t)(size / TLSF_ALIGN_NUM);
+    } else {
+        bit = tlsf_fls(size);
+        *fl = (uint8_t)(bit - tlsf_fls(TLSF_SMALL_SIZE) + 1);
+        *sl = (uint8_t)((size >> (bit - TLSF_SL_BITS)) ^ TLSF_SL_COUNT);
+    }
+}
+
+/* Insert block to free list and mark it as free */
+static void
+tlsf_insert(TlsfBlock_t* block) {
+    uint8_t fl, sl;
+
+    tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+    block->NextFree = TlsfBlocks[fl][sl];
+    block->PrevFree = NULL;
+    if (block->NextFree != NULL) {
+        block->NextFree->PrevFree = block;
+    }
+    TlsfBlocks[fl][sl] = block;
+    TlsfFlBitmap |= (size_t)1 << fl;
+    TlsfSlBitmap[fl] |= (uint32_t)1 << sl;
+    block->Size |= TLSF_FREE_BIT;
+}
+
+/* Remove block from free list and mark it as used */
+static void
+tlsf_remove(TlsfBlock_t* block) {
+    uint8_t fl, sl;
+
+    tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+    if (block->NextFree != NULL) {
+        block->NextFree->PrevFree = block->PrevFree;
+    }
+    if (block->PrevFree != NULL) {
+        block->PrevFree->NextFree = block->NextFree;
+    } else {
+        TlsfBlocks[fl][sl] = block->NextFree;
+        if (block->NextFree == NULL) {              /* List is now empty */
+            TlsfSlBitmap[fl] &= ~((uint32_t)1 << sl);
+            if (!TlsfSlBitmap[fl]) {
+                TlsfFlBitmap &= ~((size_t)1 << fl);
+            }
+        }
+    }
+    block->Size &= ~TLSF_FREE_BIT;
+}
+
+/* Find free block with at least size bytes, without searching in lists */
+static TlsfBlock_t*
+tlsf_findblock(size_t size) {
+    size_t fl_map;
+    uint32_t sl_map;
+    uint8_t fl, sl;
+
+    /*
+     * Round size up to next list size,
+     * so any block in found list is big enough
+     */
+    if (size >= TLSF_SMALL_SIZE) {
+        size += ((size_t)1 << (tlsf_fls(size) - TLSF_SL_BITS)) - 1;
+    }
+    tlsf_mapping(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    sl_map = TlsfSlBitmap[fl] & (~(uint32_t)0 << sl);   /* Lists with bigger blocks on same first level */
+    if (!sl_map) {
+        fl_map = TlsfFlBitmap & (~(size_t)0 << (fl + 1));   /* Any bigger first level */
+        if (!fl_map) {
+            return NULL;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = TlsfSlBitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+    return TlsfBlocks[fl][sl];
+}
+
+/* Add new region as one or more pools */
+static MemRegion_t*
+mem_addregion(uint8_t* MemStartAddr, size_t MemSize) {
+    MemRegion_t* region;
+    TlsfBlock_t *block, *end;
+    size_t size;
+
+    /* Align start address and size of region */
+    if ((size_t)MemStartAddr & (TLSF_ALIGN_NUM - 1)) {
+        size = TLSF_ALIGN_NUM - ((size_t)MemStartAddr & (TLSF_ALIGN_NUM - 1));
+        if (MemSize <= size) {
+            return NULL;
+        }
+        MemStartAddr += size;
+        MemSize -= size;
+    }
+    MemSize &= ~(TLSF_ALIGN_NUM - 1);
+    if (MemSize < (MEMREGION_METASIZE + TLSF_BLOCK_MIN + TLSF_METASIZE)) {
+        return NULL;
+    }
+
+    /* Region header takes first bytes of region */
+    region = (MemRegion_t *)MemStartAddr;
+    MemStartAddr += MEMREGION_METASIZE;
+    MemSize -= MEMREGION_METASIZE;
+
+    /*
+     * Each pool is one free block followed by end block of size 0,
+     * which is never free and prevents merging outside pool.
+     *
+     * Region bigger than maximal block size is split to multiple pools
+     */
+    while (MemSize >= (TLSF_BLOCK_MIN + TLSF_METASIZE)) {
+        size = MemSize - TLSF_METASIZE;
+        if (size > TLSF_BLOCK_MAX) {
+            size = TLSF_BLOCK_MAX;
+        }
+        block = (TlsfBlock_t *)MemStartAddr;
+        block->PrevPhys = NULL;
+        block->Size = size;
+        end = TLSF_NEXT(block);
+        end->PrevPhys = block;
+        end->Size = 0;
+        tlsf_insert(block);
+
+        MemAvailableBytes += size;
+        MemStartAddr += size + TLSF_METASIZE;
+        MemSize -= size + TLSF_METASIZE;
+    }
+
+    region->Next = NULL;
+    region->End = MemStartAddr;
+    return region;
+}
+
+static void*
+mem_alloc(size_t size) {
+    TlsfBlock_t *block, *next;
+
+    if (!size || size > (TLSF_BLOCK_MAX - TLSF_METASIZE)) {
+        return 0;
+    }
+    size = TLSF_ALIGN(size) + TLSF_METASIZE;
+    if (size < TLSF_BLOCK_MIN) {
+        size = TLSF_BLOCK_MIN;
+    }
+
+    block = tlsf_findblock(size);
+    if (block == NULL) {                            /* No free block of required size */
+        return 0;
+    }
+    tlsf_remove(block);
+
+    /* Split block when remaining part is big enough for new free block */
+    if ((block->Size - size) >= TLSF_BLOCK_MIN) {
+        next = (TlsfBlock_t *)((uint8_t *)block + size);
+        next->PrevPhys = block;
+        next->Size = block->Size - size;
+        TLSF_NEXT(next)->PrevPhys = next;
+        block->Size = size;
+        tlsf_insert(next);
+    }
+
+    MemAvailableBytes -= block->Size;               /* Decrease available memory */
+    if (MemAvailableBytes < MemMinAvailableBytes) { /* Check if current available memory is less than ever before */
+        MemMinAvailableBytes = MemAvailableBytes;   /* Update minimal available memory */
+    }
+    return (void *)((uint8_t *)block + TLSF_METASIZE);
+}
+
+static void
+mem_free(void* ptr) {
+    TlsfBlock_t *block, *prev, *next;
+
+    if (ptr == NULL) {                              /* To be in compliance with C free function */
+        return;
+    }
+
+    block = (TlsfBlock_t *)(((uint8_t *)ptr) - TLSF_METASIZE);
+    if ((block->Size & TLSF_FREE_BIT) || !block->Size) {    /* Block is not allocated */
+        return;
+    }
+    MemAvailableBytes += block->Size;               /* Increase available bytes back */
+
+    /* Merge with free physical neighbours */
+    prev = block->PrevPhys;
+    if (prev != NULL && (prev->Size & TLSF_FREE_BIT)) {
+        tlsf_remove(prev);
+        prev->Size += block->Size;
+        block = prev;
+    }
+    next = TLSF_NEXT(block);
+    if (next->Size & TLSF_FREE_BIT) {
+        tlsf_remove(next);
+        block->Size += next->Size;
+    }
+    TLSF_NEXT(block)->PrevPhys = block;
+    tlsf_insert(block);
+}
+
+/* Get size of user memory from input pointer */
+static size_t
+mem_getusersize(void* ptr) {
+    TlsfBlock_t* block;
+
+    if (ptr == NULL) {
+        return 0;
+    }
+    block = (TlsfBlock_t *)(((uint8_t *)ptr) - TLSF_METASIZE);
+    if (block->Size & TLSF_FREE_BIT) {
+        return 0;
+    }
+    return block->Size - TLSF_METASIZE;
+}
+
+/* Walk all physical blocks of region and add them to statistics */
+static void
+mem_walkregion(const MemRegion_t* region, gui_mem_stats_t* stats, size_t* largest) {
+    TlsfBlock_t* block;
+    size_t size;
+
+    block = (TlsfBlock_t *)((uint8_t *)region + MEMREGION_METASIZE);
+    while ((uint8_t *)block < region->End) {
+        size = TLSF_SIZE(block);
+        if (!size) {                                /* End block of pool */
+            block = (TlsfBlock_t *)((uint8_t *)block + TLSF_METASIZE);
+            continue;
+        }
+        stats->total += size;
+        if (block->Size & TLSF_FREE_BIT) {
+            stats->free += size;
+            stats->free_blocks++;
+            if (size > *largest) {
+                *largest = size;
+            }
+        } else {
+            stats->used_blocks++;
+        }
+        block = TLSF_NEXT(block);
+    }
+}
+
+#define MEM_BLOCK_METASIZE          TLSF_METASIZE
+
+#endif /* GUI_CFG_MEM_USE_TLSF */
+
+uint8_t
+mem_assignmem(const mem_region_t* regions, size_t len) {
+    MemRegion_t *region, *last = NULL;
+    uint8_t* MemStartAddr;
+    size_t i;
+
+    if (Regions != NULL) {                          /* Regions already defined */
+        return 0;
+    }
+
+    /* Check if region address are linear and rising */
+    MemStartAddr = (uint8_t *)0;
+    for (i = 0; i < len; i++) {
+        if (MemStartAddr >= (uint8_t *)regions[i].start_address) {  /* Check if previous greater than current */
+            return 0;                               /* Return as invalid and failed */
+        }
+        MemStartAddr = (uint8_t *)regions[i].start_address; /* Save as previous address */
+    }
+
+    for (i = 0; i < len; i++) {
+        region = mem_addregion((uint8_t *)regions[i].start_address, regions[i].size);
+        if (region != NULL) {                       /* Region is big enough to be used */
+            if (last != NULL) {
+                last->Next = region;
+            } else {
+                Regions = region;
+            }
+            last = region;
+        }
+    }
+
+    MemTotalSize = MemAvailableBytes;               /* Save total size of memory */
+    MemMinAvailableBytes = MemAvailableBytes;       /* Save minimum ever available bytes in region */
+
+    return 1;                                       /* Regions set as expected */
+}
+
+/* Calculate statistics for one region or all regions when region is NULL */
+static uint8_t
+mem_getstats(const MemRegion_t* region, gui_mem_stats_t* stats) {
+    size_t largest = 0;
+
+    memset(stats, 0x00, sizeof(*stats));
+    if (region == NULL && Regions == NULL) {
+        return 0;
+    }
+    if (region != NULL) {
+        mem_walkregion(region, stats, &largest);
+    } else {
+        for (region = Regions; region != NULL; region = region->Next) {
+            mem_walkregion(region, stats, &largest);
+        }
+        stats->min_free = MemMinAvailableBytes;
+    }
+
+    if (largest) {
+        stats->largest_free = largest - MEM_BLOCK_METASIZE; /* Maximal single allocation */
+    }
+    if (stats->free) {
+        stats->fragmentation = (uint8_t)(100 - (uint8_t)((uint64_t)largest * 100 / stats->free));
+    }
+    return 1;
+}
+
 /* Allocate memory and set it to 0 */
 static void*
 mem_calloc(size_t num, size_t size) {
@@ -361,7 +767,8 @@ mem_getminfree(void) {
 /**
  * \brief           Allocate memory of specific size
  * \note            This function is private and may be called only when OS protection is active
- * \param[in]       size: Number of bytes to allocate * \return          Allocated memory on success, `NULL` otherwise
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Allocated memory on success, `NULL` otherwise
  */
 void*
 gui_mem_alloc(uint32_t size) {
@@ -380,7 +787,8 @@ gui_mem_alloc(uint32_t size) {
  * \brief           Allocate memory of specific size
  * \note            After new memory is allocated, content of old one is copied to new memory
  * \param[in]       ptr: Pointer to current allocated memory to resize, returned using \ref gui_mem_alloc, \ref gui_mem_calloc or \ref gui_mem_realloc functions
- * \param[in]       size: Number of bytes to allocate on new memory * \return          Allocated memory on success, `NULL` otherwise
+ * \param[in]       size: Number of bytes to allocate on new memory
+ * \return          Allocated memory on success, `NULL` otherwise
  */
 void*
 gui_mem_realloc(void* ptr, size_t size) {
@@ -453,6 +861,43 @@ gui_mem_getminfree(void) {
     return mem_getminfree();                        /* Get minimal number of bytes ever available for allocation */
 }
 
+/**
+ * \brief           Get statistics of all memory regions
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[out]      stats: Pointer to structure to fill statistics to
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_mem_getstats(gui_mem_stats_t* stats) {
+    if (stats == NULL) {
+        return 0;
+    }
+    return mem_getstats(NULL, stats);               /* Get statistics of all regions */
+}
+
+/**
+ * \brief           Get statistics of single memory region
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       region: Region index, in order of regions used in \ref gui_mem_assignmemory function.
+ *                      Regions too small to be used are skipped
+ * \param[out]      stats: Pointer to structure to fill statistics to
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_mem_getregionstats(size_t region, gui_mem_stats_t* stats) {
+    MemRegion_t* r;
+
+    if (stats == NULL) {
+        return 0;
+    }
+    for (r = Regions; r != NULL && region > 0; r = r->Next, region--);
+    if (r == NULL) {                                /* Region does not exist */
+        memset(stats, 0x00, sizeof(*stats));
+        return 0;
+    }
+    return mem_getstats(r, stats);                  /* Get statistics of single region */
+}
+
 /**
  * \brief           Assign memory region(s) for allocation functions
  * \note            You can allocate multiple regions by assigning start address and region size in units of bytes
@@ -0,0 +1,398 @@
+/**	
+ * \file            gui_profiler.c
+ * \brief           Frame profiler
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#define GUI_INTERNAL
+#include "gui/gui_private.h"
+#include "gui/gui_profiler.h"
+#include "system/gui_sys.h"
+#include <stdio.h>
+
+#if GUI_CFG_USE_PROFILER || __DOXYGEN__
+
+#define PROFILER_DEPTH                  8   /*!< Maximal nesting level of recorded events */
+
+/**
+ * \brief           Started event waiting for end
+ */
+typedef struct {
+    uint32_t start;                                 /*!< Start time */
+    uint32_t ll_calls;                              /*!< Low-level calls counter at start */
+    uint32_t written;                               /*!< Written events counter at start */
+} profiler_frame_t;
+
+/**
+ * \brief           Profiler structure
+ */
+typedef struct {
+    gui_profiler_event_t events[GUI_CFG_PROFILER_EVENTS];   /*!< Ring buffer of events */
+    size_t r;                                       /*!< Index of oldest event */
+    size_t count;                                   /*!< Number of events in buffer */
+    uint32_t written;                               /*!< Number of written events since reset */
+    uint32_t dropped;                               /*!< Number of overwritten events since reset */
+    profiler_frame_t stack[PROFILER_DEPTH];         /*!< Started events */
+    uint8_t depth;                                  /*!< Number of started events */
+    uint8_t disabled;                               /*!< Set to `1` when recording is disabled */
+    uint32_t ll_calls;                              /*!< Number of low-level driver calls */
+    gui_ll_t ll;                                    /*!< Original low-level driver functions */
+} profiler_t;
+
+static profiler_t profiler;
+
+/* Low-level functions counting calls, then calling driver functions */
+static void
+ll_setpixel(gui_lcd_t* lcd, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.SetPixel(lcd, layer, x, y, color);
+}
+
+static gui_color_t
+ll_getpixel(gui_lcd_t* lcd, gui_layer_t* layer, gui_dim_t x, gui_dim_t y) {
+    profiler.ll_calls++;
+    return profiler.ll.GetPixel(lcd, layer, x, y);
+}
+
+static void
+ll_fill(gui_lcd_t* lcd, gui_layer_t* layer, void* dst, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLine, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.Fill(lcd, layer, dst, xSize, ySize, offLine, color);
+}
+
+static void
+ll_copy(gui_lcd_t* lcd, gui_layer_t* layer, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    profiler.ll_calls++;
+    profiler.ll.Copy(lcd, layer, dst, src, xSize, ySize, offLineDst, offLineSrc);
+}
+
+static void
+ll_copyblend(gui_lcd_t* lcd, gui_layer_t* layer, void* dst, const void* src, uint8_t alphaSrc, uint8_t alphaDst, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    profiler.ll_calls++;
+    profiler.ll.CopyBlend(lcd, layer, dst, src, alphaSrc, alphaDst, xSize, ySize, offLineDst, offLineSrc);
+}
+
+static void
+ll_drawhline(gui_lcd_t* lcd, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.DrawHLine(lcd, layer, x, y, length, color);
+}
+
+static void
+ll_drawvline(gui_lcd_t* lcd, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.DrawVLine(lcd, layer, x, y, length, color);
+}
+
+static void
+ll_fillrect(gui_lcd_t* lcd, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.FillRect(lcd, layer, x, y, width, height, color);
+}
+
+static void
+ll_drawimage16(gui_lcd_t* lcd, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    profiler.ll_calls++;
+    profiler.ll.DrawImage16(lcd, layer, img, dst, src, xSize, ySize, offLineDst, offLineSrc);
+}
+
+static void
+ll_drawimage24(gui_lcd_t* lcd, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    profiler.ll_calls++;
+    profiler.ll.DrawImage24(lcd, layer, img, dst, src, xSize, ySize, offLineDst, offLineSrc);
+}
+
+static void
+ll_drawimage32(gui_lcd_t* lcd, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    profiler.ll_calls++;
+    profiler.ll.DrawImage32(lcd, layer, img, dst, src, xSize, ySize, offLineDst, offLineSrc);
+}
+
+static void
+ll_copychar(gui_lcd_t* lcd, gui_layer_t* layer, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc, gui_color_t color) {
+    profiler.ll_calls++;
+    profiler.ll.CopyChar(lcd, layer, dst, src, xSize, ySize, offLineDst, offLineSrc, color);
+}
+
+static uint8_t
+ll_drawimagescaled(gui_lcd_t* lcd, gui_layer_t* layer, const gui_image_desc_t* img, const gui_image_blit_t* b, const gui_display_t* disp, gui_dim_t x, gui_dim_t y) {
+    profiler.ll_calls++;
+    return profiler.ll.DrawImageScaled(lcd, layer, img, b, disp, x, y);
+}
+
+static uint8_t
+ll_drawimagerotated(gui_lcd_t* lcd, gui_layer_t* layer, const gui_image_desc_t* img, const gui_image_blit_t* b, const gui_display_t* disp, gui_dim_t x, gui_dim_t y) {
+    profiler.ll_calls++;
+    return profiler.ll.DrawImageRotated(lcd, layer, img, b, disp, x, y);
+}
+
+/* Replace driver function with counting function, if driver implements it */
+#define LL_WRAP(name, fn)               if (GUI.ll.name != NULL) { GUI.ll.name = fn; }
+
+/**
+ * \brief           Initialize profiler and wrap low-level driver functions
+ * \note            Function must be called after low-level driver is initialized
+ */
+void
+guii_profiler_init(void) {
+    memset(&profiler, 0x00, sizeof(profiler));
+    profiler.ll = GUI.ll;                           /* Save original driver functions */
+
+    LL_WRAP(SetPixel, ll_setpixel);
+    LL_WRAP(GetPixel, ll_getpixel);
+    LL_WRAP(Fill, ll_fill);
+    LL_WRAP(Copy, ll_copy);
+    LL_WRAP(CopyBlend, ll_copyblend);
+    LL_WRAP(DrawHLine, ll_drawhline);
+    LL_WRAP(DrawVLine, ll_drawvline);
+    LL_WRAP(FillRect, ll_fillrect);
+    LL_WRAP(DrawImage16, ll_drawimage16);
+    LL_WRAP(DrawImage24, ll_drawimage24);
+    LL_WRAP(DrawImage32, ll_drawimage32);
+    LL_WRAP(CopyChar, ll_copychar);
+    LL_WRAP(DrawImageScaled, ll_drawimagescaled);
+    LL_WRAP(DrawImageRotated, ll_drawimagerotated);
+}
+
+/**
+ * \brief           Start new event
+ * \note            Every call must be followed by \ref guii_profiler_end
+ */
+void
+guii_profiler_begin(void) {
+    if (profiler.depth < PROFILER_DEPTH) {
+        profiler_frame_t* f = &profiler.stack[profiler.depth];
+        f->start = GUI_CFG_PROFILER_TIME();
+        f->ll_calls = profiler.ll_calls;
+        f->written = profiler.written;
+    }
+    profiler.depth++;
+}
+
+/**
+ * \brief           Finish last started event and save it to ring buffer
+ * \param[in]       type: Event type
+ * \param[in]       h: Widget handle for widget event, `NULL` otherwise
+ * \param[in]       pixels: Number of pixels processed by event
+ * \param[in]       count: Number of widgets drawn or timer callbacks called
+ */
+void
+guii_profiler_end(gui_profiler_evt_type_t type, gui_handle_p h, uint32_t pixels, uint32_t count) {
+    uint32_t now = GUI_CFG_PROFILER_TIME();
+    profiler_frame_t* f;
+    gui_profiler_event_t* e;
+
+    if (profiler.depth == 0 || --profiler.depth >= PROFILER_DEPTH || profiler.disabled) {
+        return;                                     /* Nesting too deep or recording disabled */
+    }
+    f = &profiler.stack[profiler.depth];
+    if ((type == GUI_PROFILER_EVT_PROCESS && f->written == profiler.written)
+        || (type == GUI_PROFILER_EVT_TIMERS && count == 0)) {
+        return;                                     /* Nothing to see, keep buffer for useful events */
+    }
+
+    if (profiler.count == GUI_CFG_PROFILER_EVENTS) {    /* Overwrite oldest event */
+        profiler.r = (profiler.r + 1) % GUI_CFG_PROFILER_EVENTS;
+        profiler.count--;
+        profiler.dropped++;
+    }
+    e = &profiler.events[(profiler.r + profiler.count) % GUI_CFG_PROFILER_EVENTS];
+    profiler.count++;
+    profiler.written++;
+
+    e->type = type;
+    e->depth = profiler.depth;
+    e->id = h != NULL ? h->id : 0;
+    e->name = h != NULL ? h->widget->name : NULL;
+    e->start = f->start;
+    e->duration = now - f->start;
+    e->ll_calls = profiler.ll_calls - f->ll_calls;
+    e->pixels = pixels;
+    e->count = count;
+}
+
+/**
+ * \brief           Enable or disable recording of new events
+ * \param[in]       en: Set to `1` to enable recording or `0` to disable it
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_profiler_setenabled(uint8_t en) {
+    GUI_CORE_PROTECT(1);
+    profiler.disabled = !en;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
+/**
+ * \brief           Remove all recorded events and reset dropped events counter
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_profiler_reset(void) {
+    GUI_CORE_PROTECT(1);
+    profiler.r = 0;
+    profiler.count = 0;
+    profiler.dropped = 0;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
+/**
+ * \brief           Get number of events overwritten before they were read
+ * \return          Number of dropped events since last reset
+ */
+uint32_t
+gui_profiler_getdropped(void) {
+    uint32_t dropped;
+
+    GUI_CORE_PROTECT(1);
+    dropped = profiler.dropped;
+    GUI_CORE_UNPROTECT(1);
+    return dropped;
+}
+
+/**
+ * \brief           Read and remove recorded events, oldest first
+ * \note            GUI processing is blocked while callback is called
+ * \param[in]       fn: Callback function called for each event
+ * \param[in]       arg: User argument for callback function
+ * \return          Number of read events
+ */
+size_t
+gui_profiler_read(gui_profiler_read_fn fn, void* arg) {
+    size_t cnt = 0;
+
+    GUI_ASSERTPARAMS(fn != NULL);
+
+    GUI_CORE_PROTECT(1);
+    while (profiler.count > 0) {
+        if (!fn(&profiler.events[profiler.r], arg)) {
+            break;
+        }
+        profiler.r = (profiler.r + 1) % GUI_CFG_PROFILER_EVENTS;
+        profiler.count--;
+        cnt++;
+    }
+    GUI_CORE_UNPROTECT(1);
+    return cnt;
+}
+
+/**
+ * \brief           State of trace export
+ */
+typedef struct {
+    gui_profiler_write_fn fn;                       /*!< Write function */
+    void* arg;                                      /*!< User argument for write function */
+    uint32_t first;                                 /*!< Start time of first event */
+    size_t count;                                   /*!< Number of exported events */
+} trace_export_t;
+
+/**
+ * \brief           Convert ticks to text with microseconds
+ * \param[out]      str: Output string
+ * \param[in]       ticks: Time in units of \ref GUI_CFG_PROFILER_TIME ticks
+ */
+static void
+ticks_to_us(char* str, uint32_t ticks) {
+    uint64_t ns = (uint64_t)ticks * 1000000000ULL / (uint64_t)GUI_CFG_PROFILER_TIME_FREQ;
+
+    sprintf(str, "%lu.%03lu", (unsigned long)(ns / 1000), (unsigned long)(ns % 1000));
+}
+
+/**
+ * \brief           Write single event as Chrome trace complete event
+ */
+static uint8_t
+trace_write_event(const gui_profiler_event_t* evt, void* arg) {
+    static const char* const names[] = {"process", "timers", "touch", "redraw", "widget"};
+    trace_export_t* t = arg;
+    char buff[256], ts[24], dur[24], name[33];
+    const gui_char* src;
+    size_t i;
+
+    if (t->count == 0) {
+        t->first = evt->start;                      /* Times are relative to first event */
+    }
+
+    /* Copy widget name and skip characters which need escaping in JSON */
+    src = evt->name != NULL ? evt->name : (const gui_char *)names[evt->type];
+    for (i = 0; *src && i < sizeof(name) - 1; src++) {
+        if (*src >= 0x20 && *src < 0x7F && *src != '"' && *src != '\\') {
+            name[i++] = (char)*src;
+        }
+    }
+    name[i] = 0;
+
+    ticks_to_us(ts, evt->start - t->first);
+    ticks_to_us(dur, evt->duration);
+    sprintf(buff, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%s,\"dur\":%s,\"pid\":1,\"tid\":1,"
+        "\"args\":{\"id\":%lu,\"pixels\":%lu,\"count\":%lu,\"ll_calls\":%lu}}",
+        t->count ? "," : "", name, names[evt->type], ts, dur,
+        (unsigned long)evt->id, (unsigned long)evt->pixels, (unsigned long)evt->count, (unsigned long)evt->ll_calls);
+    t->fn(buff, strlen(buff), t->arg);
+    t->count++;
+    return 1;
+}
+
+/**
+ * \brief           Read and remove recorded events and write them as Chrome trace-event JSON
+ *
+ *                  Output can be opened in `chrome://tracing` or Perfetto.
+ *                  Widget draw events are named by widget type, event arguments
+ *                  contain widget ID, pixels, count and number of low-level driver calls
+ *
+ * \note            GUI processing is blocked while callback is called
+ * \param[in]       fn: Callback function to write output text
+ * \param[in]       arg: User argument for callback function
+ * \return          Number of exported events
+ */
+size_t
+gui_profiler_exporttrace(gui_profiler_write_fn fn, void* arg) {
+    static const char header[] = "{\"traceEvents\":[";
+    trace_export_t t;
+    char buff[64];
+
+    GUI_ASSERTPARAMS(fn != NULL);
+
+    t.fn = fn;
+    t.arg = arg;
+    t.first = 0;
+    t.count = 0;
+
+    GUI_CORE_PROTECT(1);                            /* Keep export atomic against new events */
+    fn(header, sizeof(header) - 1, arg);
+    gui_profiler_read(trace_write_event, &t);
+    sprintf(buff, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu}}\n", (unsigned long)profiler.dropped);
+    fn(buff, strlen(buff), arg);
+    GUI_CORE_UNPROTECT(1);
+    return t.count;
+}
+
+#endif /* GUI_CFG_USE_PROFILER || __DOXYGEN__ */
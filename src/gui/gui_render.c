@@ -0,0 +1,257 @@
+/**	
+ * \file            gui_render.c
+ * \brief           Tiled rendering of dirty regions
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#define GUI_INTERNAL
+#include "gui/gui_private.h"
+#include "gui/gui_render.h"
+
+#if GUI_CFG_USE_RENDER_TILES || __DOXYGEN__
+
+static void* tile_buff;                             /*!< Scratch buffer for tile drawing */
+static size_t tile_buff_size;                       /*!< Size of scratch buffer in units of bytes */
+static gui_layer_t tile_layer;                      /*!< Virtual layer for tile drawing */
+static gui_handle_p tile_widgets[GUI_CFG_RENDER_TILE_WIDGETS];  /*!< Widgets marked for redraw in current frame */
+static size_t tile_widgets_count;                   /*!< Number of widgets on list */
+static uint8_t tile_widgets_all;                    /*!< Set to `1` when list is full and all widgets must be checked */
+
+/**
+ * \brief           Get address of pixel in layer memory
+ * \param[in]       layer: Layer to get address for
+ * \param[in]       x: Absolute X position on screen
+ * \param[in]       y: Absolute Y position on screen
+ * \return          Pointer to pixel in layer memory
+ */
+static void *
+get_layer_address(gui_layer_t* layer, gui_dim_t x, gui_dim_t y) {
+    return (void *)(((uint8_t *)layer->start_address) + GUI.lcd.pixel_size * ((y - layer->y_pos) * layer->width + (x - layer->x_pos)));
+}
+
+/**
+ * \brief           Bin dirty rectangles into single tile
+ * \param[in]       layer: Layer with list of dirty rectangles
+ * \param[in]       t: Tile rectangle on screen
+ * \param[out]      clip: Output clipping region covering all dirty parts of tile
+ * \return          `1` if tile is dirty, `0` otherwise
+ */
+static uint8_t
+bin_tile(const gui_layer_t* layer, const gui_display_t* t, gui_display_t* clip) {
+    const gui_display_t* r;
+    size_t i;
+    uint8_t dirty = 0;
+    
+    for (i = 0; i < layer->display_count; i++) {
+        r = &layer->display[i];
+        if (r->x1 >= t->x2 || r->x2 <= t->x1 || r->y1 >= t->y2 || r->y2 <= t->y1) {
+            continue;                               /* Rectangle does not cover this tile */
+        }
+        if (!dirty) {
+            memcpy(clip, t, sizeof(*clip));
+            clip->x1 = GUI_MAX(r->x1, t->x1);
+            clip->y1 = GUI_MAX(r->y1, t->y1);
+            clip->x2 = GUI_MIN(r->x2, t->x2);
+            clip->y2 = GUI_MIN(r->y2, t->y2);
+            dirty = 1;
+        } else {
+            clip->x1 = GUI_MIN(clip->x1, GUI_MAX(r->x1, t->x1));
+            clip->y1 = GUI_MIN(clip->y1, GUI_MAX(r->y1, t->y1));
+            clip->x2 = GUI_MAX(clip->x2, GUI_MIN(r->x2, t->x2));
+            clip->y2 = GUI_MAX(clip->y2, GUI_MIN(r->y2, t->y2));
+        }
+    }
+    return dirty;
+}
+
+/**
+ * \brief           Collect widgets marked for redraw inside current clipping region
+ *
+ *                  Widget marked for redraw is added as single entry as its children are redrawn with it,
+ *                  other widgets are only checked for children marked for redraw.
+ *
+ * \param[in]       parent: Parent widget to check children for. Set to `NULL` for screen
+ * \return          `1` on success, `0` if list is full
+ */
+static uint8_t
+bin_widgets(gui_handle_p parent) {
+    gui_handle_p h;
+    
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        if (!guii_widget_isvisible(h)) {
+            guii_widget_clrflag(h, GUI_FLAG_REDRAW);/* Hidden widget is not redrawn */
+            continue;
+        }
+        if (!guii_widget_isinsideclippingregion(h, 0)) {
+            continue;                               /* Children are inside parent visible area */
+        }
+        if (guii_widget_getflag(h, GUI_FLAG_REDRAW)) {
+            if (tile_widgets_count == GUI_COUNT_OF(tile_widgets)) {
+                return 0;
+            }
+            tile_widgets[tile_widgets_count++] = h;
+        } else if (guii_widget_haschildren(h)) {
+            if (!bin_widgets(h)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Redraw widgets inside current clipping region
+ * \param[in]       redraw_fn: Function to redraw widgets
+ * \return          Number of redrawn widgets
+ */
+static uint32_t
+redraw_widgets(gui_render_redraw_fn redraw_fn) {
+    uint32_t cnt = 0;
+    size_t i;
+    
+    if (tile_widgets_all) {
+        return redraw_fn(NULL);                     /* Walk all widgets */
+    }
+    for (i = 0; i < tile_widgets_count; i++) {
+        cnt += redraw_fn(tile_widgets[i]);
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Redraw single tile
+ * \param[in]       layer: Drawing layer
+ * \param[in]       clip: Dirty part of tile
+ * \param[in]       redraw_fn: Function to redraw widgets
+ * \return          Number of redrawn widgets
+ */
+static uint32_t
+redraw_tile(gui_layer_t* layer, const gui_display_t* clip, gui_render_redraw_fn redraw_fn) {
+    gui_dim_t width = clip->x2 - clip->x1;
+    gui_dim_t height = clip->y2 - clip->y1;
+    uint32_t cnt;
+    
+    memcpy(&GUI.display, clip, sizeof(GUI.display));/* Set clipping region for widgets */
+    
+    /* Draw directly to layer if there is no scratch buffer */
+    if (tile_buff == NULL || ((size_t)width * (size_t)height * (size_t)GUI.lcd.pixel_size) > tile_buff_size) {
+        return redraw_widgets(redraw_fn);
+    }
+    
+    /* Prepare virtual layer for tile, positioned to dirty part of tile */
+    tile_layer.start_address = tile_buff;
+    tile_layer.x_pos = clip->x1;
+    tile_layer.y_pos = clip->y1;
+    tile_layer.width = width;
+    tile_layer.height = height;
+    
+    /* Start with current layer content as widgets may not paint all pixels */
+    GUI.ll.Copy(&GUI.lcd, &tile_layer, tile_buff, get_layer_address(layer, clip->x1, clip->y1),
+        width, height, 0, layer->width - width);
+    
+    GUI.lcd.drawing_layer = &tile_layer;            /* Draw to tile */
+    cnt = redraw_widgets(redraw_fn);
+    GUI.lcd.drawing_layer = layer;                  /* Restore drawing layer */
+    
+    /* Copy finished tile back to layer */
+    GUI.ll.Copy(&GUI.lcd, layer, get_layer_address(layer, clip->x1, clip->y1), tile_buff,
+        width, height, layer->width - width, 0);
+    return cnt;
+}
+
+/**
+ * \brief           Set scratch buffer for tile drawing
+ *
+ *                  When set, tiles are drawn to this buffer and copied to drawing layer after.
+ *                  Buffer should be placed to fast memory and must be at least
+ *                  `GUI_CFG_RENDER_TILE_SIZE * GUI_CFG_RENDER_TILE_SIZE * pixel_size` bytes long,
+ *                  otherwise tiles are drawn directly to drawing layer.
+ *
+ * \param[in]       buff: Pointer to scratch buffer. Set to `NULL` to draw directly to drawing layer
+ * \param[in]       size: Size of buffer in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_render_settilebuffer(void* buff, size_t size) {
+    GUI_CORE_PROTECT(1);
+    tile_buff = buff;
+    tile_buff_size = buff != NULL ? size : 0;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
+/**
+ * \brief           Redraw all dirty rectangles of layer tile by tile
+ * \note            This function is private and may be called only when OS protection is active
+ * \param[in]       layer: Drawing layer with list of dirty rectangles to redraw
+ * \param[in]       redraw_fn: Function to redraw widgets inside current clipping region
+ * \return          Number of redrawn widgets
+ */
+uint32_t
+gui_render_tiles(gui_layer_t* layer, gui_render_redraw_fn redraw_fn) {
+    gui_display_t bbox, t, clip;
+    gui_dim_t tx, ty;
+    uint32_t cnt = 0;
+    size_t i;
+    
+    if (!layer->display_count) {
+        return 0;
+    }
+    
+    /* Get bounding box of all dirty rectangles to limit tiles to check */
+    memcpy(&bbox, &layer->display[0], sizeof(bbox));
+    for (i = 1; i < layer->display_count; i++) {
+        bbox.x1 = GUI_MIN(bbox.x1, layer->display[i].x1);
+        bbox.y1 = GUI_MIN(bbox.y1, layer->display[i].y1);
+        bbox.x2 = GUI_MAX(bbox.x2, layer->display[i].x2);
+        bbox.y2 = GUI_MAX(bbox.y2, layer->display[i].y2);
+    }
+    
+    /* Collect widgets to redraw once, tiles only check this list */
+    memcpy(&GUI.display, &bbox, sizeof(GUI.display));
+    tile_widgets_count = 0;
+    tile_widgets_all = !bin_widgets(NULL);
+    
+    /* Process tiles from top to bottom, left to right */
+    for (ty = bbox.y1 - (bbox.y1 % GUI_CFG_RENDER_TILE_SIZE); ty < bbox.y2; ty += GUI_CFG_RENDER_TILE_SIZE) {
+        for (tx = bbox.x1 - (bbox.x1 % GUI_CFG_RENDER_TILE_SIZE); tx < bbox.x2; tx += GUI_CFG_RENDER_TILE_SIZE) {
+            t.x1 = tx;
+            t.y1 = ty;
+            t.x2 = GUI_MIN(tx + GUI_CFG_RENDER_TILE_SIZE, GUI.lcd.width);
+            t.y2 = GUI_MIN(ty + GUI_CFG_RENDER_TILE_SIZE, GUI.lcd.height);
+            
+            if (bin_tile(layer, &t, &clip)) {       /* Redraw only dirty tiles */
+                cnt += redraw_tile(layer, &clip, redraw_fn);
+            }
+        }
+    }
+    return cnt;
+}
+
+#endif /* GUI_CFG_USE_RENDER_TILES || __DOXYGEN__ */
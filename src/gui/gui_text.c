@@ -38,6 +38,40 @@
 #define CH_WS                       GUI_KEY_WS
 #define get_char_from_value(ch)     (uint32_t)((CH_CR == (ch) || CH_LF == (ch)) ? CH_WS : (ch))
 
+#define FONT_CACHE_MASK             (GUI_CFG_FONT_CACHE_ENTRIES - 1)
+#define FONT_CACHE_MAX_COUNT        (GUI_CFG_FONT_CACHE_ENTRIES - (GUI_CFG_FONT_CACHE_ENTRIES >> 2))
+
+/**
+ * \brief           Find character descriptor in font
+ * \param[in]       font: Font to search in
+ * \param[in]       ch: Unicode decoded character
+ * \return          Character descriptor or `NULL` if font does not have character
+ */
+static const gui_font_char_t *
+get_font_char(const gui_font_t* font, uint32_t ch) {
+    size_t low, high, mid;
+    
+    if (ch < font->startchar || ch > font->endchar) {
+        return NULL;
+    }
+    if (font->codes == NULL) {                      /* All characters in range are available */
+        return &font->data[ch - font->startchar];
+    }
+    low = 0;
+    high = font->codes_count;
+    while (low < high) {                            /* Binary search over sorted codes */
+        mid = (low + high) / 2;
+        if (font->codes[mid] == ch) {
+            return &font->data[mid];
+        } else if (font->codes[mid] < ch) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
 /**
  * \brief           Get character descriptor from specific character and font
  * \param[in]       font: Font to use for drawing
@@ -46,16 +80,47 @@
  */
 const gui_font_char_t *
 gui_text_getchardesc(const gui_font_t* font, uint32_t ch) {
+    const gui_font_char_t* c;
+    
     ch = get_char_from_value(ch);
     /* Try to get character from font */
-    if (ch >= font->startchar && ch <= font->endchar) {
-        return &font->data[(ch)-font->startchar];
-
+    if ((c = get_font_char(font, ch)) != NULL) {
+        return c;
+    }
     /* If it doesn't exist, try with question mark */
-    } else if ('?' >= font->startchar && '?' <= font->endchar) {
-        return &font->data[(uint32_t)'?' - font->startchar];
+    return get_font_char(font, '?');
+}
+
+/**
+ * \brief           Get kerning offset between 2 characters
+ * \param[in]       font: Font used for characters
+ * \param[in]       left: Unicode decoded left character
+ * \param[in]       right: Unicode decoded right character
+ * \return          Offset to add to left character advance in units of pixels
+ */
+gui_dim_t
+gui_text_getkerning(const gui_font_t* font, uint32_t left, uint32_t right) {
+    size_t low, high, mid;
+    uint32_t key, k;
+    
+    if (font->kerning == NULL || !left || left > 0xFFFF || right > 0xFFFF) {
+        return 0;
     }
-    return NULL;
+    key = (left << 16) | right;
+    low = 0;
+    high = font->kerning_count;
+    while (low < high) {                            /* Binary search over sorted pairs */
+        mid = (low + high) / 2;
+        k = ((uint32_t)font->kerning[mid].left << 16) | font->kerning[mid].right;
+        if (k == key) {
+            return font->kerning[mid].offset;
+        } else if (k < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return 0;
 }
 
 /**
@@ -71,7 +136,7 @@ gui_text_getcharsize(const gui_font_t* font, uint32_t ch, gui_dim_t* width, gui_
     
     c = gui_text_getchardesc(font, ch);
     if (c != NULL) {
-        *width = c->x_size + c->x_margin;
+        *width = c->x_pos + c->x_size + c->x_margin;
         *height = c->y_size;
     } else {
         *width = 0;
@@ -79,8 +144,157 @@ gui_text_getcharsize(const gui_font_t* font, uint32_t ch, gui_dim_t* width, gui_
     }
 }
 
+/**
+ * \brief           Read next value with font bits per pixel from character data
+ * \param[in]       r: Character data reader
+ * \return          Pixel value
+ */
+static uint8_t
+read_glyph_bits(guii_text_glyphreader_t* r) {
+    if (!r->bits) {                                 /* Load next byte */
+        r->byte = *r->data++;
+        r->bits = 8;
+    }
+    r->bits -= r->bpp;
+    return (r->byte >> r->bits) & (uint8_t)((1U << r->bpp) - 1);
+}
+
+/**
+ * \brief           Prepare reader for character data
+ * \param[out]      r: Character data reader to initialize
+ * \param[in]       font: Font used for character
+ * \param[in]       c: Character descriptor
+ */
+void
+guii_text_glyphreader_init(guii_text_glyphreader_t* r, const gui_font_t* font, const gui_font_char_t* c) {
+    memset(r, 0x00, sizeof(*r));
+    r->data = c->data;
+    if (font->flags & GUI_FLAG_FONT_AA8) {
+        r->bpp = 8;
+    } else if (font->flags & GUI_FLAG_FONT_AA4) {
+        r->bpp = 4;
+    } else if (font->flags & GUI_FLAG_FONT_AA) {
+        r->bpp = 2;
+    } else {
+        r->bpp = 1;
+    }
+    r->rle = (font->flags & GUI_FLAG_FONT_RLE) == GUI_FLAG_FONT_RLE;
+    r->width = c->x_size;
+}
+
+/**
+ * \brief           Get alpha value of next pixel in character.
+ *                  Pixels are read row by row, from left to right
+ * \param[in]       r: Character data reader
+ * \return          Pixel alpha value between `0x00` (transparent) and `0xFF` (solid)
+ */
+uint8_t
+guii_text_glyphreader_get(guii_text_glyphreader_t* r) {
+    uint8_t v;
+    
+    if (r->rle) {                                   /* Run-length encoded data */
+        if (!r->run) {                              /* Start of new run */
+            v = *r->data++;                         /* Get run header */
+            r->repeat = (v & GUI_FONT_RLE_REPEAT) == GUI_FONT_RLE_REPEAT;
+            if (r->repeat) {
+                r->run = (v & (GUI_FONT_RLE_REPEAT_MAX - 1)) + 1;
+                r->value = (v & GUI_FONT_RLE_SOLID) ? 0xFF : 0x00;
+            } else {
+                r->run = (v & (GUI_FONT_RLE_LITERAL_MAX - 1)) + 1;
+            }
+            r->bits = 0;                            /* Literal values start on byte boundary */
+        }
+        r->run--;
+        if (r->repeat) {
+            return r->value;                        /* Value is already alpha */
+        }
+        v = read_glyph_bits(r);
+    } else {
+        v = read_glyph_bits(r);
+        if (++r->x == r->width) {                   /* Each line starts on byte boundary */
+            r->x = 0;
+            r->bits = 0;
+        }
+    }
+    
+    /* Scale value to alpha */
+    switch (r->bpp) {
+        case 1: return v ? 0xFF : 0x00;
+        case 2: return v * 0x55;
+        case 4: return v * 0x11;
+        default: return v;
+    }
+}
+
+/**
+ * \brief           Get home slot in hash table for font and character
+ * \param[in]       font: Font used for character
+ * \param[in]       c: Character info handle
+ * \return          Slot index in hash table
+ */
+static size_t
+get_cache_index(const gui_font_t* font, const gui_font_char_t* c) {
+    uint32_t h;
+    
+    h = (uint32_t)(size_t)c ^ ((uint32_t)(size_t)font * 31U);
+    h ^= h >> 16;                                   /* Mix upper and lower bits */
+    h *= 0x45D9F3BU;
+    h ^= h >> 16;
+    return (size_t)h & FONT_CACHE_MASK;
+}
+
+/**
+ * \brief           Remove entry from cache and free its memory
+ * \param[in]       entry: Entry to remove
+ */
+static void
+remove_cache_entry(gui_font_charentry_t* entry) {
+    gui_font_charentry_t** table = GUI.font_cache.table;
+    size_t i, j, k;
+    
+    /* Find slot of entry */
+    for (i = get_cache_index(entry->font, entry->ch); table[i] != entry; i = (i + 1) & FONT_CACHE_MASK) {}
+    table[i] = NULL;
+    
+    /*
+     * Move following entries of the same probe chain back,
+     * so that no empty slot is left between entry home slot and its actual slot
+     */
+    for (j = (i + 1) & FONT_CACHE_MASK; table[j] != NULL; j = (j + 1) & FONT_CACHE_MASK) {
+        k = get_cache_index(table[j]->font, table[j]->ch);
+        if (((j - k) & FONT_CACHE_MASK) >= ((j - i) & FONT_CACHE_MASK)) {
+            table[i] = table[j];                    /* Home slot is before empty slot */
+            table[j] = NULL;
+            i = j;
+        }
+    }
+    
+    gui_linkedlist_remove_gen(&GUI.font_cache.lru, (gui_linkedlist_t *)entry);
+    GUI.font_cache.count--;
+    GUI.font_cache.used -= entry->size;
+    GUI_MEMFREE(entry);
+}
+
+/**
+ * \brief           Remove least recently used entry from cache
+ * \return          `1` if entry was removed, `0` if cache is empty
+ */
+static uint8_t
+evict_cache_entry(void) {
+    gui_font_charentry_t* entry;
+    
+    entry = (gui_font_charentry_t *)gui_linkedlist_getnext_gen(&GUI.font_cache.lru, NULL);
+    if (entry != NULL) {
+        remove_cache_entry(entry);
+        GUI.font_cache.evictions++;
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * \brief           Get character entry generated in memory for fast drawing
+ * \note            Found entry is marked as most recently used
  * \param[in]       font: Font used for character
  * \param[in]       c: Character info handle
  * \return          Character entry on success, `NULL` otherwise
@@ -88,19 +302,27 @@ gui_text_getcharsize(const gui_font_t* font, uint32_t ch, gui_dim_t* width, gui_
 gui_font_charentry_t *
 gui_text_getcharentry(const gui_font_t* font, const gui_font_char_t* c) {
     gui_font_charentry_t* entry;
+    size_t i;
 
-    /* Process all characters on linked list */
-    for (entry = (gui_font_charentry_t *)gui_linkedlist_getnext_gen(&GUI.root_fonts, NULL); entry != NULL;
-        entry = (gui_font_charentry_t *)gui_linkedlist_getnext_gen(NULL, (gui_linkedlist_t *)entry)) {
+    /* Probe hash table until empty slot */
+    for (i = get_cache_index(font, c); (entry = GUI.font_cache.table[i]) != NULL; i = (i + 1) & FONT_CACHE_MASK) {
         if (entry->font == font && entry->ch == c) {
+            if (GUI.font_cache.lru.last != entry) { /* Move to the end of LRU list */
+                gui_linkedlist_remove_gen(&GUI.font_cache.lru, (gui_linkedlist_t *)entry);
+                gui_linkedlist_add_gen(&GUI.font_cache.lru, (gui_linkedlist_t *)entry);
+            }
+            GUI.font_cache.hits++;
             return entry;
         }
     }
-    return 0;
+    GUI.font_cache.misses++;
+    return NULL;
 }
 
 /**
- * \brief           Create new entry for character map and put it to linked list of known entries
+ * \brief           Create new entry for character map and put it to cache of known entries
+ * \note            Least recently used entries are removed when cache is full
+ *                  or when there is not enough memory for new entry
  * \param[in]       font: Font for character
  * \param[in]       c: Character descriptor
  * \return          Character entry on success, `NULL` otherwise
@@ -108,77 +330,82 @@ gui_text_getcharentry(const gui_font_t* font, const gui_font_char_t* c) {
 gui_font_charentry_t *
 gui_text_createcharentry(const gui_font_t* font, const gui_font_char_t* c) {
     gui_font_charentry_t* entry = NULL;
-    size_t columns, memDataSize, memsize;
+    size_t memDataSize, memsize, slot, i;
 
     /* Calculate memory size for data */
     memsize = GUI_MEM_ALIGN(sizeof(*entry));
     memDataSize = (size_t)c->x_size * (size_t)c->y_size;
     memsize += GUI_MEM_ALIGN(memDataSize);          /* Align memory before increase */
-    entry = GUI_MEMALLOC(memsize);                  /* Allocate memory for entry */
+    
+    /* Make space in cache */
+    while (GUI.font_cache.count >= FONT_CACHE_MAX_COUNT
+#if GUI_CFG_FONT_CACHE_SIZE
+        || (GUI.font_cache.count && GUI.font_cache.used + memsize > GUI_CFG_FONT_CACHE_SIZE)
+#endif /* GUI_CFG_FONT_CACHE_SIZE */
+        ) {
+        evict_cache_entry();
+    }
+    
+    /* Allocate memory, release old entries if there is not enough memory */
+    while ((entry = GUI_MEMALLOC(memsize)) == NULL && evict_cache_entry()) {}
     if (entry != NULL) {                            /* Allocation was successful */
-        uint16_t i, x;
-        uint8_t b, k, t;
+        guii_text_glyphreader_t reader;
         uint8_t* ptr = (uint8_t *)entry;            /* Go to memory size */
 
         ptr += GUI_MEM_ALIGN(sizeof(*entry));       /* Go to start of data, at the end of aligned structure size */
 
         entry->ch = c;                              /* Set pointer to character */
         entry->font = font;                         /* Set pointer to font structure */
+        entry->size = memsize;                      /* Set memory size for cache budget */
 
-        if (font->flags & GUI_FLAG_FONT_AA) {       /* Anti-alliased font */
-            columns = c->x_size >> 2;               /* Calculate number of bytes used for single character line */
-            if (c->x_size % 4) {                    /* If only 1 column used */
-                columns++;
-            }
-            x = 0;
-            for (i = 0; i < c->y_size * columns; i++) { /* Inspect all vertical lines */
-                b = c->data[i];                     /* Get byte of data */
-                for (k = 0; k < 4; k++) {           /* Scan each bit in byte */
-                    t = (b >> (6 - 2 * k)) & 0x03;  /* Get temporary bits on bottom */
-                    switch (t) {
-                        case 0:
-                            *ptr |= 0x00;
-                            break;
-                        case 1:
-                            *ptr |= 0x55;
-                            break;
-                        case 2:
-                            *ptr |= 0xAA;
-                            break;
-                        default:
-                            *ptr |= 0xFF;
-                    }
-                    ptr++;
-                    x++;
-                    if (x == c->x_size) {
-                        x = 0;
-                        break;
-                    }
-                }
-            }
-        } else {
-            columns = c->x_size >> 3;               /* Calculate number of bytes used for single character line */
-            if (c->x_size % 8) {                    /* If only 1 column used */
-                columns++;
-            }
-            x = 0;
-            for (i = 0; i < c->y_size * columns; i++) { /* Inspect all vertical lines */
-                b = c->data[i];                     /* Get byte of data */
-                for (k = 0; k < 8; k++) {           /* Scan each bit in byte */
-                    if ((b >> (7 - k)) & 0x01) {
-                        *ptr++ = 0xFF;
-                    } else {
-                        *ptr++ = 0x00;
-                    }
-                    x++;
-                    if (x == c->x_size) {
-                        x = 0;
-                        break;
-                    }
-                }
-            }
+        /* Expand character data to one alpha byte per pixel */
+        guii_text_glyphreader_init(&reader, font, c);
+        for (i = 0; i < memDataSize; i++) {
+            *ptr++ = guii_text_glyphreader_get(&reader);
         }
-        gui_linkedlist_add_gen(&GUI.root_fonts, (gui_linkedlist_t *)entry);  /* Add entry to linked list */
+        
+        /* Add entry to first empty slot and as most recently used */
+        for (slot = get_cache_index(font, c); GUI.font_cache.table[slot] != NULL; slot = (slot + 1) & FONT_CACHE_MASK) {}
+        GUI.font_cache.table[slot] = entry;
+        gui_linkedlist_add_gen(&GUI.font_cache.lru, (gui_linkedlist_t *)entry);
+        GUI.font_cache.count++;
+        GUI.font_cache.used += memsize;
     }
     return entry;
 }
+
+/**
+ * \brief           Get character entries cache statistics
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_text_getcachestats(gui_text_cachestats_t* stats) {
+    GUI_ASSERTPARAMS(stats != NULL);
+    
+    GUI_CORE_PROTECT(1);
+    stats->entries = GUI.font_cache.count;
+    stats->used = GUI.font_cache.used;
+    stats->hits = GUI.font_cache.hits;
+    stats->misses = GUI.font_cache.misses;
+    stats->evictions = GUI.font_cache.evictions;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
+
+/**
+ * \brief           Remove all character entries from cache and reset statistics
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_text_clearcache(void) {
+    GUI_CORE_PROTECT(1);
+    while (GUI.font_cache.lru.first != NULL) {
+        remove_cache_entry(GUI.font_cache.lru.first);
+    }
+    GUI.font_cache.hits = 0;
+    GUI.font_cache.misses = 0;
+    GUI.font_cache.evictions = 0;
+    GUI_CORE_UNPROTECT(1);
+    return 1;
+}
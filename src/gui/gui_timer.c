@@ -33,6 +33,7 @@
 #define GUI_INTERNAL
 #include "gui/gui_private.h"
 #include "gui/gui_timer.h"
+#include "gui/gui_profiler.h"
 #include "system/gui_sys.h"
 
 #define GUI_FLAG_TIMER_ACTIVE           ((uint16_t)(1 << 0UL))  /*!< Timer is active */
@@ -164,10 +165,12 @@ guii_timer_process(void) {
     volatile uint32_t time = gui_sys_now();         /* Get current time */
     volatile uint32_t lastTime = GUI.timers.time;
     uint32_t diff = time - lastTime;                /* Get difference in time */
+    uint32_t calls = 0;
     
     if (diff == 0) {                                /* No difference in time */
         return;
     }
+    GUI_PROFILER_BEGIN();
     
     /* Process all software timers */
     for (t = (gui_timer_t *)GUI.timers.list.first; t != NULL;
@@ -179,6 +182,7 @@ guii_timer_process(void) {
             }
             if (t->callback != NULL) {              /* Process callback */
                 t->callback(t);                     /* Call user function */
+                calls++;
             }
         }
         
@@ -198,6 +202,7 @@ guii_timer_process(void) {
     }
     
     GUI.timers.time = time;                         /* Reset time */
+    GUI_PROFILER_END(GUI_PROFILER_EVT_TIMERS, NULL, 0, calls);
 }
 
 /**
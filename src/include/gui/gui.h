@@ -192,6 +192,7 @@ extern "C" {
 guir_t      gui_init(void);
 int32_t     gui_process(void);
 uint8_t     gui_seteventcallback(gui_eventcallback_t cb);
+uint8_t     gui_getredrawstats(gui_redrawstats_t* stats);
 
 #if GUI_CFG_OS || __DOXYGEN__
 uint8_t     gui_protect(const uint8_t protect);
@@ -147,6 +147,19 @@
 #define GUI_CFG_MEM_ALIGNMENT                   4
 #endif
 
+/**
+ * \brief           Selects allocation algorithm of library memory manager
+ *
+ *                  0: First-fit allocator with address ordered free list, smallest RAM overhead
+ *                  1: Two-level segregated fit (TLSF) allocator with constant time allocation and free,
+ *                      bounded latency regardless of heap usage for cost of additional free list table in RAM
+ *
+ * \note            Used only when \ref GUI_CFG_USE_MEM is enabled
+ */
+#ifndef GUI_CFG_MEM_USE_TLSF
+#define GUI_CFG_MEM_USE_TLSF                    0
+#endif
+
 /**
  * \brief           Enables (1) or disables (0) alpha option for widgets
  *
@@ -169,14 +182,128 @@
  *                  cache is introduced. In this case, every widget change in position/size values
  *                  will immediately calculate absolute values and save into additional information fields.
  *
- * \note            When modifying widget position/size, all children widgets must be modified too
- *                  as absolute position/size may change on them aswell
+ * \note            When modifying widget position/size, children widgets are only marked as pending.
+ *                  Their absolute values are recalculated once per frame or when first read,
+ *                  so multiple changes of parent widget in single frame are cheap
  *
  * \note            Enabling this feature significantly reduces calculation time,
- *                  but requires more memory for `4` dimension values (usually `8` bytes) per widget
+ *                  but requires more memory per widget: `8` dimension values for absolute
+ *                  and visible position/size (usually `16` bytes) and `64-bit` grid mask
+ *                  of visible area for fast overlap and touch tests, `24` bytes in total.
+ *                  Pending layout uses one bit of existing widget flags
  */
 #ifndef GUI_CFG_USE_POS_SIZE_CACHE
-#define GUI_CFG_USE_POS_SIZE_CACHE              0
+#define GUI_CFG_USE_POS_SIZE_CACHE              1
+#endif
+
+/**
+ * \brief           Maximal number of dirty rectangles tracked for single redraw process
+ *
+ *                  Every invalidated widget adds its visible area to list of dirty rectangles.
+ *                  Rectangles which overlap or are close enough are merged together,
+ *                  others are kept separate so that only changed areas are redrawn.
+ *
+ *                  When list is full, whole screen is marked as dirty instead.
+ *
+ * \note            Each rectangle requires `4` dimension values in GUI and in each LCD layer
+ */
+#ifndef GUI_CFG_DISPLAY_RECTS
+#define GUI_CFG_DISPLAY_RECTS                   8
+#endif
+
+/**
+ * \brief           Maximal wasted area when merging 2 dirty rectangles, in units of percent
+ *
+ *                  Wasted area is part of bounding rectangle which is not covered by any of merged rectangles.
+ *                  When wasted area is lower or equal to this percentage of bounding rectangle area,
+ *                  rectangles are merged into single one. Overlapping rectangles are always merged.
+ */
+#ifndef GUI_CFG_DISPLAY_RECTS_MERGE_WASTE
+#define GUI_CFG_DISPLAY_RECTS_MERGE_WASTE       25
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) tiled rendering of dirty regions
+ *
+ *                  When enabled, dirty rectangles are binned into square tiles
+ *                  and each dirty tile is redrawn separately with its own clipping region.
+ *                  Optionally, tiles are drawn to user scratch buffer in fast memory first.
+ *
+ * \sa              gui_render_settilebuffer
+ */
+#ifndef GUI_CFG_USE_RENDER_TILES
+#define GUI_CFG_USE_RENDER_TILES                0
+#endif
+
+/**
+ * \brief           Tile width and height in units of pixels for tiled rendering
+ *
+ * \note            Used only when \ref GUI_CFG_USE_RENDER_TILES is enabled
+ */
+#ifndef GUI_CFG_RENDER_TILE_SIZE
+#define GUI_CFG_RENDER_TILE_SIZE                64
+#endif
+
+/**
+ * \brief           Maximal number of widgets marked for redraw, binned once per frame for tiled rendering
+ *
+ *                  Each tile only checks widgets on this list instead of walking all widgets.
+ *                  When more widgets are marked for redraw, all widgets are checked for each tile.
+ *
+ * \note            Used only when \ref GUI_CFG_USE_RENDER_TILES is enabled
+ */
+#ifndef GUI_CFG_RENDER_TILE_WIDGETS
+#define GUI_CFG_RENDER_TILE_WIDGETS             32
+#endif
+
+/**
+ * \brief           Maximal memory used by character entries cache in units of bytes
+ *
+ *                  Character entries are created in memory when low-level driver
+ *                  supports `CopyChar` function. When limit is reached,
+ *                  least recently used entries are removed to make space for new ones.
+ *
+ * \note            Set to `0` to only limit cache by available memory
+ */
+#ifndef GUI_CFG_FONT_CACHE_SIZE
+#define GUI_CFG_FONT_CACHE_SIZE                 16384
+#endif
+
+/**
+ * \brief           Number of slots in character entries cache hash table
+ *
+ *                  Up to `3/4` of slots are used at a time to keep lookups short.
+ *
+ * \note            Value must be power of `2`
+ */
+#ifndef GUI_CFG_FONT_CACHE_ENTRIES
+#define GUI_CFG_FONT_CACHE_ENTRIES              256
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) text layout cache for widgets
+ *
+ *                  Widgets with text save line breaks and character positions
+ *                  on first draw and redraw unchanged text without processing string again.
+ *
+ * \note            Text must be modified with widget functions (such as \ref gui_widget_settext),
+ *                  otherwise widget may draw old layout
+ *
+ * \note            Each widget requires additional memory for positions of all its characters
+ */
+#ifndef GUI_CFG_USE_TEXT_CACHE
+#define GUI_CFG_USE_TEXT_CACHE                  0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) SIMD kernels in software low-level driver
+ *
+ *                  When enabled, \ref gui_ll_soft_init selects SSE2, AVX2 or NEON
+ *                  row kernels, depending on compiler target and CPU features.
+ *                  When disabled or not available, portable C kernels are used
+ */
+#ifndef GUI_CFG_LL_SOFT_USE_SIMD
+#define GUI_CFG_LL_SOFT_USE_SIMD                1
 #endif
 
 /**
@@ -223,6 +350,50 @@ gui_widget_setignoreinvalidate(h, 0, 1, 0);
 #define GUI_CFG_LONG_CLICK_TIMEOUT              1500
 #endif
 
+/**
+ * \brief           Enables (1) or disables (0) frame profiler
+ *
+ *                  When enabled, GUI records duration of processing steps, redraws and
+ *                  each widget draw to ring buffer, read later with \ref gui_profiler_read
+ *                  or exported with \ref gui_profiler_exporttrace
+ *
+ * \note            Low-level drawing functions are called through counting wrappers when enabled
+ */
+#ifndef GUI_CFG_USE_PROFILER
+#define GUI_CFG_USE_PROFILER                    0
+#endif
+
+/**
+ * \brief           Number of events in profiler ring buffer
+ *
+ *                  When buffer is full, oldest events are overwritten
+ *
+ * \note            Used only when \ref GUI_CFG_USE_PROFILER is enabled
+ */
+#ifndef GUI_CFG_PROFILER_EVENTS
+#define GUI_CFG_PROFILER_EVENTS                 256
+#endif
+
+/**
+ * \brief           Get current time for profiler
+ *
+ *                  Milliseconds from system port are too coarse to measure single widget,
+ *                  set this to hardware cycle counter or microsecond timer on target
+ *
+ * \note            Used only when \ref GUI_CFG_USE_PROFILER is enabled
+ * \sa              GUI_CFG_PROFILER_TIME_FREQ
+ */
+#ifndef GUI_CFG_PROFILER_TIME
+#define GUI_CFG_PROFILER_TIME()                 gui_sys_now()
+#endif
+
+/**
+ * \brief           Number of \ref GUI_CFG_PROFILER_TIME ticks per second
+ */
+#ifndef GUI_CFG_PROFILER_TIME_FREQ
+#define GUI_CFG_PROFILER_TIME_FREQ              1000
+#endif
+
 #ifndef GUI_CFG_SYS_PORT
 #define GUI_CFG_SYS_PORT                        GUI_SYS_PORT_CMSIS_OS
 #endif
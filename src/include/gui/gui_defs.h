@@ -82,6 +82,7 @@ extern "C" {
 #define GUI_FLAG_IGNORE_INVALIDATE          ((uint32_t)0x00004000)  /*!< Indicates widget invalidation is ignored completely when invalidating it directly */
 #define GUI_FLAG_FIRST_INVALIDATE           ((uint32_t)0x00008000)  /*!< Indicates widget is invalidated for "first" time, thus ignore check if parent is hidden or not */
 #define GUI_FLAG_TOUCH_MOVE                 ((uint32_t)0x00010000)  /*!< Indicates widget callback has processed touch move event. This parameter works in conjunction with \ref GUI_FLAG_ACTIVE flag */
+#define GUI_FLAG_LAYOUT_DIRTY               ((uint32_t)0x00400000)  /*!< Indicates absolute position/size of children widgets is not calculated yet. Used in GUI flags when any widget has pending layout */
 
 /**
  * \}
@@ -97,6 +98,9 @@ extern "C" {
 #define GUI_FLAG_WIDGET_ALLOW_CHILDREN      ((uint32_t)0x00040000)  /*!< Widget allows children widgets */
 #define GUI_FLAG_WIDGET_DIALOG_BASE         ((uint32_t)0x00080000)  /*!< Widget is dialog base. When it is active, no other widget around dialog can be pressed */
 #define GUI_FLAG_WIDGET_INVALIDATE_PARENT   ((uint32_t)0x00100000)  /*!< Anytime widget is invalidated, parent should be invalidated too */
+#define GUI_FLAG_WIDGET_OPAQUE              ((uint32_t)0x00200000)  /*!< Widget paints every pixel of its rectangle with opaque color. Anything below it does not need to be drawn. Used as default value for widget instance flag. Background color must be at index \ref GUI_WIDGET_COLOR_BG */
+
+#define GUI_WIDGET_COLOR_BG                 0x00    /*!< Color index of background color for widgets with \ref GUI_FLAG_WIDGET_OPAQUE flag */
 
 /**
  * \}
@@ -375,7 +379,8 @@ typedef struct {
     uint8_t num;                            /*!< Layer number */
     void* start_address;                    /*!< Start address in memory if it exists */
     volatile uint8_t pending;               /*!< Layer pending for redrawing operation */
-    gui_display_t display;                  /*!< Display setup for clipping regions for main layers (no virtual) */
+    gui_display_t display[GUI_CFG_DISPLAY_RECTS];   /*!< List of regions redrawn on layer, used to synchronize main layers (no virtual) */
+    size_t display_count;                   /*!< Number of valid regions in `display` array */
     
     gui_dim_t width;                        /*!< Layer width, used for virtual layers mainly */
     gui_dim_t height;                       /*!< Layer height, used for virtual layers mainly */
@@ -397,6 +402,18 @@ typedef struct {
     uint32_t flags;                         /*!< List of flags */
 } gui_lcd_t;
 
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Image data format
+ */
+typedef enum {
+    GUI_IMAGE_FORMAT_RAW = 0x00,            /*!< Raw pixels with `16`, `24` or `32` bits per pixel */
+    GUI_IMAGE_FORMAT_INDEXED,               /*!< Palette indices with `1`, `2`, `4` or `8` bits per pixel, MSB first.
+                                                    Each line starts on byte boundary */
+    GUI_IMAGE_FORMAT_RLE,                   /*!< Run-length encoded ARGB8888 pixels. Check \ref GUI_IMAGE_RLE for format */
+    GUI_IMAGE_FORMAT_QOI,                   /*!< Complete file in QOI (Quite OK Image) format, including header and end marker */
+} gui_image_format_t;
+
 /**
  * \ingroup         GUI_IMAGE
  * \brief           Image descriptor structure
@@ -404,10 +421,113 @@ typedef struct {
 typedef struct {
     gui_dim_t x_size;                       /*!< Image X size */
     gui_dim_t y_size;                       /*!< Image Y size */
-    uint8_t bpp;                            /*!< Bits per pixel */
+    uint8_t bpp;                            /*!< Bits per pixel. For \ref GUI_IMAGE_FORMAT_INDEXED number of bits per palette index,
+                                                    `32` for \ref GUI_IMAGE_FORMAT_RLE and \ref GUI_IMAGE_FORMAT_QOI */
     const uint8_t* image;                   /*!< Pointer to image byte array */
+    gui_image_format_t format;              /*!< Image data format */
+    const gui_color_t* palette;             /*!< Palette colors in ARGB8888 format for \ref GUI_IMAGE_FORMAT_INDEXED, `NULL` otherwise */
+    uint8_t flags;                          /*!< List of image flags. Check \ref GUI_IMAGE_FLAGS */
+    gui_dim_t x_offset;                     /*!< X offset of image data, added to draw position. Used for images with trimmed transparent border */
+    gui_dim_t y_offset;                     /*!< Y offset of image data, added to draw position. Used for images with trimmed transparent border */
+    gui_dim_t width;                        /*!< Width of original image before trimming. Set to `0` when image is not trimmed */
+    gui_dim_t height;                       /*!< Height of original image before trimming. Set to `0` when image is not trimmed */
 } gui_image_desc_t;
 
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Get width of original image, including trimmed transparent border
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure
+ */
+#define GUI_IMAGE_WIDTH(img)            ((img)->width ? (img)->width : (gui_dim_t)((img)->x_offset + (img)->x_size))
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Get height of original image, including trimmed transparent border
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure
+ */
+#define GUI_IMAGE_HEIGHT(img)           ((img)->height ? (img)->height : (gui_dim_t)((img)->y_offset + (img)->y_size))
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Check if image has trimmed transparent border
+ * \param[in]       img: Pointer to \ref gui_image_desc_t structure
+ */
+#define GUI_IMAGE_ISTRIMMED(img)        ((img)->x_size != GUI_IMAGE_WIDTH(img) || (img)->y_size != GUI_IMAGE_HEIGHT(img))
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \defgroup        GUI_IMAGE_FLAGS Image flags
+ * \brief           List of image descriptor flags
+ * \{
+ */
+
+#define GUI_IMAGE_FLAG_PREMULTIPLIED    ((uint8_t)0x01) /*!< Color channels of 32-bit pixels are premultiplied by pixel alpha */
+#define GUI_IMAGE_FLAG_OPAQUE           ((uint8_t)0x02) /*!< All pixels are fully opaque, widget parent does not need redraw */
+
+/**
+ * \}
+ */
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Image rotation in clockwise direction
+ */
+typedef enum {
+    GUI_IMAGE_ROTATE_0 = 0x00,              /*!< Image is not rotated */
+    GUI_IMAGE_ROTATE_90,                    /*!< Image is rotated by 90 degrees */
+    GUI_IMAGE_ROTATE_180,                   /*!< Image is rotated by 180 degrees */
+    GUI_IMAGE_ROTATE_270,                   /*!< Image is rotated by 270 degrees */
+} gui_image_rotate_t;
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Image scaling filter
+ */
+typedef enum {
+    GUI_IMAGE_FILTER_NEAREST = 0x00,        /*!< Nearest pixel, fastest */
+    GUI_IMAGE_FILTER_BILINEAR,              /*!< Bilinear interpolation of 4 nearest pixels */
+} gui_image_filter_t;
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \brief           Image blit parameters for part of image, scaling and rotation
+ * \sa              gui_draw_image_blit
+ */
+typedef struct {
+    gui_dim_t src_x;                        /*!< Source rectangle X position in original image, before trimming */
+    gui_dim_t src_y;                        /*!< Source rectangle Y position in original image, before trimming */
+    gui_dim_t src_width;                    /*!< Source rectangle width. Set to `0` for original image width */
+    gui_dim_t src_height;                   /*!< Source rectangle height. Set to `0` for original image height */
+    gui_dim_t width;                        /*!< Width on screen. Set to `0` for source width after rotation */
+    gui_dim_t height;                       /*!< Height on screen. Set to `0` for source height after rotation */
+    gui_image_rotate_t rotate;              /*!< Rotation of source rectangle */
+    gui_image_filter_t filter;              /*!< Filter used when size on screen is different to source size */
+} gui_image_blit_t;
+
+/**
+ * \ingroup         GUI_IMAGE
+ * \anchor          GUI_IMAGE_RLE
+ * \name            Run-length encoded image format
+ * \brief           Image data format when \ref GUI_IMAGE_FORMAT_RLE is used
+ *
+ *                  Pixels are encoded row by row for complete image (`x_size * y_size` pixels),
+ *                  runs may continue to next line. Data is sequence of runs,
+ *                  each run starts with header byte:
+ *
+ *                      - `0b0LLLLLLL`: Literal run, `L + 1` pixels follow
+ *                      - `0b1LLLLLLL`: Repeated run, single pixel follows and is repeated `L + 1` times
+ *
+ *                  Pixel is \ref gui_color_t value in ARGB8888 format stored in `4` bytes, least significant byte first
+ * \{
+ */
+
+#define GUI_IMAGE_RLE_REPEAT            ((uint8_t)0x80) /*!< Run header flag for repeated pixel */
+#define GUI_IMAGE_RLE_RUN_MAX           ((uint8_t)0x80) /*!< Maximal number of pixels in single run */
+
+/**
+ * \}
+ */
+
 /**
  * \brief           Low-level LCD command enumeration
  */
@@ -447,6 +567,9 @@ typedef struct gui_ll_t {
     void            (*DrawImage24)  (gui_lcd_t *, gui_layer_t *, const gui_image_desc_t *, void *, const void *, gui_dim_t, gui_dim_t, gui_dim_t, gui_dim_t);   /*!< Pointer to function for drawing 24BPP (RGB888) images */
     void            (*DrawImage32)  (gui_lcd_t *, gui_layer_t *, const gui_image_desc_t *, void *, const void *, gui_dim_t, gui_dim_t, gui_dim_t, gui_dim_t);   /*!< Pointer to function for drawing 32BPP (ARGB8888) images */
     void            (*CopyChar)     (gui_lcd_t *, gui_layer_t *, void *, const void *, gui_dim_t, gui_dim_t, gui_dim_t, gui_dim_t, gui_color_t);                /*!< Pointer to copy char function with alpha only as source */
+    uint8_t         (*DrawImageScaled)  (gui_lcd_t *, gui_layer_t *, const gui_image_desc_t *, const gui_image_blit_t *, const gui_display_t *, gui_dim_t, gui_dim_t);   /*!< Pointer to function for drawing scaled image at X and Y screen position, limited to clipping region.
+                                                                                                                                                        Must return `1` when image was drawn, `0` to use software drawing. Not used for trimmed images. Set to `NULL` if not supported */
+    uint8_t         (*DrawImageRotated) (gui_lcd_t *, gui_layer_t *, const gui_image_desc_t *, const gui_image_blit_t *, const gui_display_t *, gui_dim_t, gui_dim_t);   /*!< Pointer to function for drawing rotated and optionally scaled image, parameters are the same as for `DrawImageScaled` */
 } gui_ll_t;
 
 /**
@@ -461,12 +584,21 @@ typedef struct gui_ll_t {
 typedef struct {
     uint8_t x_size;                         /*!< Character x size in units of pixels */
     uint8_t y_size;                         /*!< Character y size in units of pixels */
-    uint8_t x_pos;                          /*!< Character relative x offset in units of pixels */
+    uint8_t x_pos;                          /*!< Character relative x offset (left bearing) in units of pixels */
     uint8_t y_pos;                          /*!< Character relative y offset in units of pixels */
     uint8_t x_margin;                       /*!< Right margin after character in units of pixels. Should be set to 0 if unknown */
     const uint8_t* data;                    /*!< Pointer to actual data for font */
 } gui_font_char_t;
 
+/**
+ * \brief           Kerning pair, horizontal offset between 2 characters
+ */
+typedef struct {
+    uint16_t left;                          /*!< Left character code */
+    uint16_t right;                         /*!< Right character code */
+    int8_t offset;                          /*!< Offset added to left character advance in units of pixels */
+} gui_font_kern_t;
+
 /**
  * \brief           FONT structure for writing usage
  */
@@ -477,24 +609,116 @@ typedef struct {
     uint16_t endchar;                       /*!< End character number in list */
     uint8_t flags;                          /*!< List of flags for font */
     const gui_font_char_t* data;            /*!< Pointer to first character */
+    const uint16_t* codes;                  /*!< Optional sorted character codes for each entry in `data`, for fonts with subset of characters.
+                                                    Set to `NULL` when `data` has entries for all characters between `startchar` and `endchar` */
+    uint16_t codes_count;                   /*!< Number of entries in `codes` and `data` arrays */
+    const gui_font_kern_t* kerning;         /*!< Optional kerning pairs, sorted by left and then right character code */
+    uint16_t kerning_count;                 /*!< Number of entries in `kerning` array */
 } gui_font_t;
 
 #define GUI_FLAG_FONT_AA                ((uint8_t)0x01) /*!< Indicates anti-alliasing on font */
 #define GUI_FLAG_TEXT_RIGHTALIGN        ((uint8_t)0x02) /*!< Indicates right align text if string length is too wide for rectangle */
 #define GUI_FLAG_TEXT_MULTILINE         ((uint8_t)0x04) /*!< Indicates multi line support on widget */
 #define GUI_FLAG_TEXT_EDITMODE          ((uint8_t)0x08) /*!< Edit mode is enabled on text */
+#define GUI_FLAG_FONT_RLE               ((uint8_t)0x10) /*!< Character data are run-length encoded. Check \ref GUI_FONT_RLE for format */
+#define GUI_FLAG_FONT_AA4               ((uint8_t)0x20) /*!< Indicates anti-alliasing on font with `4` bits per pixel */
+#define GUI_FLAG_FONT_AA8               ((uint8_t)0x40) /*!< Indicates anti-alliasing on font with `8` bits per pixel */
+
+/**
+ * \anchor          GUI_FONT_RLE
+ * \name            Run-length encoded font format
+ * \brief           Character data format when \ref GUI_FLAG_FONT_RLE flag is set on font
+ *
+ *                  Pixels are encoded row by row for complete character (`x_size * y_size` pixels),
+ *                  without padding at the end of each row. Data is sequence of runs,
+ *                  each run starts with header byte:
+ *
+ *                      - `0b0LLLLLLL`: Literal run. `L + 1` pixel values follow,
+ *                          packed with bits per pixel of font, MSB first. Run ends on byte boundary
+ *                      - `0b10LLLLLL`: `L + 1` transparent pixels
+ *                      - `0b11LLLLLL`: `L + 1` solid pixels
+ *
+ *                  Pixel value has the same number of bits as in not encoded font:
+ *                  `1` bit by default, `2` bits with \ref GUI_FLAG_FONT_AA flag,
+ *                  `4` bits with \ref GUI_FLAG_FONT_AA4 and `8` bits with \ref GUI_FLAG_FONT_AA8 flag.
+ *
+ * \note            Characters are trimmed to their bounding box with `x_size`, `y_size` and `y_pos`
+ * \{
+ */
+
+#define GUI_FONT_RLE_REPEAT             ((uint8_t)0x80) /*!< Run header flag for repeated pixel value */
+#define GUI_FONT_RLE_SOLID              ((uint8_t)0x40) /*!< Run header flag for solid pixels in repeated run */
+#define GUI_FONT_RLE_LITERAL_MAX        ((uint8_t)0x80) /*!< Maximal number of pixels in single literal run */
+#define GUI_FONT_RLE_REPEAT_MAX         ((uint8_t)0x40) /*!< Maximal number of pixels in single repeated run */
+
+/**
+ * \}
+ */
 
 #if defined(GUI_INTERNAL) || __DOXYGEN__
 /**
  * \brief           Char temporary entry stored in RAM for faster copy with blending operations
  */
 typedef struct {
-    gui_linkedlist_t list;                  /*!< Linked list entry. Must always be first on the list */
+    gui_linkedlist_t list;                  /*!< Linked list entry in least recently used order. Must always be first on the list */
     const gui_font_char_t* ch;              /*!< Character value */
     const gui_font_t* font;                 /*!< Pointer to font structure */
+    size_t size;                            /*!< Allocated memory for entry and its data in units of bytes */
 } gui_font_charentry_t;
+
+/**
+ * \brief           Character data reader, returns pixel by pixel alpha values from font data
+ */
+typedef struct {
+    const uint8_t* data;                    /*!< Pointer to next data byte */
+    uint8_t bpp;                            /*!< Number of bits per pixel */
+    uint8_t rle;                            /*!< Status indicating data are run-length encoded */
+    uint8_t width;                          /*!< Character width in units of pixels */
+    uint8_t x;                              /*!< Current X position in line */
+    uint8_t byte;                           /*!< Current data byte */
+    uint8_t bits;                           /*!< Number of bits not yet read in current data byte */
+    uint8_t run;                            /*!< Number of pixels left in current run */
+    uint8_t value;                          /*!< Pixel alpha value for repeated run */
+    uint8_t repeat;                         /*!< Status indicating current run is repeated run */
+} guii_text_glyphreader_t;
+
+/**
+ * \brief           Character entries cache with hash table lookup
+ */
+typedef struct {
+    gui_font_charentry_t* table[GUI_CFG_FONT_CACHE_ENTRIES];    /*!< Open addressing hash table of entries */
+    gui_linkedlistroot_t lru;               /*!< List of entries, least recently used is first */
+    size_t count;                           /*!< Number of entries in cache */
+    size_t used;                            /*!< Memory used by entries in units of bytes */
+    uint32_t hits;                          /*!< Number of lookups with entry found */
+    uint32_t misses;                        /*!< Number of lookups with entry not found */
+    uint32_t evictions;                     /*!< Number of entries removed to make space for new ones */
+} gui_font_cache_t;
 #endif /* defined(GUI_INTERNAL) || __DOXYGEN__ */
 
+/**
+ * \brief           Character entries cache statistics
+ * \sa              gui_text_getcachestats
+ */
+typedef struct {
+    size_t entries;                         /*!< Number of entries in cache */
+    size_t used;                            /*!< Memory used by entries in units of bytes */
+    uint32_t hits;                          /*!< Number of lookups with entry found */
+    uint32_t misses;                        /*!< Number of lookups with entry not found */
+    uint32_t evictions;                     /*!< Number of entries removed to make space for new ones */
+} gui_text_cachestats_t;
+
+/**
+ * \brief           Redraw statistics of last drawn frame
+ * \sa              gui_getredrawstats
+ */
+typedef struct {
+    uint32_t frames;                        /*!< Number of frames drawn since initialization */
+    uint32_t widgets;                       /*!< Number of widgets drawn in last frame */
+    uint32_t rects;                         /*!< Number of dirty rectangles in last frame */
+    uint32_t pixels;                        /*!< Number of pixels in dirty rectangles of last frame */
+} gui_redrawstats_t;
+
 #if !__DOXYGEN__
 #define ________                        0x00
 #define _______X                        0x01
@@ -1128,6 +1352,15 @@ typedef struct {
 
 #if defined(GUI_INTERNAL) || __DOXYGEN__
 
+#define GUI_WIDGET_GRID_COLS                8   /*!< Number of grid columns of parent widget area for fast overlap reject */
+#define GUI_WIDGET_GRID_ROWS                8   /*!< Number of grid rows of parent widget area for fast overlap reject */
+#define GUI_WIDGET_GRID_ALL                 ((gui_widget_grid_t)0xFFFFFFFFFFFFFFFFULL)  /*!< Mask with all grid cells set */
+
+/**
+ * \brief           Mask of grid cells of parent widget area, one bit per cell
+ */
+typedef uint64_t gui_widget_grid_t;
+
 /**
  * \brief           Common GUI values for widgets
  */
@@ -1158,6 +1391,7 @@ typedef struct gui_handle {
     gui_dim_t abs_visible_y1;               /*!< Absolute visible top Y positon on screen for widget */
     gui_dim_t abs_visible_x2;               /*!< Absolute visible right X position on screen for widget */
     gui_dim_t abs_visible_y2;               /*!< Absolute visible bottom Y positon on screen for widget */
+    gui_widget_grid_t abs_visible_grid;     /*!< Mask of parent grid cells covered by visible part of widget */
 #endif /* GUI_CFG_USE_POS_SIZE_CACHE */
 
     uint32_t padding;                       /*!< 4-bytes long padding, each byte of one side, MSB = top padding, LSB = left padding.
@@ -1168,10 +1402,14 @@ typedef struct gui_handle {
     uint8_t alpha;                          /*!< Widget alpha relative to parent widget */
 #endif /* GUI_CFG_USE_ALPHA */
     uint32_t flags;                         /*!< All possible flags for specific widget */
+    uint32_t redraw_frame;                  /*!< Number of last frame widget was redrawn in, see \ref gui_redrawstats_t */
     gui_const gui_font_t* font;             /*!< Font used for widget drawings */
     gui_char* text;                         /*!< Pointer to widget text if exists */
     size_t textmemsize;                     /*!< Number of bytes for text when dynamically allocated */
     size_t textcursor;                      /*!< Text cursor position */
+#if GUI_CFG_USE_TEXT_CACHE || __DOXYGEN__
+    struct gui_draw_text_cache* textcache;  /*!< Text layout cache, allocated on first draw */
+#endif /* GUI_CFG_USE_TEXT_CACHE */
     gui_timer_t* timer;                     /*!< Software timer pointer */
     gui_color_t* colors;                    /*!< Pointer to allocated color memory when custom colors are used */
     
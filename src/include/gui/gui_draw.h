@@ -105,6 +105,8 @@ extern "C" {
 #define GUI_COLOR_ALPHA_95              0xF2000000  /*!< 95% alpha of selected color */
 #define GUI_COLOR_ALPHA_100             0xFF000000  /*!< 100% alpha of selected color */
 
+#define GUI_COLOR_ISOPAQUE(c)           (((c) & 0xFF000000) == 0xFF000000)  /*!< Check if ARGB8888 color has 100% alpha */
+
 #define GUI_COLOR_WIN_DARKGRAY          0xFF555555  /*!< Windows dark gray color */
 #define GUI_COLOR_WIN_MIDDLEGRAY        0xFF848484  /*!< Windows middle gray color */
 #define GUI_COLOR_WIN_LIGHTGRAY         0xFFC6C6C6  /*!< Windows light gray color */
@@ -138,6 +140,35 @@ extern "C" {
 #define GUI_DRAW_CIRCLE_BR              0x04/*!< Draw bottom left part of circle */
 #define GUI_DRAW_CIRCLE_BL              0x08/*!< Draw bottom right part of circle */
 
+/**
+ * \brief           Single character position in text layout cache
+ */
+typedef struct {
+    const gui_font_char_t* c;               /*!< Character descriptor */
+    gui_dim_t x;                            /*!< X offset from text rectangle in units of pixels */
+    gui_dim_t y;                            /*!< Y offset from text rectangle in units of pixels */
+} gui_draw_text_glyph_t;
+
+/**
+ * \brief           Text layout cache, used to draw unchanged text without processing string again
+ * \note            Cache is valid only until text content is modified
+ * \sa              gui_draw_text_t
+ */
+typedef struct gui_draw_text_cache {
+    uint8_t valid;                          /*!< Status indicating layout in cache is valid */
+    const gui_char* str;                    /*!< Text pointer used for layout */
+    const gui_font_t* font;                 /*!< Font used for layout */
+    gui_dim_t width;                        /*!< Rectangle width used for layout */
+    gui_dim_t height;                       /*!< Rectangle height used for layout */
+    gui_dim_t lineheight;                   /*!< Line height used for layout */
+    uint32_t scrolly;                       /*!< Vertical scroll used for layout */
+    uint8_t align;                          /*!< Text alignment used for layout */
+    uint8_t flags;                          /*!< Text flags used for layout */
+    gui_draw_text_glyph_t* glyphs;          /*!< Array of characters to draw */
+    size_t count;                           /*!< Number of used entries in array */
+    size_t size;                            /*!< Number of allocated entries in array */
+} gui_draw_text_cache_t;
+
 /**
  * \brief           Structure for drawing strings on widgets
  * \sa              gui_draw_text_init
@@ -154,6 +185,7 @@ typedef struct {
     gui_color_t color1;                     /*!< Color 1 */
     gui_color_t color2;                     /*!< Color 2 */
     uint32_t scrolly;                       /*!< Scroll in vertical direction */
+    gui_draw_text_cache_t* cache;           /*!< Optional layout cache. Used only when \ref GUI_CFG_USE_TEXT_CACHE is enabled */
 } gui_draw_text_t;
 
 #define GUI_FLAG_DRAW_GRAD_VER              0x01
@@ -215,12 +247,14 @@ typedef struct {
 } gui_draw_poly_t;
 
 void        gui_draw_text_init(gui_draw_text_t* f);
+void        gui_draw_text_cachefree(gui_draw_text_cache_t* cache);
 void        gui_draw_fillscreen(const gui_display_t* disp, gui_color_t color);
 void        gui_draw_setpixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_color_t color);
 gui_color_t gui_draw_getpixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y);
 void        gui_draw_vline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color);
 void        gui_draw_hline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color);
 void        gui_draw_line(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_color_t color);
+void        gui_draw_line_aa(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_color_t color);
 void        gui_draw_rectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_color_t color);
 void        gui_draw_rectangle_ex(const gui_display_t* disp, gui_draw_rect_ex_t* rect);
 void        gui_draw_filledrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_color_t color);
@@ -228,14 +262,27 @@ void        gui_draw_roundedrectangle(const gui_display_t* disp, gui_dim_t x, gu
 void        gui_draw_filledroundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color);
 void        gui_draw_circle(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, gui_color_t color);
 void        gui_draw_filledcircle(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, gui_color_t color);
+void        gui_draw_arc(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_dim_t width, int16_t start, int16_t end, gui_color_t color);
+void        gui_draw_pie(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, int16_t start, int16_t end, gui_color_t color);
+void        gui_draw_ring(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_dim_t width, gui_color_t color);
+void        gui_draw_roundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color);
+void        gui_draw_filledroundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_dim_t r, gui_color_t color);
+void        gui_draw_circle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color);
+void        gui_draw_filledcircle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t r, gui_color_t color);
 void        gui_draw_circlecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, gui_color_t color);
 void        gui_draw_filledcirclecorner(const gui_display_t* disp, gui_dim_t x0, gui_dim_t y0, gui_dim_t r, uint8_t c, uint32_t color);
 void        gui_draw_triangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1,  gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color);
 void        gui_draw_filledtriangle(const gui_display_t* disp, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2, gui_dim_t x3, gui_dim_t y3, gui_color_t color);
 void        gui_draw_image(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img);
+void        gui_draw_image_blit_init(gui_image_blit_t* blit);
+void        gui_draw_image_blit(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, const gui_image_blit_t* blit);
+void        gui_draw_image_scaled(gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, const gui_image_desc_t* img, gui_image_filter_t filter);
+void        gui_draw_image_part(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, gui_dim_t src_x, gui_dim_t src_y, gui_dim_t width, gui_dim_t height);
+void        gui_draw_image_rotated(gui_display_t* disp, gui_dim_t x, gui_dim_t y, const gui_image_desc_t* img, gui_image_rotate_t rotate);
 void        gui_draw_writetext(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_draw_text_t* draw);
 void        gui_draw_rectangle3d(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t width, gui_dim_t height, gui_draw_3d_state_t state);
 void        gui_draw_poly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color);
+void        gui_draw_filledpoly(const gui_display_t* disp, const gui_draw_poly_t* points, size_t len, gui_color_t color);
 void        gui_draw_scrollbar_init(gui_draw_sb_t* sb);
 void        gui_draw_scrollbar(const gui_display_t* disp, gui_draw_sb_t* sb);
 
@@ -60,6 +60,20 @@ typedef struct mem_region_t {
  */
 typedef mem_region_t gui_mem_region_t;
 
+/**
+ * \brief           Memory statistics
+ * \note            Sizes of blocks include block header
+ */
+typedef struct gui_mem_stats_t {
+    size_t total;                       /*!< Total size of memory for allocations in units of bytes */
+    size_t free;                        /*!< Size of free memory in units of bytes */
+    size_t min_free;                    /*!< Minimal free memory ever, set only for statistics of all regions */
+    size_t largest_free;                /*!< Size of largest possible single allocation in units of bytes */
+    size_t free_blocks;                 /*!< Number of free blocks */
+    size_t used_blocks;                 /*!< Number of allocated blocks */
+    uint8_t fragmentation;              /*!< Fragmentation of free memory in percent, `100 * (1 - largest free block / free)` */
+} gui_mem_stats_t;
+
 void* gui_mem_alloc(uint32_t size);
 void* gui_mem_realloc(void* ptr, size_t size);
 void* gui_mem_calloc(size_t num, size_t size);
@@ -67,6 +81,8 @@ void gui_mem_free(void* ptr);
 size_t gui_mem_getfree(void);
 size_t gui_mem_getfull(void);
 size_t gui_mem_getminfree(void);
+uint8_t gui_mem_getstats(gui_mem_stats_t* stats);
+uint8_t gui_mem_getregionstats(size_t region, gui_mem_stats_t* stats);
 
 uint8_t gui_mem_assignmemory(const gui_mem_region_t* regions, size_t size);
     
@@ -82,7 +82,9 @@ typedef struct {
     
     uint32_t flags;                         /*!< Core GUI flags management */
     
-    gui_display_t display;                  /*!< Clipping management */
+    gui_display_t display;                  /*!< Clipping region currently in redraw process */
+    gui_display_t display_dirty[GUI_CFG_DISPLAY_RECTS]; /*!< List of dirty rectangles to redraw on next redraw process */
+    size_t display_dirty_count;             /*!< Number of valid dirty rectangles */
     gui_display_t display_temp;             /*!< Clipping for widgets for drawing and touch, used for drawing area of current widget */
     
     gui_handle_p window_active;             /*!< Pointer to currently active window when creating new widgets */
@@ -92,7 +94,8 @@ typedef struct {
     gui_linkedlistroot_t root;              /*!< Root linked list of widgets */
     gui_timer_core_t timers;                /*!< Software structure management */
     
-    gui_linkedlistroot_t root_fonts;        /*!< Root linked list of font widgets */
+    gui_font_cache_t font_cache;            /*!< Cache of character entries for fast drawing */
+    gui_redrawstats_t redraw_stats;         /*!< Statistics of last drawn frame */
     
     gui_evt_param_t evt_param;
     gui_evt_result_t evt_result;
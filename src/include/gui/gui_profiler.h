@@ -0,0 +1,145 @@
+/**	
+ * \file            gui_profiler.h
+ * \brief           Frame profiler
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef GUI_HDR_PROFILER_H
+#define GUI_HDR_PROFILER_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gui/gui.h"
+
+/**
+ * \ingroup         GUI_UTILS
+ * \defgroup        GUI_PROFILER Frame profiler
+ * \brief           Timing of processing steps and widget drawing
+ * \{
+ *
+ * Profiler records duration of \ref gui_process steps, frame redraws and draw event of each widget
+ * to ring buffer of \ref GUI_CFG_PROFILER_EVENTS entries, together with number of pixels
+ * in clipping region and number of low-level driver calls.
+ *
+ * Events are read with \ref gui_profiler_read, for example to send them over UART on target,
+ * or written as Chrome trace-event JSON with \ref gui_profiler_exporttrace,
+ * which can be opened in `chrome://tracing` or Perfetto.
+ *
+ * \code{c}
+static void
+write_fn(const char* str, size_t len, void* arg) {
+    fwrite(str, 1, len, (FILE *)arg);
+}
+
+//Run application, then write all recorded events to file
+gui_profiler_exporttrace(write_fn, file);
+\endcode
+ *
+ * \note            Module is available when \ref GUI_CFG_USE_PROFILER is enabled
+ */
+
+/**
+ * \brief           Profiler event type
+ */
+typedef enum {
+    GUI_PROFILER_EVT_PROCESS = 0x00,            /*!< Call of \ref gui_process, recorded only when any other event happened inside */
+    GUI_PROFILER_EVT_TIMERS,                    /*!< Processing of software timers, recorded only when any timer callback was called */
+    GUI_PROFILER_EVT_TOUCH,                     /*!< Processing of touch input */
+    GUI_PROFILER_EVT_REDRAW,                    /*!< Redraw of dirty regions to drawing layer */
+    GUI_PROFILER_EVT_WIDGET,                    /*!< Draw event of single widget */
+} gui_profiler_evt_type_t;
+
+/**
+ * \brief           Single profiler event
+ */
+typedef struct {
+    gui_profiler_evt_type_t type;               /*!< Event type */
+    uint8_t depth;                              /*!< Nesting level, `0` for \ref GUI_PROFILER_EVT_PROCESS */
+    gui_id_t id;                                /*!< Widget ID for \ref GUI_PROFILER_EVT_WIDGET */
+    const gui_char* name;                       /*!< Widget type name for \ref GUI_PROFILER_EVT_WIDGET, `NULL` otherwise */
+    uint32_t start;                             /*!< Start time in units of \ref GUI_CFG_PROFILER_TIME ticks */
+    uint32_t duration;                          /*!< Duration in units of \ref GUI_CFG_PROFILER_TIME ticks */
+    uint32_t ll_calls;                          /*!< Number of low-level driver calls during event */
+    uint32_t pixels;                            /*!< Pixels in dirty rectangles for redraw or clipping region for widget */
+    uint32_t count;                             /*!< Widgets drawn for redraw or timer callbacks called for timers */
+} gui_profiler_event_t;
+
+/**
+ * \brief           Callback function to read single event
+ * \param[in]       evt: Event to read
+ * \param[in]       arg: User argument
+ * \return          `1` to continue with next event, `0` to stop reading and keep remaining events
+ */
+typedef uint8_t (*gui_profiler_read_fn)(const gui_profiler_event_t* evt, void* arg);
+
+/**
+ * \brief           Callback function to write part of exported trace
+ * \param[in]       str: Text to write, not `NULL` terminated
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in]       arg: User argument
+ */
+typedef void (*gui_profiler_write_fn)(const char* str, size_t len, void* arg);
+
+#if GUI_CFG_USE_PROFILER || __DOXYGEN__
+
+uint8_t     gui_profiler_setenabled(uint8_t en);
+uint8_t     gui_profiler_reset(void);
+uint32_t    gui_profiler_getdropped(void);
+size_t      gui_profiler_read(gui_profiler_read_fn fn, void* arg);
+size_t      gui_profiler_exporttrace(gui_profiler_write_fn fn, void* arg);
+
+#endif /* GUI_CFG_USE_PROFILER || __DOXYGEN__ */
+
+#if defined(GUI_INTERNAL) && !__DOXYGEN__
+#if GUI_CFG_USE_PROFILER
+void        guii_profiler_init(void);
+void        guii_profiler_begin(void);
+void        guii_profiler_end(gui_profiler_evt_type_t type, gui_handle_p h, uint32_t pixels, uint32_t count);
+
+#define GUI_PROFILER_BEGIN()                        guii_profiler_begin()
+#define GUI_PROFILER_END(type, h, pixels, count)    guii_profiler_end((type), (h), (pixels), (count))
+#else /* GUI_CFG_USE_PROFILER */
+#define GUI_PROFILER_BEGIN()
+#define GUI_PROFILER_END(type, h, pixels, count)
+#endif /* !GUI_CFG_USE_PROFILER */
+#endif /* defined(GUI_INTERNAL) && !__DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GUI_HDR_PROFILER_H */
@@ -0,0 +1,85 @@
+/**	
+ * \file            gui_render.h
+ * \brief           Tiled rendering of dirty regions
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef GUI_HDR_RENDER_H
+#define GUI_HDR_RENDER_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gui/gui.h"
+
+/**
+ * \ingroup         GUI_UTILS
+ * \defgroup        GUI_RENDER Tiled rendering
+ * \brief           Render dirty regions tile by tile
+ * \{
+ *
+ * Screen is split to square tiles of \ref GUI_CFG_RENDER_TILE_SIZE pixels.
+ * Dirty rectangles are binned into tiles and every dirty tile is redrawn
+ * separately with clipping region limited to dirty part of the tile.
+ * Widgets marked for redraw are collected once per frame,
+ * each tile only checks widgets from this list, see \ref GUI_CFG_RENDER_TILE_WIDGETS.
+ *
+ * When user provides scratch buffer with \ref gui_render_settilebuffer,
+ * each tile is drawn to scratch buffer first (which may be placed in fast internal RAM)
+ * and copied to drawing layer when finished.
+ *
+ * \note            Module is available when \ref GUI_CFG_USE_RENDER_TILES is enabled
+ */
+
+/**
+ * \brief           Function called to redraw widgets inside current clipping region
+ * \param[in]       h: Widget marked for redraw to draw together with its children.
+ *                      Set to `NULL` to check all widgets
+ * \return          Number of redrawn widgets
+ */
+typedef uint32_t (*gui_render_redraw_fn)(gui_handle_p h);
+
+uint8_t     gui_render_settilebuffer(void* buff, size_t size);
+
+#if defined(GUI_INTERNAL) && !__DOXYGEN__
+uint32_t    gui_render_tiles(gui_layer_t* layer, gui_render_redraw_fn redraw_fn);
+#endif /* defined(GUI_INTERNAL) && !__DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GUI_HDR_RENDER_H */
@@ -49,8 +49,16 @@ extern "C" {
 
 const gui_font_char_t *     gui_text_getchardesc(const gui_font_t* font, uint32_t ch);
 void                        gui_text_getcharsize(const gui_font_t* font, uint32_t ch, gui_dim_t* width, gui_dim_t* height);
+gui_dim_t                   gui_text_getkerning(const gui_font_t* font, uint32_t left, uint32_t right);
+uint8_t                     gui_text_getcachestats(gui_text_cachestats_t* stats);
+uint8_t                     gui_text_clearcache(void);
+
+#if defined(GUI_INTERNAL) && !__DOXYGEN__
 gui_font_charentry_t *      gui_text_getcharentry(const gui_font_t* font, const gui_font_char_t* c);
 gui_font_charentry_t *      gui_text_createcharentry(const gui_font_t* font, const gui_font_char_t* c);
+void                        guii_text_glyphreader_init(guii_text_glyphreader_t* r, const gui_font_t* font, const gui_font_char_t* c);
+uint8_t                     guii_text_glyphreader_get(guii_text_glyphreader_t* r);
+#endif /* defined(GUI_INTERNAL) && !__DOXYGEN__ */
 
 /**
  * \}
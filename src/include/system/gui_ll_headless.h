@@ -0,0 +1,99 @@
+/**
+ * \file            gui_ll_headless.h
+ * \brief           Headless low-level driver with memory frame buffer
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef GUI_HDR_LL_HEADLESS_H
+#define GUI_HDR_LL_HEADLESS_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system/gui_ll.h"
+
+/**
+ * \ingroup         GUI_LL
+ * \defgroup        GUI_LL_HEADLESS Headless driver
+ * \brief           Low-level driver for hosts without display
+ *
+ * Driver draws to frame buffers in memory with \ref GUI_LL_SOFT functions.
+ * Finished frames can be written to PPM or PNG files and input is added from code or scripts,
+ * which makes it suitable for benchmarks and regression tests on build servers.
+ *
+ * Script is a text with one command per line, empty lines and lines starting with `#` are ignored:
+ *
+ *  - `down X Y`: Touch pressed at position
+ *  - `move X Y`: Touch moved while pressed
+ *  - `up X Y`: Touch released at position
+ *  - `tap X Y`: Touch pressed and released, with processing between
+ *  - `key TEXT`: Each character of text is sent as key
+ *  - `keycode N`: Key with code `N`, such as `8` for backspace
+ *  - `process N`: Process GUI `N` times
+ *  - `wait MS`: Process GUI for `MS` milliseconds
+ *  - `dump FILE`: Write displayed frame to file, PNG when name ends with `.png`, PPM otherwise
+ *
+ * \code{c}
+gui_ll_headless_setup(480, 272, 4);         //Call before gui_init
+gui_init();
+create_widgets();
+gui_ll_headless_runscript(
+    "process 2\n"
+    "tap 100 50\n"
+    "key Hello\n"
+    "process 2\n"
+    "dump out/edit.png\n"
+);
+\endcode
+ * \{
+ */
+
+uint8_t gui_ll_headless_setup(gui_dim_t width, gui_dim_t height, uint8_t pixel_size);
+uint8_t gui_ll_headless_setdump(const char* path_format);
+const void* gui_ll_headless_getframe(void);
+uint32_t gui_ll_headless_getframecount(void);
+uint8_t gui_ll_headless_writeppm(const char* path);
+uint8_t gui_ll_headless_writepng(const char* path);
+uint8_t gui_ll_headless_touch(gui_dim_t x, gui_dim_t y, uint8_t pressed);
+uint8_t gui_ll_headless_key(uint32_t key);
+uint8_t gui_ll_headless_runscript(const char* script);
+uint8_t gui_ll_headless_runscriptfile(const char* path);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GUI_HDR_LL_HEADLESS_H */
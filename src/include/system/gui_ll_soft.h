@@ -0,0 +1,89 @@
+/**
+ * \file            gui_ll_soft.h
+ * \brief           Software low-level drawing driver for memory frame buffers
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef GUI_HDR_LL_SOFT_H
+#define GUI_HDR_LL_SOFT_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system/gui_ll.h"
+
+/**
+ * \ingroup         GUI_LL
+ * \defgroup        GUI_LL_SOFT Software driver
+ * \brief           Drawing functions for RGB565 and ARGB8888 frame buffers in memory
+ *
+ * Port calls \ref gui_ll_soft_init in \ref GUI_LL_Command_Init command,
+ * after LCD size, pixel size and layers are set.
+ * Driver then sets all drawing functions in \ref gui_ll_t structure,
+ * except `Init` function which must be set by port.
+ *
+ * Images use the same pixel layout as hardware accelerated drivers:
+ *
+ *  - `16` bits per pixel: RGB565 with red and blue swapped
+ *  - `24` bits per pixel: red, green, blue bytes
+ *  - `32` bits per pixel: red, green, blue and inverted alpha bytes
+ *
+ * \code{c}
+case GUI_LL_Command_Init: {
+    gui_ll_t* LL = (gui_ll_t *)param;
+
+    LCD->width = LCD_WIDTH;
+    LCD->height = LCD_HEIGHT;
+    LCD->pixel_size = 4;                    //ARGB8888 frame buffer
+    LCD->layer_count = LCD_LAYERS;
+    LCD->layers = layers;
+
+    gui_ll_soft_init(LCD, LL);              //Set drawing functions
+    LL->Init = lcd_init;
+    ...
+}
+\endcode
+ * \{
+ */
+
+uint8_t gui_ll_soft_init(gui_lcd_t* LCD, gui_ll_t* LL);
+const char* gui_ll_soft_getkernels(void);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GUI_HDR_LL_SOFT_H */
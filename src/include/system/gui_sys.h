@@ -65,12 +65,15 @@ typedef void (*gui_sys_thread_fn)(void *);
  
 #define GUI_SYS_PORT_CMSIS_OS               1   /*!< CMSIS-OS based port for OS systems capable of ARM CMSIS standard */
 #define GUI_SYS_PORT_WIN32                  2   /*!< WIN32 based port to use ESP library with Windows applications */
+#define GUI_SYS_PORT_POSIX                  3   /*!< POSIX based port for Linux and other UNIX-like hosts */
 
 /* Decide which port to include */
 #if GUI_CFG_SYS_PORT == GUI_SYS_PORT_CMSIS_OS
 #include "system/gui_sys_cmsis_os.h"
 #elif GUI_CFG_SYS_PORT == GUI_SYS_PORT_WIN32
 #include "system/gui_sys_win32.h"
+#elif GUI_CFG_SYS_PORT == GUI_SYS_PORT_POSIX
+#include "system/gui_sys_posix.h"
 #endif
 
 /**
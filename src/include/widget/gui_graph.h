@@ -95,6 +95,7 @@ uint8_t         gui_graph_detachdata(gui_handle_p h, gui_graph_data_p data);
 gui_graph_data_p    gui_graph_data_create(gui_id_t id, gui_graph_type_t type, size_t length);
 uint8_t             gui_graph_data_addvalue(gui_graph_data_p data, int16_t x, int16_t y);
 uint8_t             gui_graph_data_setcolor(gui_graph_data_p data, gui_color_t color);
+uint8_t             gui_graph_data_setantialias(gui_graph_data_p data, uint8_t aa);
 gui_graph_data_p    gui_graph_data_get_by_id(gui_handle_p graph_h, gui_id_t id);
 
  
@@ -301,6 +301,15 @@ extern "C" {
  */
 #define guii_widget_isdialogbase(h)                 (!!(guii_widget_getcoreflag(h, GUI_FLAG_WIDGET_DIALOG_BASE) || guii_widget_getflag(h, GUI_FLAG_WIDGET_DIALOG_BASE)))
 
+/**
+ * \brief           Check if widget fully paints its rectangle with opaque pixels
+ * \note            The function is private and can be called only when GUI protection against multiple access is activated
+ * \param[in]       h: Widget handle
+ * \return          `1` on success, `0` otherwise
+ * \hideinitializer
+ */
+#define guii_widget_isopaque(h)                     (!!guii_widget_getflag(h, GUI_FLAG_WIDGET_OPAQUE) && !guii_widget_hasalpha(h))
+
 /**
  * \brief           Checks if widget handle is currently in focus
  * \note            The function is private and can be called only when GUI protection against multiple access is activated
@@ -335,6 +344,7 @@ uint8_t         guii_widget_setparam(gui_handle_p h, uint16_t cfg, const void* d
 uint8_t         guii_widget_getparam(gui_handle_p h, uint16_t cfg, void* data);
 gui_dim_t       guii_widget_getparentabsolutex(gui_handle_p h);
 gui_dim_t       guii_widget_getparentabsolutey(gui_handle_p h);
+gui_draw_text_cache_t * guii_widget_gettextcache(gui_handle_p h);
 
 /**
  * \}
@@ -481,6 +491,7 @@ uint8_t         gui_widget_force_invalidate(gui_handle_p h);
 uint8_t         gui_widget_invalidatewithparent(gui_handle_p h);
 uint8_t         gui_widget_setignoreinvalidate(gui_handle_p h, uint8_t en, uint8_t invalidate);
 uint8_t         gui_widget_setinvalidatewithparent(gui_handle_p h, uint8_t value);
+uint8_t         gui_widget_setopaque(gui_handle_p h, uint8_t opaque);
 uint8_t         gui_widget_setuserdata(gui_handle_p h, void* const data);
 void *          gui_widget_getuserdata(gui_handle_p h);
 uint8_t         gui_widget_ischildof(gui_handle_p h, gui_handle_p parent);
@@ -542,6 +553,9 @@ void guii_widget_init(void);
 
 //Clipping regions
 uint8_t guii_widget_isinsideclippingregion(gui_handle_p h, uint8_t check_sib_cover);
+uint8_t guii_widget_clipopaquechildren(gui_handle_p h, gui_display_t* disp);
+gui_widget_grid_t guii_widget_getgridmask(gui_handle_p parent, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2);
+gui_widget_grid_t guii_widget_getgrid(gui_handle_p h);
 
 //Move widget down and all its parents with it
 void guii_widget_movedowntree(gui_handle_p h);
@@ -553,6 +567,9 @@ void guii_widget_active_set(gui_handle_p h);
 
 //Execute actual widget remove process
 uint8_t guii_widget_executeremove(void);
+
+//Recalculate pending absolute values
+uint8_t guii_widget_layout(void);
 #endif /* !__DOXYGEN__ */
 
 /**
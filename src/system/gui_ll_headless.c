@@ -0,0 +1,622 @@
+/**
+ * \file            gui_ll_headless.c
+ * \brief           Headless low-level driver with memory frame buffer
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#include "system/gui_ll_headless.h"
+#include "system/gui_ll_soft.h"
+#include "gui/gui_mem.h"
+#include "gui/gui_input.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !__DOXYGEN__
+
+#ifndef GUI_LL_HEADLESS_MEM_SIZE
+#define GUI_LL_HEADLESS_MEM_SIZE            0x400000    /* Memory assigned to GUI heap */
+#endif
+
+#define LCD_LAYERS                          2
+
+static gui_dim_t lcd_width = 800, lcd_height = 480;
+static uint8_t lcd_pixel_size = 4;
+
+static gui_layer_t layers[LCD_LAYERS];
+static gui_layer_t* displayed;                  /* Layer shown on virtual display */
+static uint32_t frame_count;
+static char dump_format[256];                   /* Path format for automatic frame dumps */
+static gui_touch_data_t touch;                  /* Last touch state */
+
+/**
+ * \brief           Read pixel from displayed frame as 8-bit red, green and blue
+ */
+static void
+get_rgb(const uint8_t* fb, size_t index, uint8_t* rgb) {
+    if (lcd_pixel_size == 4) {
+        uint32_t c = ((const uint32_t *)fb)[index];
+        rgb[0] = (uint8_t)(c >> 16);
+        rgb[1] = (uint8_t)(c >> 8);
+        rgb[2] = (uint8_t)c;
+    } else {
+        uint16_t c = ((const uint16_t *)fb)[index];
+        rgb[0] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+        rgb[1] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+        rgb[2] = (uint8_t)((c & 0x1F) * 255 / 31);
+    }
+}
+
+/**
+ * \brief           Calculate CRC-32 used in PNG chunks
+ */
+static uint32_t
+png_crc(uint32_t crc, const uint8_t* data, size_t len) {
+    static uint32_t table[256];
+    uint32_t c;
+    size_t i, k;
+
+    if (table[1] == 0) {                        /* Build table on first use */
+        for (i = 0; i < 256; i++) {
+            c = (uint32_t)i;
+            for (k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    for (i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * \brief           Write 32-bit big endian value
+ */
+static void
+put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/**
+ * \brief           Write PNG chunk with length and CRC
+ */
+static void
+png_chunk(FILE* f, const char* type, const uint8_t* data, size_t len) {
+    uint8_t b[4];
+    uint32_t crc;
+
+    put_u32(b, (uint32_t)len);
+    fwrite(b, 1, 4, f);
+    fwrite(type, 1, 4, f);
+    if (len) {
+        fwrite(data, 1, len, f);
+    }
+    crc = png_crc(png_crc(0, (const uint8_t *)type, 4), data, len);
+    put_u32(b, crc);
+    fwrite(b, 1, 4, f);
+}
+
+/**
+ * \brief           Check if string ends with extension, case sensitive
+ */
+static uint8_t
+has_extension(const char* path, const char* ext) {
+    size_t len = strlen(path), elen = strlen(ext);
+    return len >= elen && !strcmp(path + len - elen, ext);
+}
+
+/**
+ * \brief           Let GUI process pending events once
+ */
+static void
+process_gui(void) {
+#if GUI_CFG_OS
+    gui_delay(20);                              /* GUI thread processes events */
+#else /* GUI_CFG_OS */
+    gui_process();
+#endif /* !GUI_CFG_OS */
+}
+
+/**
+ * \brief           Check if dump path format has exactly one `%u` conversion
+ * \note            Flags `0` and `-` and field width are allowed, `%%` is printed as `%`
+ * \param[in]       format: Path format to check
+ * \return          `1` if format is valid, `0` otherwise
+ */
+static uint8_t
+is_dump_format_valid(const char* format) {
+    uint8_t count = 0;
+
+    for (; *format; format++) {
+        if (*format != '%') {
+            continue;
+        }
+        format++;
+        if (*format == '%') {                   /* Escaped percent sign */
+            continue;
+        }
+        while (*format == '0' || *format == '-') {
+            format++;
+        }
+        while (*format >= '0' && *format <= '9') {
+            format++;
+        }
+        if (*format != 'u') {
+            return 0;
+        }
+        count++;
+    }
+    return count == 1;
+}
+
+static void
+headless_init(gui_lcd_t* LCD) {
+    GUI_UNUSED(LCD);
+}
+
+/**
+ * \brief           Low-Level control function
+ */
+uint8_t
+gui_ll_control(gui_lcd_t* LCD, GUI_LL_Command_t cmd, void* param, void* result) {
+    switch (cmd) {
+        case GUI_LL_Command_Init: {
+            gui_ll_t* LL = (gui_ll_t *)param;
+            static gui_mem_region_t regions[1];
+            uint8_t i;
+
+            /*******************************/
+            /* Assign memory to GUI        */
+            /*******************************/
+            regions[0].start_address = malloc(GUI_LL_HEADLESS_MEM_SIZE);
+            regions[0].size = GUI_LL_HEADLESS_MEM_SIZE;
+            if (regions[0].start_address == NULL) {
+                return 1;                       /* Command processed, result stays as error */
+            }
+            gui_mem_assignmemory(regions, GUI_COUNT_OF(regions));
+
+            /*******************************/
+            /* Set up LCD data             */
+            /*******************************/
+            LCD->width = lcd_width;
+            LCD->height = lcd_height;
+            LCD->pixel_size = lcd_pixel_size;
+
+            /*******************************/
+            /* Set layers count            */
+            /*******************************/
+            LCD->layer_count = LCD_LAYERS;
+            LCD->layers = layers;
+            for (i = 0; i < LCD_LAYERS; i++) {
+                layers[i].num = i;
+                layers[i].start_address = calloc((size_t)lcd_width * lcd_height, lcd_pixel_size);
+                if (layers[i].start_address == NULL) {
+                    while (i--) {               /* Release already allocated layers */
+                        free(layers[i].start_address);
+                        layers[i].start_address = NULL;
+                    }
+                    free(regions[0].start_address);
+                    regions[0].start_address = NULL;
+                    return 1;
+                }
+            }
+            displayed = &layers[0];
+            frame_count = 0;
+
+            /*******************************/
+            /* Set up LCD drawing routines */
+            /*******************************/
+            gui_ll_soft_init(LCD, LL);          /* Software drawing functions for frame buffer */
+            LL->Init = headless_init;
+
+            if (result != NULL) {
+                *(uint8_t *)result = 0;         /* Successful initialization */
+            }
+            return 1;
+        }
+        case GUI_LL_Command_SetActiveLayer: {   /* Drawing finished, show new layer */
+            gui_layer_t* layer = *(gui_layer_t **)param;
+
+            displayed = layer;
+            frame_count++;
+            if (dump_format[0]) {               /* Write each frame to file */
+                char path[sizeof(dump_format) + 16];
+                int len = snprintf(path, sizeof(path), dump_format, (unsigned)frame_count);
+                if (len < 0 || (size_t)len >= sizeof(path)) {
+                    /* Path does not fit, skip frame */
+                } else if (has_extension(path, ".png")) {
+                    gui_ll_headless_writepng(path);
+                } else {
+                    gui_ll_headless_writeppm(path);
+                }
+            }
+            if (result != NULL) {
+                *(uint8_t *)result = 0;
+            }
+            gui_lcd_confirmactivelayer(layer->num); /* Virtual display switches immediately */
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \brief           Set virtual display size and pixel format
+ * \note            Function must be called before \ref gui_init, default is `800x480` with `4` bytes per pixel
+ * \param[in]       width: Display width in units of pixels
+ * \param[in]       height: Display height in units of pixels
+ * \param[in]       pixel_size: Bytes per pixel, `2` for RGB565 or `4` for ARGB8888
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_setup(gui_dim_t width, gui_dim_t height, uint8_t pixel_size) {
+    if (width <= 0 || height <= 0 || (pixel_size != 2 && pixel_size != 4)) {
+        return 0;
+    }
+    lcd_width = width;
+    lcd_height = height;
+    lcd_pixel_size = pixel_size;
+    return 1;
+}
+
+/**
+ * \brief           Enable or disable writing of each finished frame to file
+ * \param[in]       path_format: `printf` format with frame number as `unsigned` argument,
+ *                      such as `frames/frame_%05u.png`. Format must contain exactly one `%u` conversion.
+ *                      Files ending with `.png` are written as PNG, others as PPM. Set to `NULL` to disable
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_setdump(const char* path_format) {
+    if (path_format == NULL) {
+        dump_format[0] = 0;
+        return 1;
+    }
+    if (strlen(path_format) >= sizeof(dump_format) || !is_dump_format_valid(path_format)) {
+        return 0;
+    }
+    strcpy(dump_format, path_format);
+    return 1;
+}
+
+/**
+ * \brief           Get memory of displayed frame
+ * \return          Pointer to frame buffer with `width * height` pixels, `NULL` before initialization
+ */
+const void*
+gui_ll_headless_getframe(void) {
+    return displayed != NULL ? displayed->start_address : NULL;
+}
+
+/**
+ * \brief           Get number of frames finished since initialization
+ * \return          Number of frames
+ */
+uint32_t
+gui_ll_headless_getframecount(void) {
+    return frame_count;
+}
+
+/**
+ * \brief           Write displayed frame to binary PPM file
+ * \param[in]       path: File path
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_writeppm(const char* path) {
+    const uint8_t* fb = gui_ll_headless_getframe();
+    uint8_t rgb[3];
+    size_t i, count = (size_t)lcd_width * lcd_height;
+    FILE* f;
+
+    if (fb == NULL || (f = fopen(path, "wb")) == NULL) {
+        return 0;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", (int)lcd_width, (int)lcd_height);
+    for (i = 0; i < count; i++) {
+        get_rgb(fb, i, rgb);
+        fwrite(rgb, 1, 3, f);
+    }
+    return fclose(f) == 0;
+}
+
+/**
+ * \brief           Write displayed frame to PNG file
+ * \note            Image data is stored without compression,
+ *                  files are larger but no compression library is required
+ * \param[in]       path: File path
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_writepng(const char* path) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const uint8_t* fb = gui_ll_headless_getframe();
+    size_t row_len = 1 + 3 * (size_t)lcd_width;     /* Filter byte and RGB pixels */
+    size_t raw_len = row_len * lcd_height;
+    size_t blocks = (raw_len + 0xFFFE) / 0xFFFF;    /* Stored deflate blocks */
+    size_t i, pos, len, out;
+    uint32_t s1 = 1, s2 = 0;
+    uint8_t* idat, *raw, hdr[13];
+    FILE* f;
+
+    if (fb == NULL) {
+        return 0;
+    }
+    raw = malloc(raw_len);
+    idat = malloc(2 + raw_len + 5 * blocks + 4);
+    if (raw == NULL || idat == NULL) {
+        free(raw);
+        free(idat);
+        return 0;
+    }
+
+    /* Prepare rows without filter */
+    for (pos = 0, i = 0; pos < raw_len; pos += row_len) {
+        raw[pos] = 0;
+        for (len = 1; len < row_len; len += 3, i++) {
+            get_rgb(fb, i, &raw[pos + len]);
+        }
+    }
+
+    /* Zlib stream with stored blocks and Adler-32 checksum */
+    out = 0;
+    idat[out++] = 0x78;
+    idat[out++] = 0x01;
+    for (pos = 0; pos < raw_len; pos += len) {
+        len = raw_len - pos > 0xFFFF ? 0xFFFF : raw_len - pos;
+        idat[out++] = pos + len == raw_len;         /* Final block flag */
+        idat[out++] = (uint8_t)len;
+        idat[out++] = (uint8_t)(len >> 8);
+        idat[out++] = (uint8_t)~len;
+        idat[out++] = (uint8_t)(~len >> 8);
+        memcpy(&idat[out], &raw[pos], len);
+        out += len;
+    }
+    for (i = 0; i < raw_len; i++) {
+        s1 = (s1 + raw[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    put_u32(&idat[out], (s2 << 16) | s1);
+    out += 4;
+
+    put_u32(&hdr[0], (uint32_t)lcd_width);
+    put_u32(&hdr[4], (uint32_t)lcd_height);
+    hdr[8] = 8;                                     /* Bit depth */
+    hdr[9] = 2;                                     /* Truecolor */
+    hdr[10] = hdr[11] = hdr[12] = 0;                /* Compression, filter, no interlace */
+
+    if ((f = fopen(path, "wb")) != NULL) {
+        fwrite(signature, 1, sizeof(signature), f);
+        png_chunk(f, "IHDR", hdr, sizeof(hdr));
+        png_chunk(f, "IDAT", idat, out);
+        png_chunk(f, "IEND", NULL, 0);
+    }
+    free(raw);
+    free(idat);
+    return f != NULL && fclose(f) == 0;
+}
+
+/**
+ * \brief           Add touch event at position
+ * \param[in]       x: X position on display
+ * \param[in]       y: Y position on display
+ * \param[in]       pressed: Set to `1` when touch is pressed or moved, `0` when released
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_touch(gui_dim_t x, gui_dim_t y, uint8_t pressed) {
+    uint8_t ret;
+
+    GUI_CORE_PROTECT(1);                        /* Input buffer is read by GUI thread */
+    touch.count = pressed ? 1 : 0;
+    touch.status = pressed ? GUI_TOUCH_STATE_PRESSED : GUI_TOUCH_STATE_RELEASED;
+    touch.x[0] = x;
+    touch.y[0] = y;
+    ret = gui_input_touchadd(&touch);
+    GUI_CORE_UNPROTECT(1);
+    return ret;
+}
+
+/**
+ * \brief           Add key event
+ * \param[in]       key: Key code, such as character or one of `GUI_KEY_*` values.
+ *                      Encoded as UTF-8 when \ref GUI_CFG_USE_UNICODE is enabled
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_key(uint32_t key) {
+    gui_keyboard_data_t kb;
+    uint8_t ret;
+
+    memset(&kb, 0x00, sizeof(kb));
+#if GUI_CFG_USE_UNICODE
+    if (key < 0x80) {
+        kb.keys[0] = (gui_char)key;
+    } else if (key < 0x800) {
+        kb.keys[0] = (gui_char)(0xC0 | (key >> 6));
+        kb.keys[1] = (gui_char)(0x80 | (key & 0x3F));
+    } else if (key < 0x10000) {
+        kb.keys[0] = (gui_char)(0xE0 | (key >> 12));
+        kb.keys[1] = (gui_char)(0x80 | ((key >> 6) & 0x3F));
+        kb.keys[2] = (gui_char)(0x80 | (key & 0x3F));
+    } else {
+        kb.keys[0] = (gui_char)(0xF0 | (key >> 18));
+        kb.keys[1] = (gui_char)(0x80 | ((key >> 12) & 0x3F));
+        kb.keys[2] = (gui_char)(0x80 | ((key >> 6) & 0x3F));
+        kb.keys[3] = (gui_char)(0x80 | (key & 0x3F));
+    }
+#else /* GUI_CFG_USE_UNICODE */
+    kb.keys[0] = (gui_char)key;
+#endif /* !GUI_CFG_USE_UNICODE */
+    GUI_CORE_PROTECT(1);
+    ret = gui_input_keyadd(&kb);
+    GUI_CORE_UNPROTECT(1);
+    return ret;
+}
+
+/**
+ * \brief           Run input script
+ * \note            Script commands are described in \ref GUI_LL_HEADLESS module
+ * \param[in]       script: Script text, lines separated with `\n`
+ * \return          `1` on success, `0` on unknown command or invalid arguments
+ */
+uint8_t
+gui_ll_headless_runscript(const char* script) {
+    char line[256], cmd[16], arg[240];
+    const char* end;
+    size_t len;
+    int x, y, n;
+    uint32_t time;
+
+    for (; *script; script = *end ? end + 1 : end) {
+        end = strchr(script, '\n');
+        if (end == NULL) {
+            end = script + strlen(script);
+        }
+        len = (size_t)(end - script);
+        if (len >= sizeof(line)) {
+            return 0;
+        }
+        memcpy(line, script, len);
+        line[len] = 0;
+        if (len && line[len - 1] == '\r') {
+            line[--len] = 0;
+        }
+
+        arg[0] = 0;
+        n = sscanf(line, "%15s %239[^\n]", cmd, arg);
+        if (n < 1 || cmd[0] == '#') {           /* Empty line or comment */
+            continue;
+        }
+        if (!strcmp(cmd, "down") || !strcmp(cmd, "move") || !strcmp(cmd, "up") || !strcmp(cmd, "tap")) {
+            if (sscanf(arg, "%d %d", &x, &y) != 2) {
+                return 0;
+            }
+            gui_ll_headless_touch((gui_dim_t)x, (gui_dim_t)y, cmd[0] != 'u');
+            process_gui();
+            if (cmd[0] == 't') {                /* Tap releases touch */
+                gui_ll_headless_touch((gui_dim_t)x, (gui_dim_t)y, 0);
+                process_gui();
+            }
+        } else if (!strcmp(cmd, "key")) {
+            const uint8_t* s = (const uint8_t *)arg;
+            uint32_t ch;
+
+            while (*s) {
+#if GUI_CFG_USE_UNICODE
+                if (*s >= 0xF0 && s[1] && s[2] && s[3]) {
+                    ch = ((uint32_t)(s[0] & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) | ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+                    s += 4;
+                } else if (*s >= 0xE0 && s[1] && s[2]) {
+                    ch = ((uint32_t)(s[0] & 0x0F) << 12) | ((uint32_t)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+                    s += 3;
+                } else if (*s >= 0xC0 && s[1]) {
+                    ch = ((uint32_t)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+                    s += 2;
+                } else
+#endif /* GUI_CFG_USE_UNICODE */
+                {
+                    ch = *s++;
+                }
+                gui_ll_headless_key(ch);
+                process_gui();                  /* Keep input buffer from overflow */
+            }
+        } else if (!strcmp(cmd, "keycode")) {
+            if (sscanf(arg, "%i", &n) != 1) {
+                return 0;
+            }
+            gui_ll_headless_key((uint32_t)n);
+            process_gui();
+        } else if (!strcmp(cmd, "process")) {
+            if (sscanf(arg, "%d", &n) != 1) {
+                return 0;
+            }
+            while (n-- > 0) {
+                process_gui();
+            }
+        } else if (!strcmp(cmd, "wait")) {
+            if (sscanf(arg, "%d", &n) != 1) {
+                return 0;
+            }
+            time = gui_sys_now();
+            do {
+                process_gui();
+            } while ((int32_t)(gui_sys_now() - time) < n);
+        } else if (!strcmp(cmd, "dump")) {
+            if (!arg[0]) {
+                return 0;
+            }
+            GUI_CORE_PROTECT(1);                /* Frame is not modified during write */
+            n = has_extension(arg, ".png") ? gui_ll_headless_writepng(arg) : gui_ll_headless_writeppm(arg);
+            GUI_CORE_UNPROTECT(1);
+            if (!n) {
+                return 0;
+            }
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Read script from file and run it
+ * \param[in]       path: Script file path
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_ll_headless_runscriptfile(const char* path) {
+    FILE* f;
+    char* script;
+    long size;
+    uint8_t res = 0;
+
+    if ((f = fopen(path, "rb")) == NULL) {
+        return 0;
+    }
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0
+        && (script = malloc((size_t)size + 1)) != NULL) {
+        if (fread(script, 1, (size_t)size, f) == (size_t)size) {
+            script[size] = 0;
+            res = gui_ll_headless_runscript(script);
+        }
+        free(script);
+    }
+    fclose(f);
+    return res;
+}
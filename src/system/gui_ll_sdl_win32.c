@@ -31,6 +31,7 @@
  * Author:          Tilen Majerle <tilen@majerle.eu>
  */
 #include "system/gui_ll.h"
+#include "system/gui_ll_soft.h"
 #include "gui/gui_mem.h"
 #include "SDL.h"
 
@@ -158,80 +159,6 @@ my_mouse_evt(void) {
     return 0;
 }
 
-/**
- *
- */
-void
-lcd_fill(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t OffLine, gui_color_t color) {
-    gui_dim_t x, y;
-    gui_dim_t* addr = dst;
-
-    for (y = 0; y < ySize; y++) {
-        for (x = 0; x < xSize; x++) {
-            *addr++ = (uint32_t)color;
-        }
-        addr += OffLine;
-    }
-}
-
-/**
- *
- */
-void
-lcd_fillrect(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t xSize, gui_dim_t ySize, gui_color_t color) {
-    gui_dim_t xp, yp;
-    uint32_t* fb = layer->start_address;
-
-    for (yp = 0; yp < ySize; yp++) {
-        for (xp = 0; xp < xSize; xp++) {
-            fb[(y + yp) * layer->width + (x + xp)] = (uint32_t)color;
-        }
-    }
-}
-
-/**
- * \brief           Copy from source to destination
- */
-void
-lcd_copy(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
-    gui_dim_t y;
-    const uint32_t* s = src;
-    uint32_t* d = dst;
-
-    for (y = 0; y < ySize; y++) {
-        memcpy(d, s, sizeof(uint32_t) * xSize);
-        s += xSize + offLineSrc;
-        d += xSize + offLineDst;
-    }
-}
-
-void
-lcd_drawhline(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
-    lcd_fillrect(LCD, layer, x, y, length, 1, color);
-}
-
-void
-lcd_drawvline(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
-    lcd_fillrect(LCD, layer, x, y, 1, length, color);
-}
-
-void
-lcd_setpixel(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_color_t color) {
-    uint32_t* fb = layer->start_address;
-    fb[y * layer->width + x] = (uint32_t)color;
-}
-
-gui_color_t
-lcd_getpixel(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y) {
-    uint32_t* fb = layer->start_address;
-    return fb[y * layer->width + x];
-}
-
-uint8_t
-lcd_ready(gui_lcd_t* LCD) {
-    return 1;
-}
-
 /**
  * \brief           Low-Level control function
  */
@@ -271,21 +198,8 @@ gui_ll_control(gui_lcd_t* LCD, GUI_LL_Command_t cmd, void* param, void* result)
             /*******************************/
             /* Set up LCD drawing routines */
             /*******************************/
+            gui_ll_soft_init(LCD, LL);          /* Software drawing functions for frame buffer */
             LL->Init = lcd_init;                /* Must be set by user */
-            LL->GetPixel = lcd_getpixel;        /* Must be set by user */
-            LL->SetPixel = lcd_setpixel;        /* Must be set by user */
-            //
-            LL->IsReady = lcd_ready;            /* Set is ready function to indicate low-level layer has finished any transmission */
-            LL->Copy = lcd_copy;                /* Set copy memory routine */
-            LL->DrawHLine = lcd_drawhline;      /* Set drawing vertical line routine */
-            LL->DrawVLine = lcd_drawvline;      /* Set drawing horizontal line routine */
-            LL->Fill = lcd_fill;                /* Set fill screen routine */
-            LL->FillRect = lcd_fillrect;        /* Set fill rectangle routine */
-            //LL->CopyBlend = LCD_CopyBlending;   /* Set copy with blending */
-            //LL->DrawImage16 = LCD_DrawImage16;  /* Set draw function for 24bit image (RGB565) format */
-            //LL->DrawImage24 = LCD_DrawImage24;  /* Set draw function for 24bit image (RGB888) format */
-            //LL->DrawImage32 = LCD_DrawImage32;  /* Set draw function for 32bit image (ARGB8888/ABGR8888) format */
-            //LL->CopyChar = LCD_CopyChar;        /* Set draw function for char copy with alpha information */
             
             if (result != NULL) {
                 *(uint8_t *)result = 0;         /* Successful initialization */
@@ -0,0 +1,1024 @@
+/**
+ * \file            gui_ll_soft.c
+ * \brief           Software low-level drawing driver for memory frame buffers
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#include "system/gui_ll_soft.h"
+#include <string.h>
+
+#if !__DOXYGEN__
+
+/* Select SIMD kernels available for compiler target */
+#if GUI_CFG_LL_SOFT_USE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LL_SOFT_SSE2                        1
+#include <emmintrin.h>
+#if (defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))) || (defined(_MSC_VER) && _MSC_VER >= 1800)
+#define LL_SOFT_AVX2                        1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LL_SOFT_TARGET_AVX2
+#else
+#define LL_SOFT_TARGET_AVX2                 __attribute__((target("avx2")))
+#endif /* defined(_MSC_VER) */
+#endif /* AVX2 intrinsics with target attribute */
+#endif /* SSE2 */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LL_SOFT_NEON                        1
+#include <arm_neon.h>
+#endif /* NEON */
+#endif /* GUI_CFG_LL_SOFT_USE_SIMD */
+
+#ifndef LL_SOFT_SSE2
+#define LL_SOFT_SSE2                        0
+#endif
+#ifndef LL_SOFT_AVX2
+#define LL_SOFT_AVX2                        0
+#endif
+#ifndef LL_SOFT_NEON
+#define LL_SOFT_NEON                        0
+#endif
+
+#define LINE_PIXELS                         64  /* Number of pixels converted at a time for images */
+
+/**
+ * \brief           Row kernels for ARGB8888 frame buffers
+ */
+typedef struct {
+    const char* name;                       /*!< Kernels name */
+    void (*fill)(uint32_t* dst, uint32_t color, size_t count);   /*!< Fill row with color */
+    void (*blend)(uint32_t* dst, const uint32_t* src, uint8_t alpha, size_t count);  /*!< Blend row with constant alpha */
+    void (*blend_a8)(uint32_t* dst, const uint8_t* alpha, uint32_t color, size_t count); /*!< Blend color with alpha per pixel */
+    void (*blend_argb)(uint32_t* dst, const uint32_t* src, size_t count);    /*!< Blend row with source pixel alpha */
+    void (*blend_pargb)(uint32_t* dst, const uint32_t* src, size_t count);   /*!< Blend row with premultiplied source pixels */
+    void (*convert_image32)(uint32_t* dst, const uint8_t* src, size_t count);    /*!< Convert row of 32-bit image pixels to ARGB8888 */
+} soft_kernels_t;
+
+static const soft_kernels_t* kernels;
+
+/**
+ * \brief           Blend foreground color over background color
+ * \note            Each channel is calculated as `(fg * a1 + bg * (256 - a1)) >> 8`,
+ *                  SIMD kernels produce equal result
+ * \param[in]       fg: Foreground color
+ * \param[in]       bg: Background color, its alpha channel is kept
+ * \param[in]       a: Foreground alpha between `0x00` and `0xFF`
+ * \return          Blended color
+ */
+static uint32_t
+blend_pixel(uint32_t fg, uint32_t bg, uint8_t a) {
+    uint32_t rb, g, a1;
+
+    a1 = (uint32_t)a + (a >> 7);                    /* Scale alpha to 0..256 for division with shift */
+    rb = (((fg & 0x00FF00FFUL) * a1 + (bg & 0x00FF00FFUL) * (256 - a1)) >> 8) & 0x00FF00FFUL;
+    g  = (((fg & 0x0000FF00UL) * a1 + (bg & 0x0000FF00UL) * (256 - a1)) >> 8) & 0x0000FF00UL;
+    return (bg & 0xFF000000UL) | rb | g;
+}
+
+/**
+ * \brief           Blend premultiplied foreground color over background color
+ * \note            Each channel is calculated as `fg + ((bg * (256 - a1)) >> 8)`
+ * \param[in]       fg: Foreground color with channels premultiplied by its alpha
+ * \param[in]       bg: Background color, its alpha channel is kept
+ * \param[in]       a: Foreground alpha between `0x00` and `0xFF`
+ * \return          Blended color
+ */
+static uint32_t
+blend_pixel_premul(uint32_t fg, uint32_t bg, uint8_t a) {
+    uint32_t rb, g, a1;
+
+    a1 = 256 - ((uint32_t)a + (a >> 7));            /* Background weight in range 0..256 */
+    rb = ((fg & 0x00FF00FFUL) + (((bg & 0x00FF00FFUL) * a1) >> 8)) & 0x00FF00FFUL;
+    g  = ((fg & 0x0000FF00UL) + (((bg & 0x0000FF00UL) * a1) >> 8)) & 0x0000FF00UL;
+    return (bg & 0xFF000000UL) | rb | g;
+}
+
+/**
+ * \brief           Blend RGB565 foreground color over background color
+ * \param[in]       fg: Foreground color
+ * \param[in]       bg: Background color
+ * \param[in]       a: Foreground alpha between `0x00` and `0xFF`
+ * \return          Blended color
+ */
+static uint16_t
+blend_pixel16(uint16_t fg, uint16_t bg, uint8_t a) {
+    uint32_t f, b, a5;
+
+    a5 = ((uint32_t)a + 4) >> 3;                    /* Alpha in range 0..32 */
+    f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81FUL; /* Spread green to upper half word */
+    b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81FUL;
+    b = ((f * a5 + b * (32 - a5)) >> 5) & 0x07E0F81FUL;
+    return (uint16_t)(b | (b >> 16));
+}
+
+/**
+ * \brief           Convert ARGB8888 color to RGB565
+ */
+static uint16_t
+to_rgb565(uint32_t color) {
+    return (uint16_t)(((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F));
+}
+
+/**
+ * \brief           Convert RGB565 color to opaque ARGB8888
+ */
+static uint32_t
+from_rgb565(uint16_t color) {
+    uint32_t r = (color >> 11) & 0x1F, g = (color >> 5) & 0x3F, b = color & 0x1F;
+
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return 0xFF000000UL | (r << 16) | (g << 8) | b;
+}
+
+/**
+ * \brief           Convert row of 32-bit image pixels to ARGB8888
+ * \param[out]      dst: Destination ARGB8888 pixels
+ * \param[in]       src: Source image bytes, red, green, blue and inverted alpha
+ * \param[in]       count: Number of pixels to convert
+ */
+static void
+convert_image32(uint32_t* dst, const uint8_t* src, size_t count) {
+    for (; count > 0; count--, src += 4) {
+        *dst++ = ((uint32_t)(0xFF - src[3]) << 24) | ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+    }
+}
+
+/**
+ * \brief           Get number of fully transparent pixels at start of 32-bit image row
+ * \param[in]       src: Source image bytes, red, green, blue and inverted alpha
+ * \param[in]       count: Number of pixels in row
+ * \return          Number of transparent pixels
+ */
+static size_t
+image32_transparent(const uint8_t* src, size_t count) {
+    size_t n;
+
+    for (n = 0; n < count && src[4 * n + 3] == 0xFF; n++) {}
+    return n;
+}
+
+/***************************/
+/* Scalar kernels          */
+/***************************/
+static void
+scalar_fill(uint32_t* dst, uint32_t color, size_t count) {
+    for (; count >= 4; count -= 4, dst += 4) {
+        dst[0] = color;
+        dst[1] = color;
+        dst[2] = color;
+        dst[3] = color;
+    }
+    for (; count > 0; count--) {
+        *dst++ = color;
+    }
+}
+
+static void
+scalar_blend(uint32_t* dst, const uint32_t* src, uint8_t alpha, size_t count) {
+    for (; count > 0; count--, dst++) {
+        *dst = blend_pixel(*src++, *dst, alpha);
+    }
+}
+
+static void
+scalar_blend_a8(uint32_t* dst, const uint8_t* alpha, uint32_t color, size_t count) {
+    for (; count > 0; count--, dst++, alpha++) {
+        if (*alpha == 0xFF) {
+            *dst = (*dst & 0xFF000000UL) | (color & 0x00FFFFFFUL);
+        } else if (*alpha) {
+            *dst = blend_pixel(color, *dst, *alpha);
+        }
+    }
+}
+
+static void
+scalar_blend_argb(uint32_t* dst, const uint32_t* src, size_t count) {
+    uint8_t a;
+
+    for (; count > 0; count--, dst++, src++) {
+        a = (uint8_t)(*src >> 24);
+        if (a == 0xFF) {
+            *dst = (*dst & 0xFF000000UL) | (*src & 0x00FFFFFFUL);
+        } else if (a) {
+            *dst = blend_pixel(*src, *dst, a);
+        }
+    }
+}
+
+static void
+scalar_blend_pargb(uint32_t* dst, const uint32_t* src, size_t count) {
+    uint8_t a;
+
+    for (; count > 0; count--, dst++, src++) {
+        a = (uint8_t)(*src >> 24);
+        if (a == 0xFF) {
+            *dst = (*dst & 0xFF000000UL) | (*src & 0x00FFFFFFUL);
+        } else if (a) {
+            *dst = blend_pixel_premul(*src, *dst, a);
+        }
+    }
+}
+
+static const soft_kernels_t kernels_scalar = {
+    "scalar", scalar_fill, scalar_blend, scalar_blend_a8, scalar_blend_argb, scalar_blend_pargb, convert_image32
+};
+
+#if LL_SOFT_SSE2
+/***************************/
+/* SSE2 kernels            */
+/***************************/
+
+/* Blend 4 pixels, alpha values are replicated to all bytes of each pixel */
+static __m128i
+sse2_blend4(__m128i fg, __m128i bg, __m128i alpha) {
+    const __m128i zero = _mm_setzero_si128(), v256 = _mm_set1_epi16(256);
+    const __m128i amask = _mm_set1_epi32((int)0xFF000000UL);
+    __m128i a, lo, hi;
+
+    /* Pixels 0 and 1 */
+    a = _mm_unpacklo_epi8(alpha, zero);
+    a = _mm_add_epi16(a, _mm_srli_epi16(a, 7));
+    lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), a),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(v256, a)));
+
+    /* Pixels 2 and 3 */
+    a = _mm_unpackhi_epi8(alpha, zero);
+    a = _mm_add_epi16(a, _mm_srli_epi16(a, 7));
+    hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), a),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(v256, a)));
+
+    lo = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+    return _mm_or_si128(_mm_and_si128(bg, amask), _mm_andnot_si128(amask, lo));
+}
+
+/* Blend 4 premultiplied pixels, pixels with zero alpha are not drawn */
+static __m128i
+sse2_blend4_premul(__m128i fg, __m128i bg, __m128i alpha) {
+    const __m128i zero = _mm_setzero_si128(), v256 = _mm_set1_epi16(256);
+    const __m128i amask = _mm_set1_epi32((int)0xFF000000UL);
+    __m128i a, lo, hi;
+
+    /* Background weight is 256 - alpha, for pixels 0 and 1 */
+    a = _mm_unpacklo_epi8(alpha, zero);
+    a = _mm_sub_epi16(v256, _mm_add_epi16(a, _mm_srli_epi16(a, 7)));
+    lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), a), 8);
+
+    /* Pixels 2 and 3 */
+    a = _mm_unpackhi_epi8(alpha, zero);
+    a = _mm_sub_epi16(v256, _mm_add_epi16(a, _mm_srli_epi16(a, 7)));
+    hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), a), 8);
+
+    fg = _mm_andnot_si128(_mm_cmpeq_epi32(alpha, zero), fg);
+    lo = _mm_add_epi8(fg, _mm_packus_epi16(lo, hi));
+    return _mm_or_si128(_mm_and_si128(bg, amask), _mm_andnot_si128(amask, lo));
+}
+
+/* Replicate low byte of each 32-bit value to all its bytes */
+static __m128i
+sse2_spread_alpha(__m128i a) {
+    a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+    return _mm_or_si128(a, _mm_slli_epi32(a, 16));
+}
+
+static void
+sse2_fill(uint32_t* dst, uint32_t color, size_t count) {
+    __m128i c = _mm_set1_epi32((int)color);
+
+    for (; count >= 8; count -= 8, dst += 8) {
+        _mm_storeu_si128((__m128i *)dst, c);
+        _mm_storeu_si128((__m128i *)(dst + 4), c);
+    }
+    scalar_fill(dst, color, count);
+}
+
+static void
+sse2_blend(uint32_t* dst, const uint32_t* src, uint8_t alpha, size_t count) {
+    __m128i a = _mm_set1_epi8((char)alpha);
+
+    for (; count >= 4; count -= 4, dst += 4, src += 4) {
+        _mm_storeu_si128((__m128i *)dst, sse2_blend4(_mm_loadu_si128((const __m128i *)src), _mm_loadu_si128((const __m128i *)dst), a));
+    }
+    scalar_blend(dst, src, alpha, count);
+}
+
+static void
+sse2_blend_a8(uint32_t* dst, const uint8_t* alpha, uint32_t color, size_t count) {
+    const __m128i zero = _mm_setzero_si128(), amask = _mm_set1_epi32((int)0xFF000000UL);
+    __m128i c = _mm_set1_epi32((int)(color & 0x00FFFFFFUL)), a, d;
+    uint32_t a4;
+
+    for (; count >= 4; count -= 4, dst += 4, alpha += 4) {
+        memcpy(&a4, alpha, sizeof(a4));
+        if (a4 == 0) {                              /* Fully transparent */
+            continue;
+        }
+        d = _mm_loadu_si128((const __m128i *)dst);
+        if (a4 == 0xFFFFFFFFUL) {                   /* Fully opaque */
+            _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(d, amask), c));
+            continue;
+        }
+        a = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)a4), zero), zero);
+        _mm_storeu_si128((__m128i *)dst, sse2_blend4(c, d, sse2_spread_alpha(a)));
+    }
+    scalar_blend_a8(dst, alpha, color, count);
+}
+
+/* Blend row with source pixel alpha, groups of fully transparent and fully opaque pixels are not blended */
+static void
+sse2_blend_alpha(uint32_t* dst, const uint32_t* src, size_t count, uint8_t premul) {
+    const __m128i zero = _mm_setzero_si128(), amask = _mm_set1_epi32((int)0xFF000000UL);
+    __m128i s, d, a;
+
+    for (; count >= 4; count -= 4, dst += 4, src += 4) {
+        s = _mm_loadu_si128((const __m128i *)src);
+        a = _mm_and_si128(s, amask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xFFFF) {
+            continue;                               /* Fully transparent */
+        }
+        d = _mm_loadu_si128((const __m128i *)dst);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, amask)) == 0xFFFF) {   /* Fully opaque */
+            _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(d, amask), _mm_andnot_si128(amask, s)));
+            continue;
+        }
+        a = sse2_spread_alpha(_mm_srli_epi32(s, 24));
+        _mm_storeu_si128((__m128i *)dst, premul ? sse2_blend4_premul(s, d, a) : sse2_blend4(s, d, a));
+    }
+    if (premul) {
+        scalar_blend_pargb(dst, src, count);
+    } else {
+        scalar_blend_argb(dst, src, count);
+    }
+}
+
+static void
+sse2_blend_argb(uint32_t* dst, const uint32_t* src, size_t count) {
+    sse2_blend_alpha(dst, src, count, 0);
+}
+
+static void
+sse2_blend_pargb(uint32_t* dst, const uint32_t* src, size_t count) {
+    sse2_blend_alpha(dst, src, count, 1);
+}
+
+/* Swap red and blue bytes and invert alpha, pixels are loaded in little endian order */
+static void
+sse2_convert_image32(uint32_t* dst, const uint8_t* src, size_t count) {
+    const __m128i m00ff = _mm_set1_epi32(0x000000FF), mff00 = _mm_set1_epi32((int)0xFF00FF00UL);
+    const __m128i amask = _mm_set1_epi32((int)0xFF000000UL);
+    __m128i s;
+
+    for (; count >= 4; count -= 4, dst += 4, src += 16) {
+        s = _mm_loadu_si128((const __m128i *)src);
+        _mm_storeu_si128((__m128i *)dst, _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi32(_mm_and_si128(s, m00ff), 16), _mm_and_si128(_mm_srli_epi32(s, 16), m00ff)),
+            _mm_and_si128(_mm_xor_si128(s, amask), mff00)));
+    }
+    convert_image32(dst, src, count);
+}
+
+static const soft_kernels_t kernels_sse2 = {
+    "sse2", sse2_fill, sse2_blend, sse2_blend_a8, sse2_blend_argb, sse2_blend_pargb, sse2_convert_image32
+};
+#endif /* LL_SOFT_SSE2 */
+
+#if LL_SOFT_AVX2
+/***************************/
+/* AVX2 kernels            */
+/***************************/
+
+/* Blend 8 pixels, alpha values are replicated to all bytes of each pixel */
+static LL_SOFT_TARGET_AVX2 __m256i
+avx2_blend8(__m256i fg, __m256i bg, __m256i alpha) {
+    const __m256i zero = _mm256_setzero_si256(), v256 = _mm256_set1_epi16(256);
+    const __m256i amask = _mm256_set1_epi32((int)0xFF000000UL);
+    __m256i a, lo, hi;
+
+    a = _mm256_unpacklo_epi8(alpha, zero);
+    a = _mm256_add_epi16(a, _mm256_srli_epi16(a, 7));
+    lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(fg, zero), a),
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), _mm256_sub_epi16(v256, a)));
+
+    a = _mm256_unpackhi_epi8(alpha, zero);
+    a = _mm256_add_epi16(a, _mm256_srli_epi16(a, 7));
+    hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(fg, zero), a),
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), _mm256_sub_epi16(v256, a)));
+
+    /* Unpack and pack work inside 128-bit lanes, pixel order is kept */
+    lo = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+    return _mm256_or_si256(_mm256_and_si256(bg, amask), _mm256_andnot_si256(amask, lo));
+}
+
+/* Blend 8 premultiplied pixels, pixels with zero alpha are not drawn */
+static LL_SOFT_TARGET_AVX2 __m256i
+avx2_blend8_premul(__m256i fg, __m256i bg, __m256i alpha) {
+    const __m256i zero = _mm256_setzero_si256(), v256 = _mm256_set1_epi16(256);
+    const __m256i amask = _mm256_set1_epi32((int)0xFF000000UL);
+    __m256i a, lo, hi;
+
+    a = _mm256_unpacklo_epi8(alpha, zero);
+    a = _mm256_sub_epi16(v256, _mm256_add_epi16(a, _mm256_srli_epi16(a, 7)));
+    lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), a), 8);
+
+    a = _mm256_unpackhi_epi8(alpha, zero);
+    a = _mm256_sub_epi16(v256, _mm256_add_epi16(a, _mm256_srli_epi16(a, 7)));
+    hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), a), 8);
+
+    fg = _mm256_andnot_si256(_mm256_cmpeq_epi32(alpha, zero), fg);
+    lo = _mm256_add_epi8(fg, _mm256_packus_epi16(lo, hi));
+    return _mm256_or_si256(_mm256_and_si256(bg, amask), _mm256_andnot_si256(amask, lo));
+}
+
+static LL_SOFT_TARGET_AVX2 __m256i
+avx2_spread_alpha(__m256i a) {
+    return _mm256_mullo_epi32(a, _mm256_set1_epi32(0x01010101));
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_fill(uint32_t* dst, uint32_t color, size_t count) {
+    __m256i c = _mm256_set1_epi32((int)color);
+
+    for (; count >= 16; count -= 16, dst += 16) {
+        _mm256_storeu_si256((__m256i *)dst, c);
+        _mm256_storeu_si256((__m256i *)(dst + 8), c);
+    }
+    scalar_fill(dst, color, count);
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_blend(uint32_t* dst, const uint32_t* src, uint8_t alpha, size_t count) {
+    __m256i a = _mm256_set1_epi8((char)alpha);
+
+    for (; count >= 8; count -= 8, dst += 8, src += 8) {
+        _mm256_storeu_si256((__m256i *)dst, avx2_blend8(_mm256_loadu_si256((const __m256i *)src), _mm256_loadu_si256((const __m256i *)dst), a));
+    }
+    scalar_blend(dst, src, alpha, count);
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_blend_a8(uint32_t* dst, const uint8_t* alpha, uint32_t color, size_t count) {
+    const __m256i amask = _mm256_set1_epi32((int)0xFF000000UL);
+    __m256i c = _mm256_set1_epi32((int)(color & 0x00FFFFFFUL)), a, d;
+    uint32_t a8[2];
+
+    for (; count >= 8; count -= 8, dst += 8, alpha += 8) {
+        memcpy(a8, alpha, sizeof(a8));
+        if ((a8[0] | a8[1]) == 0) {                 /* Fully transparent */
+            continue;
+        }
+        d = _mm256_loadu_si256((const __m256i *)dst);
+        if ((a8[0] & a8[1]) == 0xFFFFFFFFUL) {      /* Fully opaque */
+            _mm256_storeu_si256((__m256i *)dst, _mm256_or_si256(_mm256_and_si256(d, amask), c));
+            continue;
+        }
+        a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)alpha));
+        _mm256_storeu_si256((__m256i *)dst, avx2_blend8(c, d, avx2_spread_alpha(a)));
+    }
+    scalar_blend_a8(dst, alpha, color, count);
+}
+
+/* Blend row with source pixel alpha, groups of fully transparent and fully opaque pixels are not blended */
+static LL_SOFT_TARGET_AVX2 void
+avx2_blend_alpha(uint32_t* dst, const uint32_t* src, size_t count, uint8_t premul) {
+    const __m256i zero = _mm256_setzero_si256(), amask = _mm256_set1_epi32((int)0xFF000000UL);
+    __m256i s, d, a;
+
+    for (; count >= 8; count -= 8, dst += 8, src += 8) {
+        s = _mm256_loadu_si256((const __m256i *)src);
+        a = _mm256_and_si256(s, amask);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, zero)) == -1) {
+            continue;                               /* Fully transparent */
+        }
+        d = _mm256_loadu_si256((const __m256i *)dst);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, amask)) == -1) {  /* Fully opaque */
+            _mm256_storeu_si256((__m256i *)dst, _mm256_or_si256(_mm256_and_si256(d, amask), _mm256_andnot_si256(amask, s)));
+            continue;
+        }
+        a = avx2_spread_alpha(_mm256_srli_epi32(s, 24));
+        _mm256_storeu_si256((__m256i *)dst, premul ? avx2_blend8_premul(s, d, a) : avx2_blend8(s, d, a));
+    }
+    if (premul) {
+        scalar_blend_pargb(dst, src, count);
+    } else {
+        scalar_blend_argb(dst, src, count);
+    }
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_blend_argb(uint32_t* dst, const uint32_t* src, size_t count) {
+    avx2_blend_alpha(dst, src, count, 0);
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_blend_pargb(uint32_t* dst, const uint32_t* src, size_t count) {
+    avx2_blend_alpha(dst, src, count, 1);
+}
+
+static LL_SOFT_TARGET_AVX2 void
+avx2_convert_image32(uint32_t* dst, const uint8_t* src, size_t count) {
+    const __m256i m00ff = _mm256_set1_epi32(0x000000FF), mff00 = _mm256_set1_epi32((int)0xFF00FF00UL);
+    const __m256i amask = _mm256_set1_epi32((int)0xFF000000UL);
+    __m256i s;
+
+    for (; count >= 8; count -= 8, dst += 8, src += 32) {
+        s = _mm256_loadu_si256((const __m256i *)src);
+        _mm256_storeu_si256((__m256i *)dst, _mm256_or_si256(
+            _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(s, m00ff), 16), _mm256_and_si256(_mm256_srli_epi32(s, 16), m00ff)),
+            _mm256_and_si256(_mm256_xor_si256(s, amask), mff00)));
+    }
+    convert_image32(dst, src, count);
+}
+
+static const soft_kernels_t kernels_avx2 = {
+    "avx2", avx2_fill, avx2_blend, avx2_blend_a8, avx2_blend_argb, avx2_blend_pargb, avx2_convert_image32
+};
+
+/**
+ * \brief           Check if CPU and operating system support AVX2 instructions
+ * \return          `1` if supported, `0` otherwise
+ */
+static uint8_t
+cpu_has_avx2(void) {
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return 0;
+    }
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 0x06) != 0x06) {  /* OSXSAVE and YMM state */
+        return 0;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif /* defined(_MSC_VER) */
+}
+#endif /* LL_SOFT_AVX2 */
+
+#if LL_SOFT_NEON
+/***************************/
+/* NEON kernels            */
+/***************************/
+
+/* Blend 8 pixels in planar form, alpha channel of background is kept */
+static void
+neon_blend8(uint8x8x4_t* bg, const uint8x8x4_t* fg, uint8x8_t alpha) {
+    uint16x8_t a = vaddw_u8(vmovl_u8(alpha), vshr_n_u8(alpha, 7));
+    uint16x8_t ia = vsubq_u16(vdupq_n_u16(256), a);
+    uint8_t i;
+
+    for (i = 0; i < 3; i++) {                       /* Blue, green and red channels */
+        bg->val[i] = vshrn_n_u16(vaddq_u16(vmulq_u16(vmovl_u8(fg->val[i]), a), vmulq_u16(vmovl_u8(bg->val[i]), ia)), 8);
+    }
+}
+
+/* Blend 8 premultiplied pixels in planar form, pixels with zero alpha are not drawn */
+static void
+neon_blend8_premul(uint8x8x4_t* bg, const uint8x8x4_t* fg, uint8x8_t alpha) {
+    uint16x8_t ia = vsubq_u16(vdupq_n_u16(256), vaddw_u8(vmovl_u8(alpha), vshr_n_u8(alpha, 7)));
+    uint8x8_t zero = vceq_u8(alpha, vdup_n_u8(0));
+    uint8_t i;
+
+    for (i = 0; i < 3; i++) {                       /* Blue, green and red channels */
+        bg->val[i] = vadd_u8(vbic_u8(fg->val[i], zero), vshrn_n_u16(vmulq_u16(vmovl_u8(bg->val[i]), ia), 8));
+    }
+}
+
+static void
+neon_fill(uint32_t* dst, uint32_t color, size_t count) {
+    uint32x4_t c = vdupq_n_u32(color);
+
+    for (; count >= 8; count -= 8, dst += 8) {
+        vst1q_u32(dst, c);
+        vst1q_u32(dst + 4, c);
+    }
+    scalar_fill(dst, color, count);
+}
+
+static void
+neon_blend(uint32_t* dst, const uint32_t* src, uint8_t alpha, size_t count) {
+    uint8x8x4_t d, s;
+    uint8x8_t a = vdup_n_u8(alpha);
+
+    for (; count >= 8; count -= 8, dst += 8, src += 8) {
+        d = vld4_u8((const uint8_t *)dst);
+        s = vld4_u8((const uint8_t *)src);
+        neon_blend8(&d, &s, a);
+        vst4_u8((uint8_t *)dst, d);
+    }
+    scalar_blend(dst, src, alpha, count);
+}
+
+static void
+neon_blend_a8(uint32_t* dst, const uint8_t* alpha, uint32_t color, size_t count) {
+    uint8x8x4_t d, c;
+    uint8x8_t a;
+
+    c.val[0] = vdup_n_u8((uint8_t)color);
+    c.val[1] = vdup_n_u8((uint8_t)(color >> 8));
+    c.val[2] = vdup_n_u8((uint8_t)(color >> 16));
+    c.val[3] = vdup_n_u8((uint8_t)(color >> 24));
+    for (; count >= 8; count -= 8, dst += 8, alpha += 8) {
+        a = vld1_u8(alpha);
+        d = vld4_u8((const uint8_t *)dst);
+        neon_blend8(&d, &c, a);
+        vst4_u8((uint8_t *)dst, d);
+    }
+    scalar_blend_a8(dst, alpha, color, count);
+}
+
+/* Blend row with source pixel alpha, groups of fully transparent and fully opaque pixels are not blended */
+static void
+neon_blend_alpha(uint32_t* dst, const uint32_t* src, size_t count, uint8_t premul) {
+    uint8x8x4_t d, s;
+    uint64_t a;
+
+    for (; count >= 8; count -= 8, dst += 8, src += 8) {
+        s = vld4_u8((const uint8_t *)src);
+        a = vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0);
+        if (a == 0) {
+            continue;                               /* Fully transparent */
+        }
+        d = vld4_u8((const uint8_t *)dst);
+        if (a == ~(uint64_t)0) {                    /* Fully opaque */
+            d.val[0] = s.val[0];
+            d.val[1] = s.val[1];
+            d.val[2] = s.val[2];
+        } else if (premul) {
+            neon_blend8_premul(&d, &s, s.val[3]);
+        } else {
+            neon_blend8(&d, &s, s.val[3]);
+        }
+        vst4_u8((uint8_t *)dst, d);
+    }
+    if (premul) {
+        scalar_blend_pargb(dst, src, count);
+    } else {
+        scalar_blend_argb(dst, src, count);
+    }
+}
+
+static void
+neon_blend_argb(uint32_t* dst, const uint32_t* src, size_t count) {
+    neon_blend_alpha(dst, src, count, 0);
+}
+
+static void
+neon_blend_pargb(uint32_t* dst, const uint32_t* src, size_t count) {
+    neon_blend_alpha(dst, src, count, 1);
+}
+
+static void
+neon_convert_image32(uint32_t* dst, const uint8_t* src, size_t count) {
+    uint8x8x4_t s, d;
+
+    for (; count >= 8; count -= 8, dst += 8, src += 32) {
+        s = vld4_u8(src);
+        d.val[0] = s.val[2];                        /* Blue */
+        d.val[1] = s.val[1];                        /* Green */
+        d.val[2] = s.val[0];                        /* Red */
+        d.val[3] = vmvn_u8(s.val[3]);               /* Alpha */
+        vst4_u8((uint8_t *)dst, d);
+    }
+    convert_image32(dst, src, count);
+}
+
+static const soft_kernels_t kernels_neon = {
+    "neon", neon_fill, neon_blend, neon_blend_a8, neon_blend_argb, neon_blend_pargb, neon_convert_image32
+};
+#endif /* LL_SOFT_NEON */
+
+/***************************/
+/* Driver functions        */
+/***************************/
+
+/**
+ * \brief           Get memory address of pixel on layer
+ */
+static uint8_t*
+get_address(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y) {
+    return (uint8_t *)layer->start_address + LCD->pixel_size * ((size_t)layer->width * y + x);
+}
+
+static uint8_t
+soft_ready(gui_lcd_t* LCD) {
+    GUI_UNUSED(LCD);
+    return 1;                                       /* Drawing is finished when function returns */
+}
+
+static void
+soft_fill(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLine, gui_color_t color) {
+    gui_dim_t x, y;
+
+    if (dst == NULL) {                              /* Entire layer */
+        dst = layer->start_address;
+    }
+    if (LCD->pixel_size == 4) {
+        uint32_t* d = dst;
+
+        if (offLine == 0) {                         /* Continuous memory, fill as single row */
+            kernels->fill(d, color, (size_t)xSize * ySize);
+        } else {
+            for (y = 0; y < ySize; y++, d += xSize + offLine) {
+                kernels->fill(d, color, xSize);
+            }
+        }
+    } else {
+        uint16_t* d = dst, c = to_rgb565(color);
+
+        for (y = 0; y < ySize; y++, d += offLine) {
+            for (x = 0; x < xSize; x++) {
+                *d++ = c;
+            }
+        }
+    }
+}
+
+static void
+soft_fillrect(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t xSize, gui_dim_t ySize, gui_color_t color) {
+    soft_fill(LCD, layer, get_address(LCD, layer, x, y), xSize, ySize, layer->width - xSize, color);
+}
+
+static void
+soft_drawhline(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
+    soft_fill(LCD, layer, get_address(LCD, layer, x, y), length, 1, layer->width - length, color);
+}
+
+static void
+soft_drawvline(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_dim_t length, gui_color_t color) {
+    soft_fill(LCD, layer, get_address(LCD, layer, x, y), 1, length, layer->width - 1, color);
+}
+
+static void
+soft_setpixel(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y, gui_color_t color) {
+    if (LCD->pixel_size == 4) {
+        *(uint32_t *)get_address(LCD, layer, x, y) = (uint32_t)color;
+    } else {
+        *(uint16_t *)get_address(LCD, layer, x, y) = to_rgb565(color);
+    }
+}
+
+static gui_color_t
+soft_getpixel(gui_lcd_t* LCD, gui_layer_t* layer, gui_dim_t x, gui_dim_t y) {
+    if (LCD->pixel_size == 4) {
+        return *(uint32_t *)get_address(LCD, layer, x, y);
+    }
+    return from_rgb565(*(uint16_t *)get_address(LCD, layer, x, y));
+}
+
+static void
+soft_copy(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    uint8_t* d = dst;
+    const uint8_t* s = src;
+    size_t len = (size_t)xSize * LCD->pixel_size;
+    gui_dim_t y;
+    GUI_UNUSED(layer);
+
+    if (xSize <= 0 || ySize <= 0) {
+        return;
+    }
+    if (offLineDst == 0 && offLineSrc == 0) {       /* Both areas are continuous */
+        memcpy(d, s, len * ySize);
+        return;
+    }
+    for (y = 0; y < ySize; y++) {
+        memcpy(d, s, len);
+        d += len + (size_t)offLineDst * LCD->pixel_size;
+        s += len + (size_t)offLineSrc * LCD->pixel_size;
+    }
+}
+
+static void
+soft_copyblend(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, const void* src, uint8_t alphaSrc, uint8_t alphaDst, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    gui_dim_t x, y;
+    GUI_UNUSED2(layer, alphaDst);
+
+    if (LCD->pixel_size == 4) {
+        uint32_t* d = dst;
+        const uint32_t* s = src;
+
+        for (y = 0; y < ySize; y++, d += xSize + offLineDst, s += xSize + offLineSrc) {
+            kernels->blend(d, s, alphaSrc, xSize);
+        }
+    } else {
+        uint16_t* d = dst;
+        const uint16_t* s = src;
+
+        for (y = 0; y < ySize; y++, d += offLineDst, s += offLineSrc) {
+            for (x = 0; x < xSize; x++, d++) {
+                *d = blend_pixel16(*s++, *d, alphaSrc);
+            }
+        }
+    }
+}
+
+static void
+soft_copychar(gui_lcd_t* LCD, gui_layer_t* layer, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc, gui_color_t color) {
+    const uint8_t* s = src;
+    gui_dim_t x, y;
+    GUI_UNUSED(layer);
+
+    if (LCD->pixel_size == 4) {
+        uint32_t* d = dst;
+
+        for (y = 0; y < ySize; y++, d += xSize + offLineDst, s += xSize + offLineSrc) {
+            kernels->blend_a8(d, s, color, xSize);
+        }
+    } else {
+        uint16_t* d = dst, c = to_rgb565(color);
+
+        for (y = 0; y < ySize; y++, d += offLineDst, s += offLineSrc) {
+            for (x = 0; x < xSize; x++, d++, s++) {
+                if (*s == 0xFF) {
+                    *d = c;
+                } else if (*s) {
+                    *d = blend_pixel16(c, *d, *s);
+                }
+            }
+        }
+    }
+}
+
+static void
+soft_drawimage16(gui_lcd_t* LCD, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    const uint16_t* s = src;
+    uint16_t v;
+    gui_dim_t x, y;
+    GUI_UNUSED2(layer, img);
+
+    for (y = 0; y < ySize; y++, s += offLineSrc) {
+        if (LCD->pixel_size == 4) {
+            uint32_t* d = (uint32_t *)dst + (size_t)y * (xSize + offLineDst);
+
+            for (x = 0; x < xSize; x++) {
+                v = *s++;                           /* Swap red and blue */
+                *d++ = from_rgb565((uint16_t)((v >> 11) | (v & 0x07E0) | (v << 11)));
+            }
+        } else {
+            uint16_t* d = (uint16_t *)dst + (size_t)y * (xSize + offLineDst);
+
+            for (x = 0; x < xSize; x++) {
+                v = *s++;
+                *d++ = (uint16_t)((v >> 11) | (v & 0x07E0) | (v << 11));
+            }
+        }
+    }
+}
+
+static void
+soft_drawimage24(gui_lcd_t* LCD, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    const uint8_t* s = src;
+    uint32_t c;
+    gui_dim_t x, y;
+    GUI_UNUSED2(layer, img);
+
+    for (y = 0; y < ySize; y++, s += 3 * offLineSrc) {
+        if (LCD->pixel_size == 4) {
+            uint32_t* d = (uint32_t *)dst + (size_t)y * (xSize + offLineDst);
+
+            for (x = 0; x < xSize; x++, s += 3) {
+                *d++ = 0xFF000000UL | ((uint32_t)s[0] << 16) | ((uint32_t)s[1] << 8) | s[2];
+            }
+        } else {
+            uint16_t* d = (uint16_t *)dst + (size_t)y * (xSize + offLineDst);
+
+            for (x = 0; x < xSize; x++, s += 3) {
+                c = ((uint32_t)s[0] << 16) | ((uint32_t)s[1] << 8) | s[2];
+                *d++ = to_rgb565(c);
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Draw 32-bit image with alpha channel
+ * \note            Fully transparent runs of pixels are skipped before conversion,
+ *                  row kernels skip transparent and copy opaque groups of pixels without blending
+ */
+static void
+soft_drawimage32(gui_lcd_t* LCD, gui_layer_t* layer, const gui_image_desc_t* img, void* dst, const void* src, gui_dim_t xSize, gui_dim_t ySize, gui_dim_t offLineDst, gui_dim_t offLineSrc) {
+    uint32_t line[LINE_PIXELS];
+    const uint8_t* s = src;
+    size_t x, i, len, width = (size_t)xSize;
+    gui_dim_t y;
+    uint8_t premul = img != NULL && (img->flags & GUI_IMAGE_FLAG_PREMULTIPLIED);
+    GUI_UNUSED(layer);
+
+    for (y = 0; y < ySize; y++, s += 4 * offLineSrc) {
+        uint32_t* d32 = (uint32_t *)dst + (size_t)y * (xSize + offLineDst);
+        uint16_t* d16 = (uint16_t *)dst + (size_t)y * (xSize + offLineDst);
+
+        for (x = 0; x < width; x += len, s += 4 * len) {
+            if ((len = image32_transparent(s, width - x)) > 0) {
+                continue;                           /* Skip transparent run */
+            }
+            len = width - x > LINE_PIXELS ? LINE_PIXELS : width - x;
+            kernels->convert_image32(line, s, len);
+            if (LCD->pixel_size == 4) {
+                if (premul) {
+                    kernels->blend_pargb(d32 + x, line, len);
+                } else {
+                    kernels->blend_argb(d32 + x, line, len);
+                }
+            } else {
+                for (i = 0; i < len; i++) {
+                    if (!(line[i] >> 24)) {
+                        continue;
+                    }
+                    if (premul) {
+                        d16[x + i] = to_rgb565(blend_pixel_premul(line[i], from_rgb565(d16[x + i]), (uint8_t)(line[i] >> 24)));
+                    } else {
+                        d16[x + i] = blend_pixel16(to_rgb565(line[i]), d16[x + i], (uint8_t)(line[i] >> 24));
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \brief           Set software drawing functions to low-level structure
+ * \note            Function selects fastest row kernels supported by CPU.
+ *                  `Init` function in `LL` structure is not modified
+ * \param[in]       LCD: Pointer to LCD structure with pixel size already set
+ * \param[in,out]   LL: Pointer to low-level structure to fill
+ * \return          `1` on success, `0` if pixel size is not `2` or `4` bytes
+ */
+uint8_t
+gui_ll_soft_init(gui_lcd_t* LCD, gui_ll_t* LL) {
+    if (LCD->pixel_size != 2 && LCD->pixel_size != 4) {
+        return 0;
+    }
+
+    kernels = &kernels_scalar;
+#if LL_SOFT_SSE2
+    kernels = &kernels_sse2;
+#endif /* LL_SOFT_SSE2 */
+#if LL_SOFT_AVX2
+    if (cpu_has_avx2()) {
+        kernels = &kernels_avx2;
+    }
+#endif /* LL_SOFT_AVX2 */
+#if LL_SOFT_NEON
+    kernels = &kernels_neon;
+#endif /* LL_SOFT_NEON */
+
+    LL->IsReady = soft_ready;                       /* Operations are synchronous */
+    LL->SetPixel = soft_setpixel;
+    LL->GetPixel = soft_getpixel;
+    LL->Fill = soft_fill;
+    LL->FillRect = soft_fillrect;
+    LL->DrawHLine = soft_drawhline;
+    LL->DrawVLine = soft_drawvline;
+    LL->Copy = soft_copy;
+    LL->CopyBlend = soft_copyblend;
+    LL->CopyChar = soft_copychar;
+    LL->DrawImage16 = soft_drawimage16;
+    LL->DrawImage24 = soft_drawimage24;
+    LL->DrawImage32 = soft_drawimage32;
+    return 1;
+}
+
+/**
+ * \brief           Get name of row kernels used by software driver
+ * \return          `scalar`, `sse2`, `avx2` or `neon`, `NULL` before \ref gui_ll_soft_init is called
+ */
+const char*
+gui_ll_soft_getkernels(void) {
+    return kernels != NULL ? kernels->name : NULL;
+}
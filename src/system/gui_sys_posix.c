@@ -0,0 +1,574 @@
+/**
+ * \file            gui_sys_posix.c
+ * \brief           System dependant functions for POSIX systems
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200809L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE                 200809L
+#endif
+#include "system/gui_sys.h"
+#include "string.h"
+#include "stdlib.h"
+#include <time.h>
+#if GUI_CFG_OS
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif /* defined(__linux__) */
+#endif /* GUI_CFG_OS */
+
+#if !__DOXYGEN__
+
+static struct timespec sys_start_time;
+
+/**
+ * \brief           Get number of milliseconds passed since start time
+ */
+static uint32_t
+get_elapsed(const struct timespec* start) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000L);
+}
+
+#if GUI_CFG_OS
+
+/**
+ * \brief           Counting semaphore on top of mutex and condition variable
+ *
+ *                  POSIX `sem_timedwait` only accepts realtime clock,
+ *                  condition variable can wait on monotonic clock instead
+ */
+struct gui_sys_posix_sem {
+    pthread_mutex_t mutex;                      /*!< Mutex to protect count */
+    pthread_cond_t cond;                        /*!< Signalled when count is increased */
+    size_t count;                               /*!< Number of available tokens */
+};
+
+/**
+ * \brief           Message queue with circular buffer of pointers
+ */
+struct gui_sys_posix_mbox {
+    pthread_mutex_t mutex;                      /*!< Mutex to protect queue */
+    pthread_cond_t not_empty;                   /*!< Signalled when entry is written */
+    pthread_cond_t not_full;                    /*!< Signalled when entry is read */
+    size_t in, out, count, size;
+    void* entries[1];
+};
+
+/**
+ * \brief           Start parameters for new thread
+ */
+typedef struct {
+    gui_sys_thread_fn thread_fn;                /*!< User thread function */
+    void* arg;                                  /*!< User argument */
+    const char* name;                           /*!< Thread name */
+} posix_thread_start_t;
+
+static gui_sys_mutex_t sys_mutex;               /* Mutex ID for main protection */
+
+/**
+ * \brief           Initialize condition variable to use monotonic clock for timeouts
+ */
+static uint8_t
+cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    uint8_t ret;
+
+    if (pthread_condattr_init(&attr)) {
+        return 0;
+    }
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    ret = pthread_cond_init(cond, &attr) == 0;
+    pthread_condattr_destroy(&attr);
+    return ret;
+}
+
+/**
+ * \brief           Get absolute monotonic time after timeout
+ * \param[out]      deadline: Absolute time for timed wait
+ * \param[in]       start: Start time of waiting
+ * \param[in]       timeout: Timeout in units of milliseconds
+ */
+static void
+get_deadline(struct timespec* deadline, const struct timespec* start, uint32_t timeout) {
+    deadline->tv_sec = start->tv_sec + (time_t)(timeout / 1000);
+    deadline->tv_nsec = start->tv_nsec + (long)(timeout % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+static void
+mutex_unlock_cleanup(void* mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+/**
+ * \brief           Wait for condition variable, with optional timeout
+ *
+ *                  Threads created by port only accept cancellation requests while waiting here,
+ *                  mutex is released when thread is cancelled during wait
+ *
+ * \param[in]       deadline: Absolute time to wait for or `NULL` to wait forever
+ * \return          `0` when signalled, `ETIMEDOUT` on timeout
+ */
+static int
+cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* deadline) {
+    int res, state;
+
+    pthread_cleanup_push(mutex_unlock_cleanup, mutex);
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &state);
+    if (deadline == NULL) {
+        res = pthread_cond_wait(cond, mutex);
+    } else {
+        res = pthread_cond_timedwait(cond, mutex, deadline);
+    }
+    pthread_setcancelstate(state, NULL);
+    pthread_cleanup_pop(0);
+    return res;
+}
+
+/**
+ * \brief           Entry function for all threads created by port
+ */
+static void *
+thread_entry(void* arg) {
+    posix_thread_start_t start = *(posix_thread_start_t *)arg;
+
+    free(arg);                                  /* Parameters were allocated by creator */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);   /* Cancel only while waiting */
+#if defined(__linux__)
+    if (start.name != NULL) {
+        prctl(PR_SET_NAME, start.name, 0, 0, 0);/* Name is visible to perf and debuggers */
+    }
+#endif /* defined(__linux__) */
+    start.thread_fn(start.arg);
+    return NULL;
+}
+
+#endif /* GUI_CFG_OS */
+
+uint8_t
+gui_sys_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &sys_start_time);/* Get start time */
+
+#if GUI_CFG_OS
+    gui_sys_mutex_create(&sys_mutex);
+#endif /* GUI_CFG_OS */
+    return 1;
+}
+
+uint32_t
+gui_sys_now(void) {
+    return get_elapsed(&sys_start_time);        /* Monotonic clock, not affected by system time changes */
+}
+
+/**
+ * \brief           Get current time in units of microseconds
+ *
+ *                  Use it as \ref GUI_CFG_PROFILER_TIME on host,
+ *                  together with \ref GUI_CFG_PROFILER_TIME_FREQ set to `1000000`
+ *
+ * \return          Microseconds since system initialization
+ */
+uint32_t
+gui_sys_posix_now_us(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - sys_start_time.tv_sec) * 1000000L + (now.tv_nsec - sys_start_time.tv_nsec) / 1000L);
+}
+
+#if GUI_CFG_OS
+
+uint8_t
+gui_sys_protect(void) {
+    gui_sys_mutex_lock(&sys_mutex);
+    return 1;
+}
+
+uint8_t
+gui_sys_unprotect(void) {
+    gui_sys_mutex_unlock(&sys_mutex);
+    return 1;
+}
+
+uint8_t
+gui_sys_mutex_create(gui_sys_mutex_t* p) {
+    pthread_mutexattr_t attr;
+    pthread_mutex_t* mutex;
+
+    *p = GUI_SYS_MUTEX_NULL;
+    mutex = malloc(sizeof(*mutex));
+    if (mutex == NULL) {
+        return 0;
+    }
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);  /* Core protection may be nested */
+    if (!pthread_mutex_init(mutex, &attr)) {
+        *p = mutex;
+    } else {
+        free(mutex);
+    }
+    pthread_mutexattr_destroy(&attr);
+    return *p != NULL;
+}
+
+uint8_t
+gui_sys_mutex_delete(gui_sys_mutex_t* p) {
+    pthread_mutex_destroy(*p);
+    free(*p);
+    *p = GUI_SYS_MUTEX_NULL;
+    return 1;
+}
+
+uint8_t
+gui_sys_mutex_lock(gui_sys_mutex_t* p) {
+    return pthread_mutex_lock(*p) == 0;
+}
+
+uint8_t
+gui_sys_mutex_unlock(gui_sys_mutex_t* p) {
+    return pthread_mutex_unlock(*p) == 0;
+}
+
+uint8_t
+gui_sys_mutex_isvalid(gui_sys_mutex_t* p) {
+    return *p != NULL;
+}
+
+uint8_t
+gui_sys_mutex_invalid(gui_sys_mutex_t* p) {
+    *p = GUI_SYS_MUTEX_NULL;
+    return 1;
+}
+
+uint8_t
+gui_sys_sem_create(gui_sys_sem_t* p, uint8_t cnt) {
+    struct gui_sys_posix_sem* sem;
+
+    *p = GUI_SYS_SEM_NULL;
+    sem = malloc(sizeof(*sem));
+    if (sem == NULL) {
+        return 0;
+    }
+    sem->count = cnt;
+    if (pthread_mutex_init(&sem->mutex, NULL)) {
+        free(sem);
+        return 0;
+    }
+    if (!cond_init(&sem->cond)) {
+        pthread_mutex_destroy(&sem->mutex);
+        free(sem);
+        return 0;
+    }
+    *p = sem;
+    return 1;
+}
+
+uint8_t
+gui_sys_sem_delete(gui_sys_sem_t* p) {
+    struct gui_sys_posix_sem* sem = *p;
+
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->mutex);
+    free(sem);
+    *p = GUI_SYS_SEM_NULL;
+    return 1;
+}
+
+uint32_t
+gui_sys_sem_wait(gui_sys_sem_t* p, uint32_t timeout) {
+    struct gui_sys_posix_sem* sem = *p;
+    struct timespec start, deadline;
+    int res = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);     /* Get start time */
+    get_deadline(&deadline, &start, timeout);
+
+    pthread_mutex_lock(&sem->mutex);
+    while (!sem->count && res != ETIMEDOUT) {   /* Loop protects against spurious wakeups */
+        res = cond_wait(&sem->cond, &sem->mutex, timeout ? &deadline : NULL);
+    }
+    if (!sem->count) {                          /* Timeout and still not available */
+        pthread_mutex_unlock(&sem->mutex);
+        return GUI_SYS_TIMEOUT;
+    }
+    sem->count--;
+    pthread_mutex_unlock(&sem->mutex);
+    return get_elapsed(&start);
+}
+
+uint8_t
+gui_sys_sem_release(gui_sys_sem_t* p) {
+    struct gui_sys_posix_sem* sem = *p;
+
+    pthread_mutex_lock(&sem->mutex);
+    sem->count++;
+    pthread_cond_signal(&sem->cond);            /* Wakeup one waiting thread */
+    pthread_mutex_unlock(&sem->mutex);
+    return 1;
+}
+
+uint8_t
+gui_sys_sem_isvalid(gui_sys_sem_t* p) {
+    return *p != NULL;
+}
+
+uint8_t
+gui_sys_sem_invalid(gui_sys_sem_t* p) {
+    *p = GUI_SYS_SEM_NULL;
+    return 1;
+}
+
+uint8_t
+gui_sys_mbox_create(gui_sys_mbox_t* b, size_t size) {
+    struct gui_sys_posix_mbox* mbox;
+
+    *b = GUI_SYS_MBOX_NULL;
+    if (!size) {
+        return 0;
+    }
+    mbox = malloc(sizeof(*mbox) + (size - 1) * sizeof(void *));
+    if (mbox == NULL) {
+        return 0;
+    }
+    memset(mbox, 0x00, sizeof(*mbox));
+    mbox->size = size;
+    if (pthread_mutex_init(&mbox->mutex, NULL)) {
+        free(mbox);
+        return 0;
+    }
+    if (!cond_init(&mbox->not_empty)) {
+        pthread_mutex_destroy(&mbox->mutex);
+        free(mbox);
+        return 0;
+    }
+    if (!cond_init(&mbox->not_full)) {
+        pthread_cond_destroy(&mbox->not_empty);
+        pthread_mutex_destroy(&mbox->mutex);
+        free(mbox);
+        return 0;
+    }
+    *b = mbox;
+    return 1;
+}
+
+uint8_t
+gui_sys_mbox_delete(gui_sys_mbox_t* b) {
+    struct gui_sys_posix_mbox* mbox = *b;
+
+    pthread_mutex_lock(&mbox->mutex);
+    if (mbox->count) {                          /* Do not delete queue with pending entries */
+        pthread_mutex_unlock(&mbox->mutex);
+        return 0;
+    }
+    pthread_mutex_unlock(&mbox->mutex);
+    pthread_cond_destroy(&mbox->not_full);
+    pthread_cond_destroy(&mbox->not_empty);
+    pthread_mutex_destroy(&mbox->mutex);
+    free(mbox);
+    *b = GUI_SYS_MBOX_NULL;
+    return 1;
+}
+
+/**
+ * \brief           Write entry to queue, mutex must be locked and queue must not be full
+ */
+static void
+mbox_write(struct gui_sys_posix_mbox* mbox, void* m) {
+    mbox->entries[mbox->in] = m;
+    if (++mbox->in >= mbox->size) {
+        mbox->in = 0;
+    }
+    mbox->count++;
+    pthread_cond_signal(&mbox->not_empty);      /* Wakeup reader */
+}
+
+/**
+ * \brief           Read entry from queue, mutex must be locked and queue must not be empty
+ */
+static void
+mbox_read(struct gui_sys_posix_mbox* mbox, void** m) {
+    *m = mbox->entries[mbox->out];
+    if (++mbox->out >= mbox->size) {
+        mbox->out = 0;
+    }
+    mbox->count--;
+    pthread_cond_signal(&mbox->not_full);       /* Wakeup writer */
+}
+
+uint32_t
+gui_sys_mbox_put(gui_sys_mbox_t* b, void* m) {
+    struct gui_sys_posix_mbox* mbox = *b;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_mutex_lock(&mbox->mutex);
+    while (mbox->count >= mbox->size) {         /* Block until there is space in queue */
+        cond_wait(&mbox->not_full, &mbox->mutex, NULL);
+    }
+    mbox_write(mbox, m);
+    pthread_mutex_unlock(&mbox->mutex);
+    return get_elapsed(&start);
+}
+
+uint32_t
+gui_sys_mbox_get(gui_sys_mbox_t* b, void** m, uint32_t timeout) {
+    struct gui_sys_posix_mbox* mbox = *b;
+    struct timespec start, deadline;
+    int res = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);     /* Get start time */
+    get_deadline(&deadline, &start, timeout);
+
+    pthread_mutex_lock(&mbox->mutex);
+    while (!mbox->count && res != ETIMEDOUT) {  /* Timeout = 0 means unlimited time */
+        res = cond_wait(&mbox->not_empty, &mbox->mutex, timeout ? &deadline : NULL);
+    }
+    if (!mbox->count) {
+        pthread_mutex_unlock(&mbox->mutex);
+        return GUI_SYS_TIMEOUT;
+    }
+    mbox_read(mbox, m);
+    pthread_mutex_unlock(&mbox->mutex);
+    return get_elapsed(&start);
+}
+
+uint8_t
+gui_sys_mbox_putnow(gui_sys_mbox_t* b, void* m) {
+    struct gui_sys_posix_mbox* mbox = *b;
+    uint8_t ret = 0;
+
+    pthread_mutex_lock(&mbox->mutex);
+    if (mbox->count < mbox->size) {
+        mbox_write(mbox, m);
+        ret = 1;
+    }
+    pthread_mutex_unlock(&mbox->mutex);
+    return ret;
+}
+
+uint8_t
+gui_sys_mbox_getnow(gui_sys_mbox_t* b, void** m) {
+    struct gui_sys_posix_mbox* mbox = *b;
+    uint8_t ret = 0;
+
+    pthread_mutex_lock(&mbox->mutex);
+    if (mbox->count) {
+        mbox_read(mbox, m);
+        ret = 1;
+    }
+    pthread_mutex_unlock(&mbox->mutex);
+    return ret;
+}
+
+uint8_t
+gui_sys_mbox_isvalid(gui_sys_mbox_t* b) {
+    return *b != NULL;
+}
+
+uint8_t
+gui_sys_mbox_invalid(gui_sys_mbox_t* b) {
+    *b = GUI_SYS_MBOX_NULL;
+    return 1;
+}
+
+uint8_t
+gui_sys_thread_create(gui_sys_thread_t* t, const char* name, gui_sys_thread_fn thread_fn, void* const arg, size_t stack_size, gui_sys_thread_prio_t prio) {
+    posix_thread_start_t* start;
+    pthread_attr_t attr;
+    pthread_t* thread;
+    uint8_t ret = 0;
+
+    (void)prio;                                 /* Default scheduling policy has no priorities */
+    if (t != NULL) {
+        *t = NULL;
+    }
+    start = malloc(sizeof(*start));
+    thread = malloc(sizeof(*thread));
+    if (start == NULL || thread == NULL) {
+        free(start);
+        free(thread);
+        return 0;
+    }
+    start->thread_fn = thread_fn;
+    start->arg = arg;
+    start->name = name;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (stack_size) {                           /* Use default stack size unless set by user */
+        pthread_attr_setstacksize(&attr, stack_size < PTHREAD_STACK_MIN ? PTHREAD_STACK_MIN : stack_size);
+    }
+    if (!pthread_create(thread, &attr, thread_entry, start)) {
+        ret = 1;
+    } else {
+        free(start);
+    }
+    pthread_attr_destroy(&attr);
+
+    if (ret && t != NULL) {
+        *t = thread;
+    } else {
+        free(thread);                           /* Handle not needed by caller */
+    }
+    return ret;
+}
+
+uint8_t
+gui_sys_thread_terminate(gui_sys_thread_t* t) {
+    if (t == NULL || pthread_equal(**t, pthread_self())) {  /* Shall we terminate ourself? */
+        if (t != NULL) {
+            free(*t);
+            *t = NULL;
+        }
+        pthread_exit(NULL);
+    }
+    pthread_cancel(**t);                        /* Thread exits on next wait in port functions */
+    free(*t);
+    *t = NULL;
+    return 1;
+}
+
+uint8_t
+gui_sys_thread_yield(void) {
+    sched_yield();
+    return 1;
+}
+
+#endif /* GUI_CFG_OS */
+#endif /* !__DOXYGEN__ */
@@ -142,6 +142,7 @@ gui_button_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                 f.align = GUI_HALIGN_CENTER | GUI_VALIGN_CENTER;
                 f.color1width = f.width;
                 f.color1 = c2;
+                f.cache = guii_widget_gettextcache(h); /* Use layout cache for widget text */
                 gui_draw_writetext(disp, gui_widget_getfont(h), gui_widget_gettext(h), &f);
             }
             return 1;
@@ -59,7 +59,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("CONTAINER"),                       /*!< Widget name */
     .size = sizeof(gui_container_t),                /*!< Size of widget for memory allocation */
-    .flags = GUI_FLAG_WIDGET_ALLOW_CHILDREN,        /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_ALLOW_CHILDREN | GUI_FLAG_WIDGET_OPAQUE,   /*!< List of widget flags */
     .callback = gui_container_callback,             /*!< Control function */
     .colors = colors,                               /*!< Pointer to colors array */
     .color_count = GUI_COUNT_OF(colors),            /*!< Number of colors */
@@ -90,7 +90,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("DEBUGBOX"),                        /*!< Widget name */
     .size = sizeof(gui_debugbox_t),                 /*!< Size of widget for memory allocation */
-    .flags = 0,                                     /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_OPAQUE,                /*!< List of widget flags */
     .callback = gui_debugbox_callback,              /*!< Callback function */
     .colors = colors,                               /*!< List of default colors */
     .color_count = GUI_COUNT_OF(colors),            /*!< Define number of colors */
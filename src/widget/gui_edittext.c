@@ -87,7 +87,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("EDITTEXT"),                        /*!< Widget name */
     .size = sizeof(gui_edittext_t),                 /*!< Size of widget for memory allocation */
-    .flags = 0,                                     /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_OPAQUE,                /*!< List of widget flags */
     .callback = gui_edittext_callback,              /*!< Control function */
     .colors = colors,                               /*!< List of default colors */
     .color_count = GUI_COUNT_OF(colors),            /*!< Number of colors */
@@ -168,6 +168,7 @@ gui_edittext_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                     f.flags |= GUI_FLAG_TEXT_MULTILINE; /* Set multiline flag for widget */
                 }
                 
+                f.cache = guii_widget_gettextcache(h); /* Use layout cache for widget text */
                 gui_draw_writetext(disp, gui_widget_getfont(h), gui_widget_gettext(h), &f);
             }
             return 1;
@@ -51,6 +51,7 @@ typedef struct gui_graph_data {
     
     gui_color_t color;                              /*!< Curve color */
     gui_graph_type_t type;                          /*!< Plot data type */
+    uint8_t aa;                                     /*!< Status if curve is drawn with anti-aliased lines */
 } gui_graph_data_t;
 
 /**
@@ -234,6 +235,7 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                 gui_dim_t yBottom = y + height - bb - 1;    /* Bottom Y value */
                 gui_dim_t xLeft = x + bl;                   /* Left X position */
                 uint32_t read, write;
+                void (*draw_line)(const gui_display_t *, gui_dim_t, gui_dim_t, gui_dim_t, gui_dim_t, gui_color_t);
                 
                 memcpy(&display, disp, sizeof(gui_display_t));  /* Save GUI display data */
                 
@@ -258,6 +260,7 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                     
                     read = data->ptr;               /* Get start read pointer */
                     write = data->ptr;              /* Get start write pointer */
+                    draw_line = data->aa ? gui_draw_line_aa : gui_draw_line;
                     
                     if (data->type == GUI_GRAPH_TYPE_YT) {  /* Draw YT plot */
                         /* Calculate first point */
@@ -276,7 +279,7 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                             x2 = x1 + xStep;                /* Calculate next X */
                             y2 = yBottom - ((float)data->data[read] - g->visible_min_y) * yStep;/* Calculate next Y */
                             if ((x1 >= disp->x1 || x2 >= disp->x1) && (x1 < disp->x2 || x2 < disp->x2)) {
-                                gui_draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color);   /* Draw actual line */
+                                draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color); /* Draw actual line */
                             }
                             x1 = x2, y1 = y2;       /* Copy values as old */
                             
@@ -295,7 +298,7 @@ gui_graph_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                         while (read != write) {     /* Calculate next points */
                             x2 = xLeft + ((float)(data->data[2 * read + 0] - g->visible_min_x) * xStep);
                             y2 = yBottom - ((float)(data->data[2 * read + 1] - g->visible_min_y) * yStep);
-                            gui_draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color);   /* Draw actual line */
+                            draw_line(disp, GUI_DIM(x1), GUI_DIM(y1), GUI_DIM(x2), GUI_DIM(y2), data->color); /* Draw actual line */
                             x1 = x2, y1 = y2;       /* Check overflow */
                             
                             if (++read == data->length) {   /* Check overflow */
@@ -653,6 +656,29 @@ gui_graph_data_setcolor(gui_graph_data_p data, gui_color_t color) {
     return 1;
 }
 
+/**
+ * \brief           Set anti-aliasing for graph data curve
+ * \note            Anti-aliased curve blends line edges with pixels below,
+ *                  it is slower than normal curve on layers without direct memory access
+ * \param[in,out]   data: Graph data handle
+ * \param[in]       aa: Set to `1` to draw curve with anti-aliased lines or `0` to use normal lines
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_graph_data_setantialias(gui_graph_data_p data, uint8_t aa) {
+    GUI_ASSERTPARAMS(data != NULL);        
+
+    aa = aa ? 1 : 0;
+    if (data->aa != aa) {                           /* Check mode change */
+        data->aa = aa;                              /* Set new mode */
+#if GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE
+        graph_invalidate(data);                     /* Invalidate graphs attached to this data object */
+#endif /* GUI_CFG_WIDGET_GRAPH_DATA_AUTO_INVALIDATE */
+    }
+
+    return 1;
+}
+
 /**
  * \brief           Get data collection with specific ID from graph
  * \param[in]       graph_h: Graph widget handle
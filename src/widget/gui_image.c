@@ -42,8 +42,11 @@ typedef struct {
     gui_handle C;                                   /*!< GUI handle object, must always be first on list */
     
     const gui_image_desc_t* image;                  /*!< Pointer to image object to draw */
+    gui_image_filter_t filter;                      /*!< Filter used when image is scaled to widget size */
 } gui_image_t;
 
+#define CFG_FILTER          0x01
+
 static uint8_t gui_image_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const param, gui_evt_result_t* const result);
 
 /**
@@ -59,6 +62,25 @@ gui_widget_t widget = {
     .color_count = 0,                               /*!< Define number of colors */
 };
 
+/**
+ * \brief           Check if image covers whole widget area with opaque pixels
+ * \param[in]       img: Image descriptor or `NULL`
+ * \return          `1` if image is opaque, `0` otherwise
+ */
+static uint8_t
+image_isopaque(const gui_image_desc_t* img) {
+    if (img == NULL || GUI_IMAGE_ISTRIMMED(img)) {
+        return 0;                                   /* Widget is not fully drawn */
+    }
+    if (img->flags & GUI_IMAGE_FLAG_PREMULTIPLIED) {
+        return 0;                                   /* Premultiplied pixels are blended over parent */
+    }
+    if (img->flags & GUI_IMAGE_FLAG_OPAQUE) {
+        return 1;
+    }
+    return img->format == GUI_IMAGE_FORMAT_RAW && img->bpp != 32;   /* 16 and 24 bit images have no alpha */
+}
+
 /**
  * \brief           Default widget callback function
  * \param[in]       h: Widget handle
@@ -73,14 +95,34 @@ gui_image_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
     
     GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
     switch (evt) {
+        case GUI_EVT_SETPARAM: {                    /* Set parameter for widget */
+            gui_widget_param* p = GUI_EVT_PARAMTYPE_WIDGETPARAM(param);
+            switch (p->type) {
+                case CFG_FILTER:
+                    o->filter = *(gui_image_filter_t *)p->data; /* Set scaling filter */
+                    break;
+                default: break;
+            }
+            GUI_EVT_RESULTTYPE_U8(result) = 1;      /* Save result */
+            return 1;
+        }
         case GUI_EVT_DRAW: {
             gui_display_t* disp = GUI_EVT_PARAMTYPE_DISP(param);
-            gui_dim_t x, y;
+            gui_dim_t x, y, width, height;
 
             x = gui_widget_getabsolutex(h);
             y = gui_widget_getabsolutey(h);
+            width = gui_widget_getwidth(h);
+            height = gui_widget_getheight(h);
             
-            gui_draw_image(disp, x, y, o->image);   /* Draw actual image on screen */
+            if (o->image == NULL) {
+                return 1;
+            }
+            if (width == GUI_IMAGE_WIDTH(o->image) && height == GUI_IMAGE_HEIGHT(o->image)) {
+                gui_draw_image(disp, x, y, o->image);   /* Draw actual image on screen */
+            } else {                                /* Scale image to widget size */
+                gui_draw_image_scaled(disp, x, y, width, height, o->image, o->filter);
+            }
             return 1;
         }
         default:                                    /* Handle default option */
@@ -116,13 +158,26 @@ gui_image_create(gui_id_t id, float x, float y, float width, float height, gui_h
 uint8_t
 gui_image_setsource(gui_handle_p h, const gui_image_desc_t* img) {
     gui_image_t* o = GUI_VP(h);
-    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget && img != NULL);
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
 
     o->image = img;                                 /* Set image */
     
-    /* When alpha image is applied, invalidate parent */
-    gui_widget_setinvalidatewithparent(h, img != NULL && img->bpp == 32);
+    /* Parent is invalidated unless image covers whole widget with opaque pixels */
+    gui_widget_setinvalidatewithparent(h, !image_isopaque(img));
     gui_widget_invalidatewithparent(h);
 
     return 1;
 }
+
+/**
+ * \brief           Set filter used when image is scaled to widget size
+ * \note            Image is scaled when widget size is different to image size
+ * \param[in]       h: Widget handle
+ * \param[in]       filter: Scaling filter. Default is \ref GUI_IMAGE_FILTER_NEAREST
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_image_setfilter(gui_handle_p h, gui_image_filter_t filter) {
+    GUI_ASSERTPARAMS(h != NULL && h->widget == &widget);
+    return guii_widget_setparam(h, CFG_FILTER, &filter, 1, 0);
+}
@@ -65,7 +65,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("LIST_CONTAINER"),                  /*!< Widget name */ 
     .size = sizeof(gui_listcontainer_t),            /*!< Size of widget for memory allocation */
-    .flags = GUI_FLAG_WIDGET_ALLOW_CHILDREN | GUI_FLAG_WIDGET_INVALIDATE_PARENT,    /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_ALLOW_CHILDREN | GUI_FLAG_WIDGET_INVALIDATE_PARENT,   /*!< List of widget flags */
     .callback = gui_listcontainer_callback,         /*!< Control function */
     .colors = colors,                               /*!< List of default colors */
     .color_count = GUI_COUNT_OF(colors),            /*!< Number of colors */
@@ -239,6 +239,7 @@ gui_listcontainer_setcolor(gui_handle_p h, gui_listcontainer_color_t index, gui_
     ret = gui_widget_setcolor(h, (uint8_t)index, color);
     if (ret && index == GUI_LISTCONTAINER_COLOR_BG) {   /* Check background color */
         gui_widget_setinvalidatewithparent(h, color == GUI_COLOR_TRANS);
+        gui_widget_setopaque(h, GUI_COLOR_ISOPAQUE(color));
     }
 
     return ret;
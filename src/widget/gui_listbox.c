@@ -94,7 +94,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("LISTBOX"),                         /*!< Widget name */
     .size = sizeof(gui_listbox_t),                  /*!< Size of widget for memory allocation */
-    .flags = 0,                                     /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_OPAQUE,                /*!< List of widget flags */
     .callback = gui_listbox_callback,               /*!< Callback function */
     .colors = colors,                               /*!< List of default colors */
     .color_count = GUI_COUNT_OF(colors),            /*!< Define number of colors */
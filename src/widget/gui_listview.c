@@ -118,7 +118,7 @@ static const
 gui_widget_t widget = {
     .name = _GT("LISTVIEW"),                        /*!< Widget name */
     .size = sizeof(gui_listview_t),                 /*!< Size of widget for memory allocation */
-    .flags = 0,                                     /*!< List of widget flags */
+    .flags = GUI_FLAG_WIDGET_OPAQUE,                /*!< List of widget flags */
     .callback = gui_listview_callback,              /*!< Callback function */
     .colors = colors,                               /*!< List of default colors */
     .color_count = GUI_COUNT_OF(colors),            /*!< Define number of colors */
@@ -295,7 +295,7 @@ gui_listview_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                 
                 tmpX2 = disp->x2;                   /* Save current value */
                 if (disp->x2 > (x + width - 1)) {   /* Set clipping region */
-                    disp->x2 = x + width - 1;
+                    disp->x2 = GUI_MAX(x + width - 1, disp->x1);    /* Clipping region must not be inverted */
                 }
                 
                 /* Draw header row with columns */
@@ -316,7 +316,7 @@ gui_listview_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                     
                     tmp = disp->y2;                 /* Scale out drawing area */
                     if (disp->y2 > (y + height - 2)) {
-                        disp->y2 = y + height - 2;
+                        disp->y2 = GUI_MAX(y + height - 2, disp->y1);
                     }
                     
                     /* Draw list items */
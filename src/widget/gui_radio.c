@@ -201,6 +201,7 @@ gui_radio_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* const
                 f.align = GUI_HALIGN_LEFT | GUI_VALIGN_CENTER;
                 f.color1width = f.width;
                 f.color1 = guii_widget_getcolor(h, GUI_RADIO_COLOR_TEXT);
+                f.cache = guii_widget_gettextcache(h); /* Use layout cache for widget text */
                 gui_draw_writetext(disp, gui_widget_getfont(h), gui_widget_gettext(h), &f);
             }
             
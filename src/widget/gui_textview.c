@@ -132,6 +132,7 @@ gui_textview_callback(gui_handle_p h, gui_widget_evt_t evt, gui_evt_param_t* con
                 f.flags |= GUI_FLAG_TEXT_MULTILINE; /* Enable multiline */
                 f.color1width = f.width;
                 f.color1 = guii_widget_getcolor(h, GUI_TEXTVIEW_COLOR_TEXT);
+                f.cache = guii_widget_gettextcache(h); /* Use layout cache for widget text */
                 gui_draw_writetext(disp, gui_widget_getfont(h), gui_widget_gettext(h), &f);
             }
             return 1;
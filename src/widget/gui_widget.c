@@ -46,8 +46,17 @@ gui_widget_default_t widget_default;
 /* Widget absolute cache setup */
 #if GUI_CFG_USE_POS_SIZE_CACHE
 #define SET_WIDGET_ABS_VALUES(h)        set_widget_abs_values(h)
+#define GET_WIDGET_GRID(h)              guii_widget_getgrid(h)
 #else
 #define SET_WIDGET_ABS_VALUES(h)
+#define GET_WIDGET_GRID(h)              GUI_WIDGET_GRID_ALL
+#endif
+
+/* Widget text layout cache setup */
+#if GUI_CFG_USE_TEXT_CACHE
+#define CLEAR_WIDGET_TEXT_CACHE(h)      do { if ((h)->textcache != NULL) { (h)->textcache->valid = 0; } } while (0)
+#else
+#define CLEAR_WIDGET_TEXT_CACHE(h)
 #endif
 
 /**
@@ -87,6 +96,8 @@ calculate_widget_height(gui_handle_p h) {
     return height;
 }
 
+#if !GUI_CFG_USE_POS_SIZE_CACHE
+
 /**
  * \brief           Calculate widget absolute X position on screen in units of pixels
  * \param[in]       h: Widget handle
@@ -137,6 +148,8 @@ calculate_widget_absolute_y(gui_handle_p h) {
     return out;
 }
 
+#endif /* !GUI_CFG_USE_POS_SIZE_CACHE */
+
 /**
  * \brief           Calculates absolute visible position and size on screen.
  *                  Actual visible position may change when other widgets cover current one
@@ -179,33 +192,146 @@ calculate_widget_absolute_visible_position_size(gui_handle_p h, gui_dim_t* x1, g
 #if GUI_CFG_USE_POS_SIZE_CACHE
 
 /**
- * \brief           Set widget absolute values for position and size
+ * \brief           Non-zero while children absolute values are being recalculated.
+ *                  Getters must not try to resolve pending layout during that time
+ */
+static uint8_t layout_resolving;
+
+/**
+ * \brief           Calculate widget absolute values for position and size
+ * \note            Parent widget absolute values must already be valid,
+ *                  children widgets are not processed by this function
  * \param[in]       h: Widget handle
  */
-static uint8_t
-set_widget_abs_values(gui_handle_p h) {
-    /* Update widget absolute values */
-    h->abs_x = calculate_widget_absolute_x(h);
-    h->abs_y = calculate_widget_absolute_y(h);
+static void
+calculate_widget_abs_values(gui_handle_p h) {
+    gui_handle_p p;
+    gui_dim_t x1, y1, x2, y2;
+    
+    layout_resolving++;                             /* Getters must use cached values only */
+    
     h->abs_width = calculate_widget_width(h);
     h->abs_height = calculate_widget_height(h);
     
+    p = guii_widget_getparent(h);
+    if (p != NULL) {
+        /* Parent inner area, already clipped to parent visible area */
+        x1 = p->abs_x + gui_widget_getpaddingleft(p);
+        y1 = p->abs_y + gui_widget_getpaddingtop(p);
+        x2 = x1 + gui_widget_getinnerwidth(p);
+        y2 = y1 + gui_widget_getinnerheight(p);
+        
+        h->abs_x = x1 - p->x_scroll + guii_widget_getrelativex(h);
+        h->abs_y = y1 - p->y_scroll + guii_widget_getrelativey(h);
+        
+        if (x1 < p->abs_visible_x1) { x1 = p->abs_visible_x1; }
+        if (y1 < p->abs_visible_y1) { y1 = p->abs_visible_y1; }
+        if (x2 > p->abs_visible_x2) { x2 = p->abs_visible_x2; }
+        if (y2 > p->abs_visible_y2) { y2 = p->abs_visible_y2; }
+    } else {
+        h->abs_x = guii_widget_getrelativex(h);
+        h->abs_y = guii_widget_getrelativey(h);
+        
+        x1 = 0;
+        y1 = 0;
+        x2 = GUI.lcd.width;
+        y2 = GUI.lcd.height;
+    }
+    
     /* Calculate absolute visible position/size on screen */
-    calculate_widget_absolute_visible_position_size(h,
-        &h->abs_visible_x1, &h->abs_visible_y1,
-        &h->abs_visible_x2, &h->abs_visible_y2);
+    h->abs_visible_x1 = GUI_MAX(h->abs_x, x1);
+    h->abs_visible_y1 = GUI_MAX(h->abs_y, y1);
+    h->abs_visible_x2 = GUI_MIN(h->abs_x + h->abs_width, x2);
+    h->abs_visible_y2 = GUI_MIN(h->abs_y + h->abs_height, y2);
+    h->abs_visible_grid = guii_widget_getgridmask(p,
+        h->abs_visible_x1, h->abs_visible_y1,
+        h->abs_visible_x2 - 1, h->abs_visible_y2 - 1);
+    
+    layout_resolving--;
+}
 
-    /* Update children widgets */
-    if (guii_widget_haschildren(h)) {
-        gui_handle_p child;
-        
-        /* Scan all children widgets */
-        GUI_LINKEDLIST_WIDGETSLISTNEXT(h, child) {
-            set_widget_abs_values(child);           /* Process child widget */
+/**
+ * \brief           Recalculate absolute values of all children widgets of parent
+ * \param[in]       parent: Parent widget with pending layout
+ */
+static void
+calculate_children_abs_values(gui_handle_p parent) {
+    gui_handle_p h;
+    
+    guii_widget_clrflag(parent, GUI_FLAG_LAYOUT_DIRTY); /* Children values are valid after this call */
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        calculate_widget_abs_values(h);
+        if (guii_widget_haschildren(h)) {
+            calculate_children_abs_values(h);
+        } else {
+            guii_widget_clrflag(h, GUI_FLAG_LAYOUT_DIRTY);
         }
     }
+}
+
+/**
+ * \brief           Make sure absolute values of widget are valid
+ *
+ *                  Finds top-most parent with pending layout
+ *                  and recalculates its subtree, which includes input widget
+ *
+ * \param[in]       h: Widget handle
+ */
+static void
+resolve_widget_abs_values(gui_handle_p h) {
+    gui_handle_p w, top = NULL;
+    
+    if (!(GUI.flags & GUI_FLAG_LAYOUT_DIRTY) || layout_resolving) {
+        return;                                     /* Nothing pending or already resolving */
+    }
+    for (w = guii_widget_getparent(h); w != NULL; w = guii_widget_getparent(w)) {
+        if (guii_widget_getflag(w, GUI_FLAG_LAYOUT_DIRTY)) {
+            top = w;                                /* Remember top-most dirty parent */
+        }
+    }
+    if (top != NULL) {
+        calculate_children_abs_values(top);
+    }
+}
+
+/**
+ * \brief           Set widget absolute values for position and size
+ *
+ *                  Only input widget is recalculated immediately.
+ *                  Children widgets are marked as pending and are recalculated
+ *                  once per frame with \ref guii_widget_layout or when first read
+ *
+ * \param[in]       h: Widget handle
+ */
+static uint8_t
+set_widget_abs_values(gui_handle_p h) {
+    resolve_widget_abs_values(h);                   /* Parent values must be valid first */
+    calculate_widget_abs_values(h);                 /* Update widget absolute values */
+    
+    /* Mark children widgets as pending */
+    if (guii_widget_haschildren(h)) {
+        guii_widget_setflag(h, GUI_FLAG_LAYOUT_DIRTY);
+        GUI.flags |= GUI_FLAG_LAYOUT_DIRTY;
+    }
     return 1;
 }
+
+/**
+ * \brief           Recalculate pending layout in widget tree
+ * \param[in]       parent: Parent widget to process children for, `NULL` for root
+ */
+static void
+layout_widgets(gui_handle_p parent) {
+    gui_handle_p h;
+    
+    GUI_LINKEDLIST_WIDGETSLISTNEXT(parent, h) {
+        if (guii_widget_getflag(h, GUI_FLAG_LAYOUT_DIRTY)) {
+            calculate_children_abs_values(h);       /* Complete subtree is recalculated */
+        } else if (guii_widget_haschildren(h)) {
+            layout_widgets(h);
+        }
+    }
+}
 #endif /* GUI_CFG_USE_POS_SIZE_CACHE */
 
 /**
@@ -266,6 +392,12 @@ remove_widget(gui_handle_p h) {
         GUI_MEMFREE(h->colors);
         h->colors = NULL;
     }
+#if GUI_CFG_USE_TEXT_CACHE
+    if (h->textcache != NULL) {
+        gui_draw_text_cachefree(h->textcache);
+        GUI_MEMFREE(h->textcache);
+    }
+#endif /* GUI_CFG_USE_TEXT_CACHE */
     gui_linkedlist_widgetremove(h);                 /* Remove entry from linked list of parent widget */
     GUI_MEMFREE(h);                                 /* Free memory for widget */
     
@@ -350,6 +482,7 @@ remove_widgets(gui_handle_p parent) {
 static uint8_t
 get_widget_abs_visible_position_size(gui_handle_p h, gui_dim_t* x1, gui_dim_t* y1, gui_dim_t* x2, gui_dim_t* y2) {
 #if GUI_CFG_USE_POS_SIZE_CACHE
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
     *x1 = h->abs_visible_x1;
     *y1 = h->abs_visible_y1;
     *x2 = h->abs_visible_x2;
@@ -360,6 +493,99 @@ get_widget_abs_visible_position_size(gui_handle_p h, gui_dim_t* x1, gui_dim_t* y
 #endif /* !GUI_CFG_USE_POS_SIZE_CACHE */
 }
 
+/**
+ * \brief           Get area of rectangle in units of pixels
+ * \param[in]       d: Rectangle to get area for
+ * \return          Rectangle area or `0` if rectangle is empty
+ */
+static uint32_t
+get_display_area(const gui_display_t* d) {
+    if (d->x2 <= d->x1 || d->y2 <= d->y1) {
+        return 0;
+    }
+    return (uint32_t)(d->x2 - d->x1) * (uint32_t)(d->y2 - d->y1);
+}
+
+/**
+ * \brief           Add rectangle to list of dirty rectangles for next redraw process
+ *
+ *                  Rectangle is merged with existing one when they overlap
+ *                  or when bounding rectangle of both does not waste more than
+ *                  \ref GUI_CFG_DISPLAY_RECTS_MERGE_WASTE percent of its area.
+ *                  When list is full, whole screen is set as single dirty rectangle.
+ *
+ * \param[in]       x1: Top left X position on screen
+ * \param[in]       y1: Top left Y position on screen
+ * \param[in]       x2: Bottom right X position on screen
+ * \param[in]       y2: Bottom right Y position on screen
+ */
+static void
+add_dirty_rect(gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2) {
+    gui_display_t r, u, *d;
+    uint32_t area_r, area_d, area_u, area_i;
+    size_t i;
+    
+    /* Limit rectangle to screen, anything outside is never drawn */
+    r.x1 = GUI_MAX(x1, 0);
+    r.y1 = GUI_MAX(y1, 0);
+    r.x2 = GUI_MIN(x2, GUI.lcd.width);
+    r.y2 = GUI_MIN(y2, GUI.lcd.height);
+    if ((area_r = get_display_area(&r)) == 0) {
+        return;
+    }
+    
+    /* Merge with existing rectangles until there is nothing to merge */
+    for (i = 0; i < GUI.display_dirty_count; ) {
+        d = &GUI.display_dirty[i];
+        
+        /* Rectangle is already fully dirty */
+        if (GUI_RECT_IS_INSIDE(r.x1, r.y1, r.x2, r.y2, d->x1, d->y1, d->x2, d->y2)) {
+            return;
+        }
+        
+        /* Get bounding rectangle and intersection area of both */
+        u.x1 = GUI_MIN(r.x1, d->x1);
+        u.y1 = GUI_MIN(r.y1, d->y1);
+        u.x2 = GUI_MAX(r.x2, d->x2);
+        u.y2 = GUI_MAX(r.y2, d->y2);
+        area_u = get_display_area(&u);
+        area_d = get_display_area(d);
+        if (r.x1 < d->x2 && d->x1 < r.x2 && r.y1 < d->y2 && d->y1 < r.y2) {
+            area_i = (uint32_t)(GUI_MIN(r.x2, d->x2) - GUI_MAX(r.x1, d->x1)) * (uint32_t)(GUI_MIN(r.y2, d->y2) - GUI_MAX(r.y1, d->y1));
+        } else {
+            area_i = 0;
+        }
+        
+        /* Check overlap or wasted area of bounding rectangle */
+        if (area_i > 0 || 
+            (area_u - (area_r + area_d - area_i)) * 100UL <= area_u * GUI_CFG_DISPLAY_RECTS_MERGE_WASTE) {
+            memcpy(&r, &u, sizeof(r));              /* Merged rectangle is new candidate */
+            area_r = area_u;
+            
+            /* Remove existing rectangle from list and start over as merged one may now match others */
+            GUI.display_dirty_count--;
+            if (i < GUI.display_dirty_count) {
+                memcpy(d, &GUI.display_dirty[GUI.display_dirty_count], sizeof(*d));
+            }
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+    
+    /* Add new rectangle or collapse to full screen when there is no more space */
+    if (GUI.display_dirty_count < GUI_COUNT_OF(GUI.display_dirty)) {
+        memcpy(&GUI.display_dirty[GUI.display_dirty_count], &r, sizeof(r));
+        GUI.display_dirty_count++;
+    } else {
+        GUI.display_dirty[0].x1 = 0;
+        GUI.display_dirty[0].y1 = 0;
+        GUI.display_dirty[0].x2 = GUI.lcd.width;
+        GUI.display_dirty[0].y2 = GUI.lcd.height;
+        GUI.display_dirty_count = 1;
+    }
+}
+
 /**
  * \brief           Set clipping region for visible part of widget
  * \param[in]       h: Widget handle
@@ -383,11 +609,8 @@ set_clipping_region(gui_handle_p h) {
      * This may only work if padding is 0 and widget position wasn't changed
      */
     
-    /* Set invalid clipping region */
-    if (GUI.display.x1 > x1)    { GUI.display.x1 = x1; }
-    if (GUI.display.x2 < x2)    { GUI.display.x2 = x2; }
-    if (GUI.display.y1 > y1)    { GUI.display.y1 = y1; }
-    if (GUI.display.y2 < y2)    { GUI.display.y2 = y2; }
+    /* Add visible part to dirty rectangles */
+    add_dirty_rect(x1, y1, x2, y2);
     
     return 1;
 }
@@ -395,6 +618,10 @@ set_clipping_region(gui_handle_p h) {
 /**
  * \brief           Invalidate widget and set redraw flag
  * \note            If widget is transparent, parent must be updated too. This function will handle these cases.
+ * \note            All siblings after widget are still visited one by one, grid masks only skip position checks
+ *                  of siblings with no grid cell in common with widgets for redraw.
+ *                  Cost is linear in number of siblings, and quadratic when all of them share grid cells,
+ *                  such as many small widgets inside single cell
  * \param[in]       h: Widget handle
  * \param[in]       setclipping: When set to 1, clipping region will be expanded to widget size
  * \return          `1` on success, `0` otherwise
@@ -404,6 +631,7 @@ invalidate_widget(gui_handle_p h, uint8_t setclipping) {
     gui_handle_p h1, h2;
     gui_dim_t h1x1, h1x2, h2x1, h2x2;
     gui_dim_t h1y1, h1y2, h2y1, h2y2;
+    gui_widget_grid_t grid_redraw;
     
     GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
 
@@ -445,6 +673,7 @@ invalidate_widget(gui_handle_p h, uint8_t setclipping) {
      * If widget should be redrawn, then any widget above it should be redrawn too, otherwise z-index match will fail.
      *
      * Widget may not need redraw operation if positions don't match
+     * any of widgets below it which are set for redraw. Grid masks of parent area are used for fast reject.
      *
      * If widget is transparent, check all widgets, even those which are below current widget in list
      * Get first element of parent linked list for checking
@@ -454,26 +683,38 @@ invalidate_widget(gui_handle_p h, uint8_t setclipping) {
         invalidate_widget(guii_widget_getparent(h1), 0);    /* Invalidate parent widget */
     }
 #endif /* GUI_CFG_USE_ALPHA */
+    grid_redraw = 0;
     for (; h1 != NULL; h1 = gui_linkedlist_widgetgetnext(NULL, h1)) {
-        get_widget_abs_visible_position_size(h1, &h1x1, &h1y1, &h1x2, &h1y2); /* Get visible position on LCD for widget */
-        
-        /* Scan widgets on top of current widget */
-        for (h2 = gui_linkedlist_widgetgetnext(NULL, h1); h2 != NULL;
-                h2 = gui_linkedlist_widgetgetnext(NULL, h2)) {
-            /* Get visible position on second widget */
-            get_widget_abs_visible_position_size(h2, &h2x1, &h2y1, &h2x2, &h2y2);
-                    
-            /* Check if next widget is on top of current one */
-            if (
-                guii_widget_getflag(h2, GUI_FLAG_REDRAW) || /* Flag is already set */
-                !GUI_RECT_MATCH(                    /* Widgets are not one over another */
+        if (!guii_widget_getflag(h1, GUI_FLAG_REDRAW)) {
+            /* Fast reject when widget is not in any grid cell of widgets for redraw */
+            if (!(GET_WIDGET_GRID(h1) & grid_redraw)) {
+                continue;
+            }
+            get_widget_abs_visible_position_size(h1, &h1x1, &h1y1, &h1x2, &h1y2); /* Get visible position on LCD for widget */
+            
+            /* Scan widgets below current one which are set for redraw */
+            for (h2 = h; h2 != h1; h2 = gui_linkedlist_widgetgetnext(NULL, h2)) {
+                if (!guii_widget_getflag(h2, GUI_FLAG_REDRAW) ||
+                    !(GET_WIDGET_GRID(h2) & GET_WIDGET_GRID(h1))) {
+                    continue;
+                }
+                
+                /* Get visible position on second widget */
+                get_widget_abs_visible_position_size(h2, &h2x1, &h2y1, &h2x2, &h2y2);
+                
+                /* Check if widget for redraw is below current one */
+                if (GUI_RECT_MATCH(
                     h1x1, h1y1, h1x2, h1y2,
-                    h2x1, h2y1, h2x2, h2y2)
-            ) {
+                    h2x1, h2y1, h2x2, h2y2)) {
+                    guii_widget_setflag(h1, GUI_FLAG_REDRAW);   /* Redraw widget on next loop */
+                    break;
+                }
+            }
+            if (h2 == h1) {                         /* No overlap with widgets for redraw */
                 continue;
             }
-            guii_widget_setflag(h2, GUI_FLAG_REDRAW);   /* Redraw widget on next loop */
         }
+        grid_redraw |= GET_WIDGET_GRID(h1);         /* Add widget to redraw area */
     }
     
     /*
@@ -740,6 +981,12 @@ guii_widget_isinsideclippingregion(gui_handle_p h, uint8_t check_sib_cover) {
     if (check_sib_cover) {
         gui_dim_t tx1, ty1, tx2, ty2;
         gui_handle_p tmp;
+        
+        /* Only part inside drawing area must be covered */
+        x1 = GUI_MAX(x1, GUI.display.x1);
+        y1 = GUI_MAX(y1, GUI.display.y1);
+        x2 = GUI_MIN(x2, GUI.display.x2);
+        y2 = GUI_MIN(y2, GUI.display.y2);
 
         /* Process all widgets after current one */
         for (tmp = gui_linkedlist_widgetgetnext(NULL, h); tmp != NULL;
@@ -754,8 +1001,7 @@ guii_widget_isinsideclippingregion(gui_handle_p h, uint8_t check_sib_cover) {
 
             /* Check if widget is inside */
             if (GUI_RECT_IS_INSIDE(x1, y1, x2, y2, tx1, ty1, tx2, ty2) &&
-                !guii_widget_getflag(tmp, GUI_FLAG_WIDGET_INVALIDATE_PARENT) &&
-                !guii_widget_hasalpha(tmp)          /* Must not have transparency enabled */
+                guii_widget_isopaque(tmp)           /* Must paint all pixels with opaque colors */
                 ) {
                 return 0;                           /* Widget fully covered by another! */
             }
@@ -765,6 +1011,134 @@ guii_widget_isinsideclippingregion(gui_handle_p h, uint8_t check_sib_cover) {
     return 1;                                       /* We have to draw it */
 }
 
+/**
+ * \brief           Get mask of parent grid cells covered by rectangle
+ *
+ *                  Visible area of parent widget is split to \ref GUI_WIDGET_GRID_COLS x \ref GUI_WIDGET_GRID_ROWS cells,
+ *                  each bit in mask represents one cell. Children of the same parent with no common bit cannot overlap.
+ *                  Grid follows parent area, so even small widgets deep in the tree are split to many cells.
+ *
+ * \param[in]       parent: Parent widget which grid is used, `NULL` for screen
+ * \param[in]       x1: Left X position on screen
+ * \param[in]       y1: Top Y position on screen
+ * \param[in]       x2: Right X position on screen, inclusive
+ * \param[in]       y2: Bottom Y position on screen, inclusive
+ * \return          Grid mask of rectangle
+ */
+gui_widget_grid_t
+guii_widget_getgridmask(gui_handle_p parent, gui_dim_t x1, gui_dim_t y1, gui_dim_t x2, gui_dim_t y2) {
+    gui_widget_grid_t mask = 0, row;
+    gui_dim_t gx1, gy1, gx2, gy2;
+    int32_t cx1, cy1, cx2, cy2;
+    
+    /* Get area of grid, right and bottom positions are exclusive */
+    if (parent != NULL) {
+        get_widget_abs_visible_position_size(parent, &gx1, &gy1, &gx2, &gy2);
+    } else {
+        gx1 = 0;
+        gy1 = 0;
+        gx2 = GUI.lcd.width;
+        gy2 = GUI.lcd.height;
+    }
+    
+    /* Clip rectangle to grid area */
+    x1 = GUI_MAX(x1, gx1);
+    y1 = GUI_MAX(y1, gy1);
+    x2 = GUI_MIN(x2, gx2 - 1);
+    y2 = GUI_MIN(y2, gy2 - 1);
+    if (x2 < x1 || y2 < y1) {
+        return 0;                                   /* Nothing visible in grid area */
+    }
+    
+    /* Get first and last cell in each direction */
+    cx1 = (int32_t)(x1 - gx1) * GUI_WIDGET_GRID_COLS / (gx2 - gx1);
+    cx2 = (int32_t)(x2 - gx1) * GUI_WIDGET_GRID_COLS / (gx2 - gx1);
+    cy1 = (int32_t)(y1 - gy1) * GUI_WIDGET_GRID_ROWS / (gy2 - gy1);
+    cy2 = (int32_t)(y2 - gy1) * GUI_WIDGET_GRID_ROWS / (gy2 - gy1);
+    
+    /* Set all cells of one row and copy them to all covered rows */
+    row = (gui_widget_grid_t)((0xFFUL >> (GUI_WIDGET_GRID_COLS - 1 - cx2)) & (0xFFUL << cx1));
+    for (; cy1 <= cy2; cy1++) {
+        mask |= row << (cy1 * GUI_WIDGET_GRID_COLS);
+    }
+    return mask;
+}
+
+#if GUI_CFG_USE_POS_SIZE_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Get mask of parent grid cells covered by visible part of widget
+ * \note            Pending layout is applied first, so mask is always valid
+ * \param[in]       h: Widget handle
+ * \return          Grid mask of widget
+ */
+gui_widget_grid_t
+guii_widget_getgrid(gui_handle_p h) {
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
+    return h->abs_visible_grid;
+}
+
+#endif /* GUI_CFG_USE_POS_SIZE_CACHE || __DOXYGEN__ */
+
+/**
+ * \brief           Limit drawing area of widget by its opaque children
+ *
+ *                  Opaque children are drawn after widget itself and overpaint it completely.
+ *                  Drawing area is reduced for every opaque child which covers it on full width or full height,
+ *                  so that result is still single rectangle.
+ *
+ * \note            Children which cover only inner part of drawing area, such as grid of buttons
+ *                  with gaps between them, do not reduce it. Widget is drawn below them
+ *                  unless dirty rectangle itself lies inside single opaque child
+ *
+ * \param[in]       h: Widget handle
+ * \param[in,out]   disp: Drawing area of widget to reduce
+ * \return          `1` if widget must still be drawn, `0` if it is fully covered by its children
+ */
+uint8_t
+guii_widget_clipopaquechildren(gui_handle_p h, gui_display_t* disp) {
+    gui_dim_t x1, y1, x2, y2;
+    gui_handle_p child;
+    uint8_t changed;
+    
+    if (!guii_widget_haschildren(h)) {
+        return 1;
+    }
+    
+    /* Repeat as reduced area may now be covered by already checked children */
+    do {
+        changed = 0;
+        GUI_LINKEDLIST_WIDGETSLISTNEXT(h, child) {
+            if (disp->x1 >= disp->x2 || disp->y1 >= disp->y2) {
+                return 0;                           /* Nothing left to draw */
+            }
+            if (guii_widget_ishidden(child) || !guii_widget_isopaque(child)) {
+                continue;
+            }
+            get_widget_abs_visible_position_size(child, &x1, &y1, &x2, &y2);
+            
+            if (x1 <= disp->x1 && x2 >= disp->x2) { /* Child covers full width */
+                if (y1 <= disp->y1 && y2 > disp->y1) {
+                    disp->y1 = GUI_MIN(y2, disp->y2);   /* Covers top part */
+                    changed = 1;
+                } else if (y2 >= disp->y2 && y1 < disp->y2) {
+                    disp->y2 = GUI_MAX(y1, disp->y1);   /* Covers bottom part */
+                    changed = 1;
+                }
+            } else if (y1 <= disp->y1 && y2 >= disp->y2) {  /* Child covers full height */
+                if (x1 <= disp->x1 && x2 > disp->x1) {
+                    disp->x1 = GUI_MIN(x2, disp->x2);   /* Covers left part */
+                    changed = 1;
+                } else if (x2 >= disp->x2 && x1 < disp->x2) {
+                    disp->x2 = GUI_MAX(x1, disp->x1);   /* Covers right part */
+                    changed = 1;
+                }
+            }
+        }
+    } while (changed);
+    return disp->x1 < disp->x2 && disp->y1 < disp->y2;
+}
+
 /**
  * \brief           Init widget part of library
  */
@@ -787,6 +1161,23 @@ guii_widget_executeremove(void) {
     return 0;
 }
 
+/**
+ * \brief           Recalculate pending absolute position and size values
+ * \note            Called once per frame, before widgets are touched or drawn
+ * \return          `1` if layout was processed, `0` otherwise
+ */
+uint8_t
+guii_widget_layout(void) {
+#if GUI_CFG_USE_POS_SIZE_CACHE
+    if (GUI.flags & GUI_FLAG_LAYOUT_DIRTY) {        /* Anything pending? */
+        layout_widgets(NULL);                       /* Recalculate dirty subtrees */
+        GUI.flags &= ~GUI_FLAG_LAYOUT_DIRTY;
+        return 1;
+    }
+#endif /* GUI_CFG_USE_POS_SIZE_CACHE */
+    return 0;
+}
+
 /**
  * \brief           Move widget down on linked list (put it as last, most visible on screen)
  * \param[in]       h: Widget handle
@@ -972,6 +1363,7 @@ gui_widget_getabsolutex(gui_handle_p h) {
         return 0;                                   /* At left value */
     }
 #if GUI_CFG_USE_POS_SIZE_CACHE
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
     return h->abs_x;                                /* Cached value */
 #else /* GUI_CFG_USE_POS_SIZE_CACHE */
     return calculate_widget_absolute_x(h);          /* Calculate value */
@@ -989,6 +1381,7 @@ gui_widget_getabsolutey(gui_handle_p h) {
         return 0;                                   /* At left value */
     }
 #if GUI_CFG_USE_POS_SIZE_CACHE
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
     return h->abs_y;                                /* Cached value */
 #else /* GUI_CFG_USE_POS_SIZE_CACHE */
     return calculate_widget_absolute_y(h);          /* Calculate value */
@@ -1055,6 +1448,27 @@ gui_widget_setinvalidatewithparent(gui_handle_p h, uint8_t value) {
     return 1;
 }
 
+/**
+ * \brief           Set if widget paints all pixels of its rectangle with opaque colors
+ * \note            Opaque widgets hide everything below them, so parent and siblings below
+ *                  do not need to be redrawn in area covered by opaque widget
+ * \param[in]       h: Widget handle
+ * \param[in]       opaque: Set to `1` when widget fully paints its rectangle, `0` otherwise
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gui_widget_setopaque(gui_handle_p h, uint8_t opaque) {
+    GUI_ASSERTPARAMS(guii_widget_iswidget(h));    
+    
+    if (opaque) {
+        guii_widget_setflag(h, GUI_FLAG_WIDGET_OPAQUE);
+    } else {
+        guii_widget_clrflag(h, GUI_FLAG_WIDGET_OPAQUE);
+    }
+
+    return 1;
+}
+
 /**
  * \brief           Set widget parameter in OS secure way
  * \param[in]       h: Widget handle
@@ -1122,6 +1536,9 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
         h->widget = widget;                         /* Widget object structure */
         h->footprint = GUI_WIDGET_FOOTPRINT;        /* Set widget footprint */
         h->callback = evt_fn;                       /* Set widget callback */
+        if (guii_widget_getcoreflag(h, GUI_FLAG_WIDGET_OPAQUE)) {
+            guii_widget_setflag(h, GUI_FLAG_WIDGET_OPAQUE); /* Opaque by default, widget may clear it later */
+        }
 #if GUI_CFG_USE_ALPHA
         h->alpha = 0xFF;                            /* Set full transparency by default */
 #endif /* GUI_CFG_USE_ALPHA */
@@ -1198,6 +1615,8 @@ gui_widget_create(const gui_widget_t* widget, gui_id_t id, float x, float y, flo
 
 /**
  * \brief           Set color to widget specific index
+ * \note            For widgets with \ref GUI_FLAG_WIDGET_OPAQUE core flag,
+ *                  background color at index \ref GUI_WIDGET_COLOR_BG also sets widget opacity
  * \param[in]       h: Widget handle
  * \param[in]       index: Index in array of colors
  * \param[in]       color: Actual color code to set
@@ -1228,6 +1647,9 @@ gui_widget_setcolor(gui_handle_p h, uint8_t index, gui_color_t color) {
             ret = 0;
         }
     }
+    if (ret && index == GUI_WIDGET_COLOR_BG && guii_widget_getcoreflag(h, GUI_FLAG_WIDGET_OPAQUE)) {
+        gui_widget_setopaque(h, GUI_COLOR_ISOPAQUE(color)); /* Translucent background shows parent below */
+    }
     
     return ret;
 }
@@ -1340,6 +1762,7 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
             h->text[tlen + l] = 0;                  /* Add 0 to the end */
             
             gui_widget_invalidate(h);               /* Invalidate widget */
+            CLEAR_WIDGET_TEXT_CACHE(h);             /* Text layout must be processed again */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
             return 1;
         }
@@ -1347,7 +1770,7 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
         if (tlen && h->textcursor) {
             size_t pos;
             
-            gui_string_prepare(&currStr, (gui_char *)((uint32_t)h->text + h->textcursor - 1));  /* Set string to process */
+            gui_string_prepare(&currStr, &h->text[h->textcursor - 1]);  /* Set string to process */
             gui_string_gotoend(&currStr);           /* Go to the end of string */
             if (!gui_string_getchreverse(&currStr, &ch, &l)) {  /* Get last character */
                 return 0;                           
@@ -1359,6 +1782,7 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
             h->text[tlen - l] = 0;                  /* Set 0 to the end of string */
             
             gui_widget_invalidate(h);               /* Invalidate widget */
+            CLEAR_WIDGET_TEXT_CACHE(h);             /* Text layout must be processed again */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);/* Process callback */
             return 1;
         }
@@ -1366,6 +1790,25 @@ guii_widget_processtextkey(gui_handle_p h, guii_keyboard_data_t* kb) {
     return 0;
 }
 
+/**
+ * \brief           Get text layout cache for widget
+ * \note            Cache memory is allocated on first call
+ * \param[in]       h: Widget handle
+ * \return          Pointer to cache to set in \ref gui_draw_text_t or `NULL` if not available
+ */
+gui_draw_text_cache_t *
+guii_widget_gettextcache(gui_handle_p h) {
+#if GUI_CFG_USE_TEXT_CACHE
+    if (h->textcache == NULL) {
+        h->textcache = GUI_MEMALLOC(sizeof(*h->textcache));
+    }
+    return h->textcache;
+#else /* GUI_CFG_USE_TEXT_CACHE */
+    GUI_UNUSED(h);
+    return NULL;
+#endif /* !GUI_CFG_USE_TEXT_CACHE */
+}
+
 /**
  * \brief           Allocate memory for text operations if text will be dynamic
  * \note            When unicode feature is enabled, memory should be 4x required characters because unicode can store up to 4 bytes for single character
@@ -1392,6 +1835,7 @@ gui_widget_alloctextmemory(gui_handle_p h, uint32_t size) {
         guii_widget_clrflag(h, GUI_FLAG_DYNAMICTEXTALLOC); /* Not allocated */
     }
     gui_widget_invalidate(h);                       /* Redraw object */
+    CLEAR_WIDGET_TEXT_CACHE(h);                     /* Text layout must be processed again */
     guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
     
     return h->textmemsize;                          /* Return number of bytes allocated */
@@ -1414,6 +1858,7 @@ gui_widget_freetextmemory(gui_handle_p h) {
         h->textmemsize = 0;                         /* Reset memory size */
         guii_widget_clrflag(h, GUI_FLAG_DYNAMICTEXTALLOC); /* Not allocated */
         gui_widget_invalidate(h);                   /* Redraw object */
+        CLEAR_WIDGET_TEXT_CACHE(h);                 /* Text layout must be processed again */
         guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         res = 1;
     }
@@ -1442,17 +1887,20 @@ gui_widget_settext(gui_handle_p h, const gui_char* text) {
                 gui_string_copy(h->text, text);     /* Copy entire string */
             }
             gui_widget_invalidate(h);               /* Redraw object */
+            CLEAR_WIDGET_TEXT_CACHE(h);             /* Text layout must be processed again */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
     } else {                                        /* Memory allocated by user */
         if (h->text != NULL && h->text == text) {   /* In case the same pointer is passed to WIDGET */
             gui_widget_invalidate(h);               /* Redraw object */
+            CLEAR_WIDGET_TEXT_CACHE(h);             /* Text layout must be processed again */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
         
         if (h->text != text) {                      /* Check if pointer do not match */
             h->text = (gui_char *)text;             /* Set parameter */
             gui_widget_invalidate(h);               /* Redraw object */
+            CLEAR_WIDGET_TEXT_CACHE(h);             /* Text layout must be processed again */
             guii_widget_callback(h, GUI_EVT_TEXTCHANGED, NULL, NULL);   /* Process callback */
         }
     }
@@ -1519,6 +1967,7 @@ gui_widget_setfont(gui_handle_p h, const gui_font_t* font) {
     
     if (h->font != font) {
         h->font = font;
+        CLEAR_WIDGET_TEXT_CACHE(h);                 /* Layout depends on font */
         gui_widget_invalidatewithparent(h);
     }
     
@@ -1695,6 +2144,7 @@ gui_widget_getwidth(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && GUI.initialized); 
     
 #if GUI_CFG_USE_POS_SIZE_CACHE
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
     res = h->abs_width;                             /* Cached value */
 #else /* GUI_CFG_USE_POS_SIZE_CACHE */
     res = calculate_widget_width(h);                /* Calculate value */
@@ -1719,6 +2169,7 @@ gui_widget_getheight(gui_handle_p h) {
     GUI_ASSERTPARAMS(guii_widget_iswidget(h) && GUI.initialized); 
 
 #if GUI_CFG_USE_POS_SIZE_CACHE
+    resolve_widget_abs_values(h);                   /* Apply pending layout */
     res = h->abs_height;                            /* Cached value */
 #else /* GUI_CFG_USE_POS_SIZE_CACHE */
     res = calculate_widget_height(h);               /* Calculate value */
@@ -0,0 +1,921 @@
+/**
+ * \file            gui_bench.c
+ * \brief           Micro-benchmarks for drawing functions
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+
+/*
+ * Benchmark draws every public gui_draw_* primitive on headless frame buffer,
+ * for multiple primitive sizes and clipping regions, and writes results as JSON.
+ * Not measured are structure helpers (gui_draw_*_init, gui_draw_text_cachefree)
+ * and gui_draw_rectangle_ex, which has no implementation yet.
+ *
+ * Clipping regions:
+ *
+ *  - "full":    Whole screen is visible
+ *  - "partial": Left half of primitive is clipped away
+ *  - "outside": Primitive is completely outside of clipping region, measures rejection cost
+ *
+ * For each case, "pixels_per_call" is number of pixels modified by single call,
+ * counted on cleared screen after measurement, and "mpix_per_s" is number of these pixels drawn per second.
+ *
+ * Build from repository root, together with all sources from "src/gui" and "src/widget":
+ *
+ *  gcc -O2 -Itools/benchmark -Isrc/include tools/benchmark/gui_bench.c $GUI_SOURCES \
+ *      src/fonts/Arial_Bold_AA.c src/fonts/Comic_Sans_MS_Regular.c \
+ *      src/system/gui_ll_headless.c src/system/gui_ll_soft.c src/system/gui_sys_posix.c -lm -o gui_bench
+ *
+ * Usage:
+ *
+ *  gui_bench [-o FILE] [-t MS] [-f FILTER] [-s WIDTHxHEIGHT] [-p PIXEL_SIZE]
+ *
+ *  -o: Output JSON file, standard output by default
+ *  -t: Minimal measurement time per case in units of milliseconds, default 200
+ *  -f: Run only cases with name containing FILTER
+ *  -s: Display size, default 480x272
+ *  -p: Bytes per pixel, 2 for RGB565 or 4 for ARGB8888 (default)
+ *
+ * Add -DGUI_CFG_LL_SOFT_USE_SIMD=0 to compare with portable C kernels.
+ * Add -DGUI_CFG_USE_TEXT_CACHE=1 to draw "writetext_cached" case from text layout cache.
+ */
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 199309L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE                 199309L
+#endif
+#include "gui/gui.h"
+#include "gui/gui_draw.h"
+#include "gui/gui_text.h"
+#include "system/gui_ll_headless.h"
+#include "system/gui_ll_soft.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+extern gui_const gui_font_t GUI_Font_Arial_Bold_18;
+extern gui_const gui_font_t GUI_Font_Comic_Sans_MS_Regular_22;
+
+/**
+ * \brief           Clipping region type
+ */
+typedef enum {
+    BENCH_CLIP_FULL = 0x00,                     /*!< Whole primitive is visible */
+    BENCH_CLIP_PARTIAL,                         /*!< Half of primitive is visible */
+    BENCH_CLIP_OUTSIDE,                         /*!< Primitive is not visible */
+} bench_clip_t;
+
+/**
+ * \brief           Parameters of single measurement
+ */
+typedef struct {
+    gui_display_t disp;                         /*!< Clipping region */
+    gui_dim_t x;                                /*!< Top left X position of primitive */
+    gui_dim_t y;                                /*!< Top left Y position of primitive */
+    gui_dim_t size;                             /*!< Width and height of primitive */
+    const gui_char* text;                       /*!< Text fitting into `size` wide box */
+} bench_ctx_t;
+
+/**
+ * \brief           Benchmark case
+ */
+typedef struct {
+    const char* name;                           /*!< Case name */
+    void (*fn)(const bench_ctx_t* ctx);         /*!< Function to draw primitive once */
+    uint8_t sized;                              /*!< Set to `1` when primitive depends on size and clipping */
+    const gui_font_t* font;                     /*!< Font for text cases */
+} bench_case_t;
+
+static const gui_dim_t sizes[] = {8, 32, 128, 256};   /* Primitive sizes, largest is also size of test images */
+
+static const gui_char bench_text[] = "The quick brown fox jumps over the lazy dog. 0123456789 "
+                                      "Pack my box with five dozen liquor jugs. ";
+
+static uint8_t* img_data[3];                    /* Image data for 16, 24 and 32 bits per pixel */
+static gui_char text_buff[sizeof(bench_text)];
+static volatile gui_color_t sink;               /* Prevents removal of getpixel calls */
+static gui_draw_text_cache_t text_cache;        /* Layout cache for cached text case */
+static gui_dim_t lcd_width, lcd_height;
+
+static void
+draw_fillscreen(const bench_ctx_t* ctx) {
+    gui_draw_fillscreen(&ctx->disp, GUI_COLOR_DARKBLUE);
+}
+
+static void
+draw_setpixel(const bench_ctx_t* ctx) {
+    gui_draw_setpixel(&ctx->disp, ctx->x, ctx->y, GUI_COLOR_RED);
+}
+
+static void
+draw_getpixel(const bench_ctx_t* ctx) {
+    sink = gui_draw_getpixel(&ctx->disp, ctx->x, ctx->y);
+}
+
+static void
+draw_hline(const bench_ctx_t* ctx) {
+    gui_draw_hline(&ctx->disp, ctx->x, ctx->y, ctx->size, GUI_COLOR_GREEN);
+}
+
+static void
+draw_vline(const bench_ctx_t* ctx) {
+    gui_draw_vline(&ctx->disp, ctx->x + ctx->size - 1, ctx->y, ctx->size, GUI_COLOR_GREEN);
+}
+
+static void
+draw_line(const bench_ctx_t* ctx) {
+    gui_draw_line(&ctx->disp, ctx->x, ctx->y, ctx->x + ctx->size - 1, ctx->y + ctx->size - 1, GUI_COLOR_GREEN);
+}
+
+static void
+draw_line_aa(const bench_ctx_t* ctx) {
+    gui_draw_line_aa(&ctx->disp, ctx->x, ctx->y, ctx->x + ctx->size - 1, ctx->y + ctx->size / 3, GUI_COLOR_GREEN);
+}
+
+static void
+draw_rectangle(const bench_ctx_t* ctx) {
+    gui_draw_rectangle(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, GUI_COLOR_BLUE);
+}
+
+static void
+draw_filledrectangle(const bench_ctx_t* ctx) {
+    gui_draw_filledrectangle(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, GUI_COLOR_BLUE);
+}
+
+static void
+draw_filledrectangle_alpha(const bench_ctx_t* ctx) {
+    gui_draw_filledrectangle(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, GUI_COLOR_ALPHA(GUI_COLOR_BLUE, GUI_COLOR_ALPHA_50));
+}
+
+static void
+draw_rectangle3d(const bench_ctx_t* ctx) {
+    gui_draw_rectangle3d(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, GUI_DRAW_3D_State_Raised);
+}
+
+static void
+draw_roundedrectangle(const bench_ctx_t* ctx) {
+    gui_draw_roundedrectangle(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, ctx->size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+draw_filledroundedrectangle(const bench_ctx_t* ctx) {
+    gui_draw_filledroundedrectangle(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, ctx->size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+draw_circle(const bench_ctx_t* ctx) {
+    gui_draw_circle(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_filledcircle(const bench_ctx_t* ctx) {
+    gui_draw_filledcircle(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_roundedrectangle_aa(const bench_ctx_t* ctx) {
+    gui_draw_roundedrectangle_aa(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, ctx->size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+draw_filledroundedrectangle_aa(const bench_ctx_t* ctx) {
+    gui_draw_filledroundedrectangle_aa(&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, ctx->size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+draw_circle_aa(const bench_ctx_t* ctx) {
+    gui_draw_circle_aa(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_filledcircle_aa(const bench_ctx_t* ctx) {
+    gui_draw_filledcircle_aa(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_arc(const bench_ctx_t* ctx) {
+    gui_draw_arc(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, ctx->size / 8 + 1, 135, 45, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_pie(const bench_ctx_t* ctx) {
+    gui_draw_pie(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, 30, 300, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_ring(const bench_ctx_t* ctx) {
+    gui_draw_ring(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2, ctx->size / 8 + 1, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_circlecorner(const bench_ctx_t* ctx) {
+    gui_draw_circlecorner(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2,
+        GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_TR | GUI_DRAW_CIRCLE_BL | GUI_DRAW_CIRCLE_BR, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_filledcirclecorner(const bench_ctx_t* ctx) {
+    gui_draw_filledcirclecorner(&ctx->disp, ctx->x + ctx->size / 2, ctx->y + ctx->size / 2, ctx->size / 2,
+        GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_TR | GUI_DRAW_CIRCLE_BL | GUI_DRAW_CIRCLE_BR, GUI_COLOR_MAGENTA);
+}
+
+static void
+draw_triangle(const bench_ctx_t* ctx) {
+    gui_draw_triangle(&ctx->disp, ctx->x, ctx->y + ctx->size - 1, ctx->x + ctx->size / 2, ctx->y,
+        ctx->x + ctx->size - 1, ctx->y + ctx->size - 1, GUI_COLOR_CYAN);
+}
+
+static void
+draw_filledtriangle(const bench_ctx_t* ctx) {
+    gui_draw_filledtriangle(&ctx->disp, ctx->x, ctx->y + ctx->size - 1, ctx->x + ctx->size / 2, ctx->y,
+        ctx->x + ctx->size - 1, ctx->y + ctx->size - 1, GUI_COLOR_CYAN);
+}
+
+static void
+draw_poly(const bench_ctx_t* ctx) {
+    gui_draw_poly_t p[5];
+
+    p[0].x = ctx->x;                    p[0].y = ctx->y;
+    p[1].x = ctx->x + ctx->size - 1;    p[1].y = ctx->y;
+    p[2].x = ctx->x + ctx->size - 1;    p[2].y = ctx->y + ctx->size - 1;
+    p[3].x = ctx->x;                    p[3].y = ctx->y + ctx->size - 1;
+    p[4] = p[0];
+    gui_draw_poly(&ctx->disp, p, GUI_COUNT_OF(p), GUI_COLOR_BLACK);
+}
+
+static void
+draw_filledpoly(const bench_ctx_t* ctx) {
+    gui_draw_poly_t p[6];
+
+    p[0].x = ctx->x;                            p[0].y = ctx->y;
+    p[1].x = ctx->x + ctx->size - 1;            p[1].y = ctx->y + ctx->size / 4;
+    p[2].x = ctx->x + ctx->size / 2;            p[2].y = ctx->y + ctx->size / 2;
+    p[3].x = ctx->x + ctx->size - 1;            p[3].y = ctx->y + ctx->size - 1;
+    p[4].x = ctx->x;                            p[4].y = ctx->y + ctx->size - 1;
+    p[5].x = ctx->x + ctx->size / 4;            p[5].y = ctx->y + ctx->size / 2;
+    gui_draw_filledpoly(&ctx->disp, p, GUI_COUNT_OF(p), GUI_COLOR_BLACK);
+}
+
+static void
+draw_scrollbar(const bench_ctx_t* ctx) {
+    gui_draw_sb_t sb;
+
+    gui_draw_scrollbar_init(&sb);
+    sb.x = ctx->x;
+    sb.y = ctx->y;
+    sb.width = ctx->size;
+    sb.height = ctx->size;
+    sb.dir = GUI_DRAW_SB_DIR_VERTICAL;
+    sb.entriestotal = 100;
+    sb.entriesvisible = 10;
+    sb.entriestop = 30;
+    gui_draw_scrollbar(&ctx->disp, &sb);
+}
+
+static void
+draw_image(const bench_ctx_t* ctx, uint8_t bpp) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = bpp;
+    img.image = img_data[bpp / 8 - 2];
+    gui_draw_image((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img);
+}
+
+static void
+draw_image16(const bench_ctx_t* ctx) {
+    draw_image(ctx, 16);
+}
+
+static void
+draw_image24(const bench_ctx_t* ctx) {
+    draw_image(ctx, 24);
+}
+
+static void
+draw_image32(const bench_ctx_t* ctx) {
+    draw_image(ctx, 32);
+}
+
+/**
+ * \brief           Create round 32-bit icon of given size, with transparent corners,
+ *                  opaque center and anti-aliased edge
+ * \note            Created in warm up call, when size changes
+ * \return          Icon image data
+ */
+static const uint8_t*
+create_icon(uint8_t premul, gui_dim_t size) {
+    static uint8_t* icon_data[2];
+    static gui_dim_t icon_size[2];
+    int32_t x, y, d, r2 = (int32_t)size * size;
+    uint32_t a, c[3];
+    uint8_t* p;
+    size_t i;
+
+    if (icon_data[premul] != NULL && icon_size[premul] == size) {
+        return icon_data[premul];
+    }
+    free(icon_data[premul]);
+    if ((p = icon_data[premul] = malloc((size_t)size * size * 4)) == NULL) {
+        return NULL;
+    }
+    icon_size[premul] = size;
+    for (y = 0; y < size; y++) {
+        for (x = 0; x < size; x++, p += 4) {
+            d = (2 * x + 1 - size) * (2 * x + 1 - size) + (2 * y + 1 - size) * (2 * y + 1 - size);
+            d = (r2 - d) * 32 / size;               /* Distance from edge, edge is 2 pixels wide */
+            a = d <= 0 ? 0 : d >= 0xFF ? 0xFF : (uint32_t)d;
+            c[0] = (uint32_t)x * 255 / size;
+            c[1] = (uint32_t)y * 255 / size;
+            c[2] = c[0] ^ c[1];
+            for (i = 0; i < 3; i++) {
+                p[i] = (uint8_t)(premul || a == 0 ? (c[i] * a + 127) / 255 : c[i]);
+            }
+            p[3] = (uint8_t)(0xFF - a);             /* Inverted alpha */
+        }
+    }
+    return icon_data[premul];
+}
+
+/**
+ * \brief           Draw round 32-bit icon with straight or premultiplied alpha
+ */
+static void
+draw_image_icon(const bench_ctx_t* ctx, uint8_t premul) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = 32;
+    img.image = create_icon(premul, ctx->size);
+    img.flags = premul ? GUI_IMAGE_FLAG_PREMULTIPLIED : 0;
+    gui_draw_image((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img);
+}
+
+static void
+draw_image_icon_straight(const bench_ctx_t* ctx) {
+    draw_image_icon(ctx, 0);
+}
+
+static void
+draw_image_icon_premul(const bench_ctx_t* ctx) {
+    draw_image_icon(ctx, 1);
+}
+
+/**
+ * \brief           Encode 32-bit test image of given size to RLE or QOI format
+ * \note            Encoded in warm up call, when size changes
+ * \return          Encoded image data
+ */
+static const uint8_t*
+encode_image(gui_image_format_t format, gui_dim_t size) {
+    static uint8_t* enc_data[2];
+    static gui_dim_t enc_size[2];
+    gui_color_t index[64] = {0}, prev = 0xFF000000UL, c;
+    size_t i, n, run = 0, h, count = (size_t)size * size;
+    uint8_t *out, *s, rep, e = format == GUI_IMAGE_FORMAT_QOI;
+    int vr, vg, vb;
+
+    if (enc_data[e] != NULL && enc_size[e] == size) {
+        return enc_data[e];
+    }
+    free(enc_data[e]);
+    if ((out = enc_data[e] = malloc(5 * count + 32)) == NULL) {
+        return NULL;
+    }
+    enc_size[e] = size;
+    if (format == GUI_IMAGE_FORMAT_RLE) {
+        for (i = 0; i < count; i += n) {
+            s = &img_data[2][4 * i];
+            for (n = 1; i + n < count && n < GUI_IMAGE_RLE_RUN_MAX && !memcmp(s, s + 4 * n, 4); n++) {}
+            rep = n > 1;
+            if (!rep) {                         /* Literal run ends where next repeated pixels start */
+                for (n = 1; i + n < count && n < GUI_IMAGE_RLE_RUN_MAX
+                    && (i + n + 1 >= count || memcmp(s + 4 * n, s + 4 * n + 4, 4)); n++) {}
+            }
+            *out++ = (uint8_t)((rep ? GUI_IMAGE_RLE_REPEAT : 0) | (n - 1));
+            for (h = 0; h < (rep ? 1 : n); h++, s += 4) {
+                *out++ = s[2];                  /* ARGB8888, least significant byte first */
+                *out++ = s[1];
+                *out++ = s[0];
+                *out++ = (uint8_t)(0xFF - s[3]);
+            }
+        }
+        return enc_data[e];
+    }
+
+    memset(out, 0x00, 14);                      /* Header is skipped by decoder */
+    out += 14;
+    for (i = 0, s = img_data[2]; i < count; i++, s += 4) {
+        c = ((gui_color_t)(0xFF - s[3]) << 24) | ((gui_color_t)s[0] << 16) | ((gui_color_t)s[1] << 8) | s[2];
+        if (c == prev) {
+            if (++run == 62 || i + 1 == count) {
+                *out++ = (uint8_t)(0xC0 | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            *out++ = (uint8_t)(0xC0 | (run - 1));
+            run = 0;
+        }
+        h = (s[0] * 3 + s[1] * 5 + s[2] * 7 + (c >> 24) * 11) & 0x3F;
+        vr = (signed char)(s[0] - ((prev >> 16) & 0xFF));
+        vg = (signed char)(s[1] - ((prev >> 8) & 0xFF));
+        vb = (signed char)(s[2] - (prev & 0xFF));
+        if (index[h] == c) {
+            *out++ = (uint8_t)h;
+        } else if ((c >> 24) != (prev >> 24)) {
+            *out++ = 0xFF;
+            *out++ = s[0];
+            *out++ = s[1];
+            *out++ = s[2];
+            *out++ = (uint8_t)(c >> 24);
+        } else if (vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1) {
+            *out++ = (uint8_t)(0x40 | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2));
+        } else if (vg >= -32 && vg <= 31 && vr - vg >= -8 && vr - vg <= 7 && vb - vg >= -8 && vb - vg <= 7) {
+            *out++ = (uint8_t)(0x80 | (vg + 32));
+            *out++ = (uint8_t)(((vr - vg + 8) << 4) | (vb - vg + 8));
+        } else {
+            *out++ = 0xFE;
+            *out++ = s[0];
+            *out++ = s[1];
+            *out++ = s[2];
+        }
+        index[h] = c;
+        prev = c;
+    }
+    return enc_data[e];
+}
+
+static void
+draw_image_encoded(const bench_ctx_t* ctx, gui_image_format_t format) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = 32;
+    img.format = format;
+    img.image = encode_image(format, ctx->size);
+    gui_draw_image((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img);
+}
+
+static void
+draw_image_rle(const bench_ctx_t* ctx) {
+    draw_image_encoded(ctx, GUI_IMAGE_FORMAT_RLE);
+}
+
+static void
+draw_image_qoi(const bench_ctx_t* ctx) {
+    draw_image_encoded(ctx, GUI_IMAGE_FORMAT_QOI);
+}
+
+/**
+ * \brief           Draw 32-bit image of half size scaled to full size
+ */
+static void
+draw_image_scaled(const bench_ctx_t* ctx, gui_image_filter_t filter) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size / 2 + 1;
+    img.y_size = ctx->size / 2 + 1;
+    img.bpp = 32;
+    img.image = img_data[2];
+    gui_draw_image_scaled((gui_display_t *)&ctx->disp, ctx->x, ctx->y, ctx->size, ctx->size, &img, filter);
+}
+
+static void
+draw_image_scaled_nearest(const bench_ctx_t* ctx) {
+    draw_image_scaled(ctx, GUI_IMAGE_FILTER_NEAREST);
+}
+
+static void
+draw_image_scaled_bilinear(const bench_ctx_t* ctx) {
+    draw_image_scaled(ctx, GUI_IMAGE_FILTER_BILINEAR);
+}
+
+static void
+draw_image_rotated(const bench_ctx_t* ctx) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = 32;
+    img.image = img_data[2];
+    gui_draw_image_rotated((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img, GUI_IMAGE_ROTATE_90);
+}
+
+/**
+ * \brief           Draw centered part of largest 32-bit image in original size, as sprite from sprite sheet
+ */
+static void
+draw_image_part(const bench_ctx_t* ctx) {
+    gui_image_desc_t img;
+    gui_dim_t offset;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = sizes[GUI_COUNT_OF(sizes) - 1];
+    img.y_size = sizes[GUI_COUNT_OF(sizes) - 1];
+    img.bpp = 32;
+    img.image = img_data[2];
+    offset = (img.x_size - ctx->size) / 2;
+    gui_draw_image_part((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img, offset, offset, ctx->size, ctx->size);
+}
+
+/**
+ * \brief           Draw center quarter of 32-bit image rotated and scaled to full size
+ */
+static void
+draw_image_blit(const bench_ctx_t* ctx) {
+    gui_image_desc_t img;
+    gui_image_blit_t b;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = 32;
+    img.image = img_data[2];
+    gui_draw_image_blit_init(&b);
+    b.src_x = ctx->size / 4;
+    b.src_y = ctx->size / 4;
+    b.src_width = ctx->size / 2;
+    b.src_height = ctx->size / 2;
+    b.width = ctx->size;
+    b.height = ctx->size;
+    b.rotate = GUI_IMAGE_ROTATE_270;
+    b.filter = GUI_IMAGE_FILTER_BILINEAR;
+    gui_draw_image_blit((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img, &b);
+}
+
+/**
+ * \brief           Draw 4-bit indexed image, first 16 bytes of 32-bit image are used as pixel indexes
+ */
+static void
+draw_image_indexed(const bench_ctx_t* ctx) {
+    static const gui_color_t palette[16] = {
+        0x00000000, 0xFF000000, 0xFF800000, 0xFF008000, 0xFF808000, 0xFF000080, 0xFF800080, 0xFF008080,
+        0xFFC0C0C0, 0xFF808080, 0xFFFF0000, 0xFF00FF00, 0x80FFFF00, 0x800000FF, 0x80FF00FF, 0xFFFFFFFF,
+    };
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = ctx->size;
+    img.y_size = ctx->size;
+    img.bpp = 4;
+    img.format = GUI_IMAGE_FORMAT_INDEXED;
+    img.palette = palette;
+    img.image = img_data[2];
+    gui_draw_image((gui_display_t *)&ctx->disp, ctx->x, ctx->y, &img);
+}
+
+static void
+draw_text(const bench_ctx_t* ctx, const gui_font_t* font, gui_draw_text_cache_t* cache) {
+    gui_draw_text_t f;
+
+    gui_draw_text_init(&f);
+    f.x = ctx->x;
+    f.y = ctx->y;
+    f.width = ctx->size;
+    f.height = font->size;
+    f.align = GUI_HALIGN_LEFT | GUI_VALIGN_TOP;
+    f.color1width = f.width;
+    f.color1 = GUI_COLOR_BLACK;
+    f.cache = cache;
+    gui_draw_writetext(&ctx->disp, font, ctx->text, &f);
+}
+
+static void
+draw_text_aa(const bench_ctx_t* ctx) {
+    draw_text(ctx, &GUI_Font_Arial_Bold_18, NULL);
+}
+
+static void
+draw_text_mono(const bench_ctx_t* ctx) {
+    draw_text(ctx, &GUI_Font_Comic_Sans_MS_Regular_22, NULL);
+}
+
+/**
+ * \brief           Draw anti-aliased text, layout is reused from cache when text cache is enabled
+ */
+static void
+draw_text_cached(const bench_ctx_t* ctx) {
+    draw_text(ctx, &GUI_Font_Arial_Bold_18, &text_cache);
+}
+
+static const bench_case_t
+cases[] = {
+    {"fillscreen",               draw_fillscreen,                0, NULL},
+    {"setpixel",                 draw_setpixel,                  0, NULL},
+    {"getpixel",                 draw_getpixel,                  0, NULL},
+    {"hline",                    draw_hline,                     1, NULL},
+    {"vline",                    draw_vline,                     1, NULL},
+    {"line",                     draw_line,                      1, NULL},
+    {"line_aa",                  draw_line_aa,                   1, NULL},
+    {"rectangle",                draw_rectangle,                 1, NULL},
+    {"filledrectangle",          draw_filledrectangle,           1, NULL},
+    {"filledrectangle_alpha",    draw_filledrectangle_alpha,     1, NULL},
+    {"rectangle3d",              draw_rectangle3d,               1, NULL},
+    {"roundedrectangle",         draw_roundedrectangle,          1, NULL},
+    {"filledroundedrectangle",   draw_filledroundedrectangle,    1, NULL},
+    {"circle",                   draw_circle,                    1, NULL},
+    {"filledcircle",             draw_filledcircle,              1, NULL},
+    {"roundedrectangle_aa",      draw_roundedrectangle_aa,       1, NULL},
+    {"filledroundedrectangle_aa", draw_filledroundedrectangle_aa, 1, NULL},
+    {"circle_aa",                draw_circle_aa,                 1, NULL},
+    {"filledcircle_aa",          draw_filledcircle_aa,           1, NULL},
+    {"arc",                      draw_arc,                       1, NULL},
+    {"pie",                      draw_pie,                       1, NULL},
+    {"ring",                     draw_ring,                      1, NULL},
+    {"circlecorner",             draw_circlecorner,              1, NULL},
+    {"filledcirclecorner",       draw_filledcirclecorner,        1, NULL},
+    {"triangle",                 draw_triangle,                  1, NULL},
+    {"filledtriangle",           draw_filledtriangle,            1, NULL},
+    {"poly",                     draw_poly,                      1, NULL},
+    {"filledpoly",               draw_filledpoly,                1, NULL},
+    {"scrollbar",                draw_scrollbar,                 1, NULL},
+    {"image16",                  draw_image16,                   1, NULL},
+    {"image24",                  draw_image24,                   1, NULL},
+    {"image32",                  draw_image32,                   1, NULL},
+    {"image_icon",               draw_image_icon_straight,       1, NULL},
+    {"image_icon_premul",        draw_image_icon_premul,         1, NULL},
+    {"image_indexed",            draw_image_indexed,             1, NULL},
+    {"image_rle",                draw_image_rle,                 1, NULL},
+    {"image_qoi",                draw_image_qoi,                 1, NULL},
+    {"image_scaled_nearest",     draw_image_scaled_nearest,      1, NULL},
+    {"image_scaled_bilinear",    draw_image_scaled_bilinear,     1, NULL},
+    {"image_rotated",            draw_image_rotated,             1, NULL},
+    {"image_part",               draw_image_part,                1, NULL},
+    {"image_blit",               draw_image_blit,                1, NULL},
+    {"writetext_aa",             draw_text_aa,                   1, &GUI_Font_Arial_Bold_18},
+    {"writetext",                draw_text_mono,                 1, &GUI_Font_Comic_Sans_MS_Regular_22},
+    {"writetext_cached",         draw_text_cached,               1, &GUI_Font_Arial_Bold_18},
+};
+
+static const char* const clip_names[] = {"full", "partial", "outside"};
+
+/**
+ * \brief           Get monotonic time in units of nanoseconds
+ */
+static double
+get_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * \brief           Get number of pixels modified by single call of case
+ *
+ *                  Screen is cleared with background color, primitive is drawn once
+ *                  and all pixels different from background are counted
+ */
+static size_t
+count_pixels(const bench_case_t* c, const bench_ctx_t* ctx) {
+    gui_display_t disp = {0, 0, 0, 0};
+    gui_color_t bg;
+    gui_dim_t x, y;
+    size_t count = 0;
+
+    disp.x2 = lcd_width;
+    disp.y2 = lcd_height;
+    gui_draw_fillscreen(&disp, 0xFF123456);
+    bg = gui_draw_getpixel(&disp, 0, 0);        /* Primitives never reach top left pixel */
+    c->fn(ctx);
+    for (y = 0; y < lcd_height; y++) {
+        for (x = 0; x < lcd_width; x++) {
+            count += gui_draw_getpixel(&disp, x, y) != bg;
+        }
+    }
+    return count;
+}
+
+/**
+ * \brief           Copy part of benchmark text which fits into box
+ * \param[in]       font: Font used for drawing
+ * \param[in]       width: Box width in units of pixels
+ * \return          Text to draw
+ */
+static const gui_char*
+get_text(const gui_font_t* font, gui_dim_t width) {
+    gui_dim_t w, h, total = 0;
+    size_t i;
+
+    for (i = 0; bench_text[i]; i++) {
+        gui_text_getcharsize(font, bench_text[i], &w, &h);
+        if (total + w > width) {
+            break;
+        }
+        total += w;
+        text_buff[i] = bench_text[i];
+    }
+    text_buff[i] = 0;
+    return text_buff;
+}
+
+/**
+ * \brief           Create test images with gradient and varying alpha
+ */
+static uint8_t
+create_images(gui_dim_t size) {
+    size_t x, y, i, count = (size_t)size * size;
+
+    for (i = 0; i < 3; i++) {
+        img_data[i] = malloc(count * (i + 2));
+        if (img_data[i] == NULL) {
+            return 0;
+        }
+    }
+    for (y = 0; y < (size_t)size; y++) {
+        for (x = 0; x < (size_t)size; x++) {
+            uint8_t r = (uint8_t)(x * 255 / size), g = (uint8_t)(y * 255 / size), b = (uint8_t)(r ^ g);
+            uint16_t c16 = (uint16_t)(((b >> 3) << 11) | ((g >> 2) << 5) | (r >> 3));
+
+            i = y * size + x;
+            img_data[0][2 * i + 0] = (uint8_t)c16;
+            img_data[0][2 * i + 1] = (uint8_t)(c16 >> 8);
+            img_data[1][3 * i + 0] = r;
+            img_data[1][3 * i + 1] = g;
+            img_data[1][3 * i + 2] = b;
+            img_data[2][4 * i + 0] = r;
+            img_data[2][4 * i + 1] = g;
+            img_data[2][4 * i + 2] = b;
+            img_data[2][4 * i + 3] = (uint8_t)((x / 8) & 0x01 ? 0x00 : x * 255 / size);   /* Opaque and blended columns */
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Run single case until minimal time passes
+ * \param[out]      calls: Number of calls made
+ * \return          Total time in units of nanoseconds
+ */
+static double
+run_case(const bench_case_t* c, const bench_ctx_t* ctx, double min_time, uint32_t* calls) {
+    double start, total = 0;
+    uint32_t i, batch = 1;
+
+    c->fn(ctx);                                 /* Warm up caches */
+    *calls = 0;
+    while (total < min_time) {
+        start = get_time_ns();
+        for (i = 0; i < batch; i++) {
+            c->fn(ctx);
+        }
+        total += get_time_ns() - start;
+        *calls += batch;
+        if (batch < 0x100000) {
+            batch <<= 1;
+        }
+    }
+    return total;
+}
+
+/**
+ * \brief           Set clipping region and position for case
+ */
+static void
+setup_ctx(bench_ctx_t* ctx, bench_clip_t clip, gui_dim_t size) {
+    ctx->x = 8;
+    ctx->y = 8;
+    ctx->size = size;
+    ctx->disp.x1 = 0;
+    ctx->disp.y1 = 0;
+    ctx->disp.x2 = lcd_width;
+    ctx->disp.y2 = lcd_height;
+    if (clip == BENCH_CLIP_PARTIAL) {
+        ctx->disp.x1 = ctx->x + size / 2;
+    } else if (clip == BENCH_CLIP_OUTSIDE) {
+        ctx->disp.x1 = lcd_width - 1;       /* Primitives never reach bottom right pixel */
+        ctx->disp.y1 = lcd_height - 1;
+    }
+}
+
+int
+main(int argc, char** argv) {
+    const char* out_path = NULL, *filter = NULL;
+    int width = 480, height = 272, pixel_size = 4, time_ms = 200, i;
+    size_t c, s, cl, max_size, count = 0;
+    FILE* out = stdout;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            time_ms = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                fprintf(stderr, "Invalid display size: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            pixel_size = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [-o FILE] [-t MS] [-f FILTER] [-s WIDTHxHEIGHT] [-p PIXEL_SIZE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (width < 32 || height < 32 || (pixel_size != 2 && pixel_size != 4) || time_ms <= 0) {
+        fprintf(stderr, "Invalid display configuration\n");
+        return 1;
+    }
+
+    if (!gui_ll_headless_setup((gui_dim_t)width, (gui_dim_t)height, (uint8_t)pixel_size) || gui_init() != guiOK) {
+        fprintf(stderr, "GUI initialization failed\n");
+        return 1;
+    }
+    lcd_width = (gui_dim_t)width;
+    lcd_height = (gui_dim_t)height;
+    max_size = (size_t)(width < height ? width : height) - 16;
+    if (!create_images(sizes[GUI_COUNT_OF(sizes) - 1])) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    if (out_path != NULL && (out = fopen(out_path, "w")) == NULL) {
+        fprintf(stderr, "Cannot open %s\n", out_path);
+        return 1;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"display\": {\"width\": %d, \"height\": %d, \"pixel_size\": %d},\n", width, height, pixel_size);
+    fprintf(out, "  \"kernels\": \"%s\",\n", gui_ll_soft_getkernels());
+    fprintf(out, "  \"min_time_ms\": %d,\n", time_ms);
+    fprintf(out, "  \"results\": [");
+    for (c = 0; c < GUI_COUNT_OF(cases); c++) {
+        const bench_case_t* bc = &cases[c];
+
+        if (filter != NULL && strstr(bc->name, filter) == NULL) {
+            continue;
+        }
+        for (s = 0; s < (bc->sized ? GUI_COUNT_OF(sizes) : 1); s++) {
+            if (bc->sized && (size_t)sizes[s] > max_size) {
+                break;
+            }
+            for (cl = 0; cl < (bc->sized ? GUI_COUNT_OF(clip_names) : 1); cl++) {
+                bench_ctx_t ctx;
+                double total, ns, mpix;
+                uint32_t calls;
+                size_t pixels;
+
+                setup_ctx(&ctx, (bench_clip_t)cl, bc->sized ? sizes[s] : 0);
+                ctx.text = bc->font != NULL ? get_text(bc->font, ctx.size) : NULL;
+                total = run_case(bc, &ctx, (double)time_ms * 1e6, &calls);
+
+                pixels = count_pixels(bc, &ctx);
+                ns = total / calls;
+                mpix = (double)pixels * 1e3 / ns;   /* Pixels per nanosecond to millions per second */
+
+                fprintf(out, "%s\n    {\"name\": \"%s\", \"size\": %d, \"clip\": \"%s\", \"calls\": %lu, "
+                    "\"ns_per_call\": %.1f, \"pixels_per_call\": %lu, \"mpix_per_s\": %.2f}",
+                    count++ ? "," : "", bc->name, (int)ctx.size, clip_names[cl], (unsigned long)calls, ns, (unsigned long)pixels, mpix);
+                fprintf(stderr, "%-24s %4d %-8s %12.1f ns/call %10.2f Mpix/s\n",
+                    bc->name, (int)ctx.size, clip_names[cl], ns, mpix);
+            }
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    for (i = 0; i < 3; i++) {
+        free(img_data[i]);
+    }
+    gui_draw_text_cachefree(&text_cache);
+    return 0;
+}
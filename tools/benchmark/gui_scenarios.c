@@ -0,0 +1,607 @@
+/**
+ * \file            gui_scenarios.c
+ * \brief           Whole-frame benchmark scenarios from demo screens
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+
+/*
+ * Scenarios create feature screens from "examples_demo" on 800x480 headless display,
+ * replay scripted input on them (list scrolls, slider drags, dropdown open and close, typing)
+ * and measure every frame drawn by GUI as result of input, written as JSON.
+ *
+ * Each scenario runs in its own process with new GUI instance,
+ * so heap usage of one screen does not affect next one.
+ *
+ * For each scenario:
+ *
+ *  - "create_ns": Time to create widgets of screen
+ *  - "first_frame": Time, widgets and pixels of first full frame of screen
+ *  - "frame_ns": Mean and percentiles of time for frames drawn after input
+ *  - "pixels_per_frame": Pixels in dirty rectangles per frame
+ *  - "widgets_per_frame": Widgets drawn per frame
+ *  - "heap": Total heap, heap used at the end, maximal heap used during scenario
+ *      and fragmentation of free heap in percent at the end
+ *
+ * Frame time is time of \ref gui_process call which drew new frame, including input processing.
+ *
+ * Build from repository root, together with all sources from "src/gui" and "src/widget"
+ * and all demo sources from "examples_demo" except "demo_init.c":
+ *
+ *  gcc -O2 -Itools/benchmark -Isrc/include -Iexamples_demo/include tools/benchmark/gui_scenarios.c \
+ *      $GUI_SOURCES $DEMO_SOURCES src/fonts/Arial_Bold_AA.c src/fonts/Calibri_Bold.c \
+ *      src/system/gui_ll_headless.c src/system/gui_ll_soft.c src/system/gui_sys_posix.c -lm -o gui_scenarios
+ *
+ * Add -DGUI_CFG_USE_RENDER_TILES=1 to measure tile renderer. Last frames written with -d
+ * must be equal to last frames of build without tiles.
+ *
+ * Usage:
+ *
+ *  gui_scenarios [-o FILE] [-r REPEAT] [-f FILTER] [-d DIR] [-p DIR]
+ *
+ *  -o: Output JSON file, standard output by default
+ *  -r: Number of times input script is replayed, default 3
+ *  -f: Run only scenarios with name containing FILTER
+ *  -d: Write last frame of each scenario as PNG file to DIR
+ *  -p: Write profiler trace of each scenario as Chrome trace-event JSON file to DIR,
+ *      available when built with -DGUI_CFG_USE_PROFILER=1
+ */
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200112L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE                 200112L
+#endif
+#include "demo.h"
+#include "gui/gui_mem.h"
+#include "gui/gui_profiler.h"
+#include "system/gui_ll_headless.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define SCN_WIDTH                       800
+#define SCN_HEIGHT                      480
+
+/* Time after click when second press is no longer double click, see click detection in gui.c */
+#define SCN_CLICK_WAIT                  320
+
+extern gui_const gui_font_t GUI_Font_Arial_Bold_18;
+
+/**
+ * \brief           Input action type
+ */
+typedef enum {
+    SCN_TAP = 0x00,                             /*!< Press and release at position */
+    SCN_DRAG,                                   /*!< Press, move in steps and release */
+    SCN_KEYS,                                   /*!< Send characters of string as keys */
+    SCN_WAIT,                                   /*!< Process GUI for some time without input */
+    SCN_CALL,                                   /*!< Call function in steps, as application updates widgets */
+} scn_type_t;
+
+/**
+ * \brief           Application update function of scenario
+ * \param[in]       screen: Feature screen container
+ * \param[in]       step: Step number, starting with `1`
+ */
+typedef void (*scn_call_fn)(gui_handle_p screen, uint32_t step);
+
+/**
+ * \brief           Input action of scenario
+ */
+typedef struct {
+    scn_type_t type;                            /*!< Action type */
+    gui_dim_t x1;                               /*!< Start X position on screen */
+    gui_dim_t y1;                               /*!< Start Y position on screen */
+    gui_dim_t x2;                               /*!< End X position on screen for drag */
+    gui_dim_t y2;                               /*!< End Y position on screen for drag */
+    uint32_t n;                                 /*!< Number of drag or call steps or wait time in units of milliseconds */
+    const char* keys;                           /*!< Keys to send */
+    scn_call_fn fn;                             /*!< Function to call */
+} scn_action_t;
+
+#define TAP(x, y)                       {SCN_TAP, (x), (y), 0, 0, 0, NULL, NULL}
+#define DRAG(x1, y1, x2, y2, n)         {SCN_DRAG, (x1), (y1), (x2), (y2), (n), NULL, NULL}
+#define KEYS(k)                         {SCN_KEYS, 0, 0, 0, 0, 0, (k), NULL}
+#define WAIT(ms)                        {SCN_WAIT, 0, 0, 0, 0, (ms), NULL, NULL}
+#define CALL(f, n)                      {SCN_CALL, 0, 0, 0, 0, (n), NULL, (f)}
+
+/**
+ * \brief           Benchmark scenario
+ */
+typedef struct {
+    const char* name;                           /*!< Scenario name */
+    win_data_t win;                             /*!< Demo feature screen */
+    const scn_action_t* actions;                /*!< Input script */
+    size_t actions_count;                       /*!< Number of actions in script */
+} scn_t;
+
+/**
+ * \brief           Measurement of single frame
+ */
+typedef struct {
+    double ns;                                  /*!< Time of process call in units of nanoseconds */
+    uint32_t widgets;                           /*!< Number of drawn widgets */
+    uint32_t pixels;                            /*!< Number of pixels in dirty rectangles */
+    uint32_t rects;                             /*!< Number of dirty rectangles */
+} scn_frame_t;
+
+/* Application updates of widgets without input */
+static void
+scn_progbar_set(gui_handle_p screen, uint32_t step) {
+    GUI_UNUSED(screen);
+    gui_progbar_setvalue(gui_widget_getbyid(ID_PROGBAR), (int32_t)(step * 5 % 100));
+}
+
+static void
+scn_debugbox_add(gui_handle_p screen, uint32_t step) {
+    gui_char str[20];
+
+    GUI_UNUSED(screen);
+    sprintf((char *)str, "Log line %u", (unsigned)step);
+    gui_debugbox_addstring(gui_widget_getbyid(ID_DEBUGBOX), str);
+}
+
+static void
+scn_text_view_scroll(gui_handle_p screen, uint32_t step) {
+    gui_widget_setscrolly(screen, (gui_dim_t)(step <= 20 ? 4 * step : 4 * (40 - step)));
+}
+
+/* Feature container of demo screens starts at (248, 4) on 800x480 display */
+static const scn_action_t act_button[] = {
+    TAP(408, 129), TAP(408, 229),
+};
+static const scn_action_t act_edit_text[] = {
+    TAP(508, 22),                               /* Focus first edit, virtual keyboard opens */
+    TAP(480, 329), TAP(200, 269), TAP(720, 329), TAP(720, 329), TAP(680, 269),  /* "hello" */
+    TAP(320, 449), TAP(740, 389),               /* Space and backspace */
+    TAP(760, 449),                              /* Hide keyboard */
+    KEYS(" EasyGUI"), KEYS("\b\b\b\b\b\b\b"),   /* Hardware keys on visible edit */
+    TAP(508, 104),                              /* Focus second edit */
+    TAP(360, 269), TAP(480, 329), TAP(200, 269), TAP(320, 449),  /* "the " */
+    TAP(560, 389), TAP(680, 269), TAP(240, 389), /* "nox" */
+    TAP(760, 449),
+};
+static const scn_action_t act_list_container[] = {
+    DRAG(648, 404, 648, 64, 20), DRAG(648, 64, 648, 404, 20),
+};
+static const scn_action_t act_slider[] = {
+    DRAG(333, 29, 538, 29, 20), DRAG(538, 29, 278, 29, 20),
+    DRAG(283, 304, 283, 74, 20), DRAG(283, 74, 283, 334, 20),
+};
+static const scn_action_t act_listbox[] = {
+    DRAG(518, 384, 518, 84, 20), DRAG(518, 84, 518, 384, 20), TAP(518, 154),
+};
+static const scn_action_t act_listview[] = {
+    DRAG(518, 424, 518, 64, 20), DRAG(518, 64, 518, 424, 20), TAP(518, 154),
+};
+static const scn_action_t act_dropdown[] = {
+    TAP(383, 33), TAP(383, 104),                /* Open down and select item */
+    TAP(655, 323), TAP(655, 254),               /* Open up and select item */
+};
+static const scn_action_t act_checkbox[] = {
+    TAP(408, 34), TAP(408, 84), TAP(408, 134), TAP(408, 34),
+};
+static const scn_action_t act_radio[] = {
+    TAP(408, 34), TAP(408, 84), TAP(408, 234), TAP(408, 324),
+};
+static const scn_action_t act_window[] = {
+    DRAG(400, 36, 480, 96, 20), DRAG(480, 96, 400, 36, 20),   /* Move outer window by title */
+};
+static const scn_action_t act_graph[] = {
+    DRAG(520, 260, 420, 200, 20), DRAG(420, 200, 520, 260, 20),   /* Move graph area */
+    TAP(270, 29), TAP(270, 29),                 /* Expand and restore graph */
+};
+static const scn_action_t act_led[] = {
+    TAP(278, 34), TAP(328, 34), TAP(278, 84), TAP(328, 84),
+};
+static const scn_action_t act_debugbox[] = {
+    CALL(scn_debugbox_add, 20),                 /* Append lines, last one stays visible */
+    DRAG(520, 404, 520, 64, 20), DRAG(520, 64, 520, 404, 20),
+};
+
+static const scn_action_t act_progbar[] = {
+    CALL(scn_progbar_set, 20),
+};
+static const scn_action_t act_text_view[] = {
+    CALL(scn_text_view_scroll, 40),             /* Scroll text views down and back */
+};
+
+#define SCN(name, id, fn, act)          {name, {id, _GT(name), fn}, act, GUI_COUNT_OF(act)}
+
+static const scn_t
+scenarios[] = {
+    SCN("window", ID_WIN_WINDOW, demo_create_feature_window, act_window),
+    SCN("button", ID_WIN_BUTTONS, demo_create_feature_button, act_button),
+    SCN("edit_text", ID_WIN_EDITTEXT, demo_create_feature_edit_text, act_edit_text),
+    SCN("graph", ID_WIN_GRAPH, demo_create_feature_graph, act_graph),
+    SCN("progbar", ID_WIN_PROGBAR, demo_create_feature_progbar, act_progbar),
+    SCN("led", ID_WIN_LED, demo_create_feature_led, act_led),
+    SCN("list_container", ID_WIN_LIST_CONTAINER, demo_create_feature_list_container, act_list_container),
+    SCN("text_view", ID_WIN_TEXTVIEW, demo_create_feature_text_view, act_text_view),
+    SCN("slider", ID_WIN_SLIDER, demo_create_feature_slider, act_slider),
+    SCN("listbox", ID_WIN_LISTBOX, demo_create_feature_listbox, act_listbox),
+    SCN("listview", ID_WIN_LISTVIEW, demo_create_feature_listview, act_listview),
+    SCN("debugbox", ID_WIN_DEBUGBOX, demo_create_feature_debugbox, act_debugbox),
+    SCN("dropdown", ID_WIN_DROPDOWN, demo_create_feature_dropdown, act_dropdown),
+    SCN("checkbox", ID_WIN_CHECKBOX, demo_create_feature_checkbox, act_checkbox),
+    SCN("radio", ID_WIN_RADIO, demo_create_feature_radio, act_radio),
+};
+
+static gui_id_t screen_id;                      /* ID of feature screen container of current scenario */
+static scn_frame_t* frames;                     /* Frames measured after input */
+static size_t frames_count, frames_size;
+
+/**
+ * \brief           Get monotonic time in units of nanoseconds
+ */
+static double
+get_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * \brief           Call process function once and measure it
+ * \param[out]      frame: Frame measurement, filled when new frame was drawn
+ * \return          `1` when new frame was drawn, `0` otherwise
+ */
+static uint8_t
+process_once(scn_frame_t* frame) {
+    gui_redrawstats_t before, after;
+    double start;
+
+    gui_getredrawstats(&before);
+    start = get_time_ns();
+    gui_process();
+    frame->ns = get_time_ns() - start;
+    gui_getredrawstats(&after);
+    if (after.frames == before.frames) {
+        return 0;
+    }
+    frame->widgets = after.widgets;
+    frame->pixels = after.pixels;
+    frame->rects = after.rects;
+    return 1;
+}
+
+/**
+ * \brief           Process GUI until there is nothing more to draw and save frames
+ */
+static void
+settle(void) {
+    scn_frame_t frame;
+    size_t i;
+
+    for (i = 0; i < 16 && process_once(&frame); i++) {
+        if (frames_count == frames_size) {
+            frames_size = frames_size ? 2 * frames_size : 256;
+            frames = realloc(frames, frames_size * sizeof(*frames));
+            if (frames == NULL) {
+                fprintf(stderr, "Out of memory\n");
+                exit(1);
+            }
+        }
+        frames[frames_count++] = frame;
+    }
+}
+
+/**
+ * \brief           Process GUI without input for some time
+ * \param[in]       ms: Time in units of milliseconds
+ */
+static void
+wait_ms(uint32_t ms) {
+    struct timespec idle = {0, 1000000};
+    double end = get_time_ns() + (double)ms * 1e6;
+
+    while (get_time_ns() < end) {
+        settle();
+        nanosleep(&idle, NULL);
+    }
+}
+
+/**
+ * \brief           Replay single input action
+ * \param[in]       a: Action to replay
+ */
+static void
+run_action(const scn_action_t* a) {
+    const char* k;
+    uint32_t i;
+
+    switch (a->type) {
+        case SCN_TAP:
+            gui_ll_headless_touch(a->x1, a->y1, 1);
+            settle();
+            gui_ll_headless_touch(a->x1, a->y1, 0);
+            settle();
+            wait_ms(SCN_CLICK_WAIT);
+            break;
+        case SCN_DRAG:
+            gui_ll_headless_touch(a->x1, a->y1, 1);
+            settle();
+            for (i = 1; i <= a->n; i++) {
+                gui_ll_headless_touch(
+                    a->x1 + (gui_dim_t)((int32_t)(a->x2 - a->x1) * (int32_t)i / (int32_t)a->n),
+                    a->y1 + (gui_dim_t)((int32_t)(a->y2 - a->y1) * (int32_t)i / (int32_t)a->n), 1);
+                settle();
+            }
+            gui_ll_headless_touch(a->x2, a->y2, 0);
+            settle();
+            wait_ms(SCN_CLICK_WAIT);
+            break;
+        case SCN_KEYS:
+            for (k = a->keys; *k; k++) {
+                gui_ll_headless_key((uint8_t)*k);
+                settle();
+            }
+            break;
+        case SCN_WAIT:
+            wait_ms(a->n);
+            break;
+        case SCN_CALL:
+            for (i = 1; i <= a->n; i++) {
+                a->fn(gui_widget_getbyid(screen_id), i);
+                settle();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+#if GUI_CFG_USE_PROFILER
+
+/**
+ * \brief           Write part of trace to file
+ */
+static void
+trace_write(const char* str, size_t len, void* arg) {
+    fwrite(str, 1, len, (FILE *)arg);
+}
+
+/**
+ * \brief           Write all recorded profiler events to trace file
+ * \param[in]       dir: Output directory
+ * \param[in]       name: Scenario name
+ */
+static void
+write_trace(const char* dir, const char* name) {
+    char path[256];
+    FILE* f;
+
+    sprintf(path, "%.200s/%s.trace.json", dir, name);
+    if ((f = fopen(path, "w")) == NULL) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return;
+    }
+    gui_profiler_exporttrace(trace_write, f);
+    fclose(f);
+}
+
+#endif /* GUI_CFG_USE_PROFILER */
+
+/**
+ * \brief           Compare function for frame times
+ */
+static int
+cmp_double(const void* a, const void* b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * \brief           Get percentile from sorted values
+ */
+static double
+percentile(const double* sorted, size_t count, double p) {
+    return count ? sorted[(size_t)(p * (double)(count - 1) + 0.5)] : 0;
+}
+
+/**
+ * \brief           Run scenario and write its result
+ * \note            Function is called in new process for each scenario
+ * \param[in]       s: Scenario to run
+ * \param[in]       out: Output file
+ * \param[in]       first: Set to `1` when this is first result in output
+ * \param[in]       repeat: Number of times input script is replayed
+ * \param[in]       dir: Directory for last frame or `NULL`
+ * \param[in]       trace_dir: Directory for profiler trace or `NULL`
+ * \return          `0` on success, `1` otherwise
+ */
+static int
+run_scenario(const scn_t* s, FILE* out, uint8_t first, int repeat, const char* dir, const char* trace_dir) {
+    scn_frame_t first_frame;
+    double start, create_ns, ns_sum = 0, *times;
+    uint64_t pixels_sum = 0, widgets_sum = 0, rects_sum = 0;
+    uint32_t pixels_max = 0, widgets_max = 0;
+    gui_mem_stats_t heap;
+    size_t heap_total, i;
+    int r;
+
+    if (!gui_ll_headless_setup(SCN_WIDTH, SCN_HEIGHT, 4) || gui_init() != guiOK) {
+        fprintf(stderr, "GUI initialization failed\n");
+        return 1;
+    }
+    gui_widget_setfontdefault(&GUI_Font_Arial_Bold_18);
+    gui_keyboard_create();
+    while (process_once(&first_frame)) {}       /* Draw empty desktop first */
+    heap_total = gui_mem_getfree() + gui_mem_getfull();
+#if GUI_CFG_USE_PROFILER
+    gui_profiler_reset();                       /* Trace starts with screen creation */
+#endif /* GUI_CFG_USE_PROFILER */
+
+    start = get_time_ns();
+    demo_create_feature((win_data_t *)&s->win, 0);
+    create_ns = get_time_ns() - start;
+    memset(&first_frame, 0x00, sizeof(first_frame));
+    process_once(&first_frame);
+    settle();                                   /* Initial frames are not part of input measurement */
+    frames_count = 0;
+
+    if (gui_widget_getbyid(s->win.id) == NULL) {
+        fprintf(stderr, "%s: Screen was not created\n", s->name);
+        return 1;
+    }
+
+    for (r = 0; r < repeat; r++) {
+        for (i = 0; i < s->actions_count; i++) {
+            run_action(&s->actions[i]);
+        }
+    }
+
+    times = malloc((frames_count ? frames_count : 1) * sizeof(*times));
+    if (times == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < frames_count; i++) {
+        times[i] = frames[i].ns;
+        ns_sum += frames[i].ns;
+        pixels_sum += frames[i].pixels;
+        widgets_sum += frames[i].widgets;
+        rects_sum += frames[i].rects;
+        if (frames[i].pixels > pixels_max) {
+            pixels_max = frames[i].pixels;
+        }
+        if (frames[i].widgets > widgets_max) {
+            widgets_max = frames[i].widgets;
+        }
+    }
+    qsort(times, frames_count, sizeof(*times), cmp_double);
+    gui_mem_getstats(&heap);
+
+#define SCN_MEAN(sum)                   (frames_count ? (double)(sum) / (double)frames_count : 0)
+    fprintf(out, "%s\n    {\"name\": \"%s\", \"create_ns\": %.0f, "
+        "\"first_frame\": {\"ns\": %.0f, \"widgets\": %lu, \"pixels\": %lu}, \"frames\": %lu,\n"
+        "     \"frame_ns\": {\"mean\": %.0f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"max\": %.0f},\n"
+        "     \"pixels_per_frame\": {\"mean\": %.0f, \"max\": %lu}, "
+        "\"widgets_per_frame\": {\"mean\": %.2f, \"max\": %lu}, \"rects_per_frame\": %.2f,\n"
+        "     \"heap\": {\"total\": %lu, \"used\": %lu, \"peak\": %lu, \"fragmentation\": %u}}",
+        first ? "" : ",", s->name, create_ns,
+        first_frame.ns, (unsigned long)first_frame.widgets, (unsigned long)first_frame.pixels, (unsigned long)frames_count,
+        SCN_MEAN(ns_sum), percentile(times, frames_count, 0.5), percentile(times, frames_count, 0.9),
+        percentile(times, frames_count, 0.99), percentile(times, frames_count, 1),
+        SCN_MEAN(pixels_sum), (unsigned long)pixels_max,
+        SCN_MEAN(widgets_sum), (unsigned long)widgets_max, SCN_MEAN(rects_sum),
+        (unsigned long)heap_total, (unsigned long)gui_mem_getfull(), (unsigned long)(heap_total - gui_mem_getminfree()),
+        (unsigned)heap.fragmentation);
+    fflush(out);
+    fprintf(stderr, "%-16s %5lu frames %10.0f ns/frame p99 %10.0f ns %8.0f pixels/frame %6.2f widgets/frame\n",
+        s->name, (unsigned long)frames_count, SCN_MEAN(ns_sum), percentile(times, frames_count, 0.99),
+        SCN_MEAN(pixels_sum), SCN_MEAN(widgets_sum));
+#undef SCN_MEAN
+
+    if (dir != NULL) {
+        char path[256];
+
+        sprintf(path, "%.200s/%s.png", dir, s->name);
+        if (!gui_ll_headless_writepng(path)) {
+            fprintf(stderr, "Cannot write %s\n", path);
+        }
+    }
+#if GUI_CFG_USE_PROFILER
+    if (trace_dir != NULL) {
+        write_trace(trace_dir, s->name);
+    }
+#else /* GUI_CFG_USE_PROFILER */
+    GUI_UNUSED(trace_dir);
+#endif /* !GUI_CFG_USE_PROFILER */
+    free(times);
+    free(frames);
+    return 0;
+}
+
+int
+main(int argc, char** argv) {
+    const char* out_path = NULL, *filter = NULL, *dir = NULL, *trace_dir = NULL;
+    int repeat = 3, i, status;
+    size_t s, count = 0;
+    FILE* out = stdout;
+    pid_t pid;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            trace_dir = argv[++i];
+#if !GUI_CFG_USE_PROFILER
+            fprintf(stderr, "Profiler is not enabled, build with -DGUI_CFG_USE_PROFILER=1\n");
+            return 1;
+#endif /* !GUI_CFG_USE_PROFILER */
+        } else {
+            fprintf(stderr, "Usage: %s [-o FILE] [-r REPEAT] [-f FILTER] [-d DIR] [-p DIR]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (repeat <= 0) {
+        fprintf(stderr, "Invalid repeat count\n");
+        return 1;
+    }
+    if (out_path != NULL && (out = fopen(out_path, "w")) == NULL) {
+        fprintf(stderr, "Cannot open %s\n", out_path);
+        return 1;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"display\": {\"width\": %d, \"height\": %d, \"pixel_size\": %d},\n", SCN_WIDTH, SCN_HEIGHT, 4);
+    fprintf(out, "  \"repeat\": %d,\n", repeat);
+    fprintf(out, "  \"results\": [");
+    for (s = 0; s < GUI_COUNT_OF(scenarios); s++) {
+        if (filter != NULL && strstr(scenarios[s].name, filter) == NULL) {
+            continue;
+        }
+        fflush(out);                            /* Child process writes to same file */
+        pid = fork();
+        if (pid == 0) {
+            _exit(run_scenario(&scenarios[s], out, count == 0, repeat, dir, trace_dir));
+        } else if (pid < 0 || waitpid(pid, &status, 0) != pid
+            || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "%s: Scenario failed\n", scenarios[s].name);
+        } else {
+            count++;
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
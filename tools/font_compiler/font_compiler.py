@@ -0,0 +1,500 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017 Tilen Majerle
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation
+# files (the "Software"), to deal in the Software without restriction,
+# including without limitation the rights to use, copy, modify, merge,
+# publish, distribute, sublicense, and/or sell copies of the Software,
+# and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+# AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+# HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+# This file is part of EasyGUI library.
+#
+# Author:          Tilen Majerle <tilen@majerle.eu>
+#
+"""
+EasyGUI font compiler
+
+Converts BDF or TTF/OTF font to C source file with gui_font_t structure.
+
+BDF fonts are parsed directly. TTF/OTF fonts are rasterized with FreeType,
+loaded from system library (libfreetype.so), no python packages are required.
+
+Examples:
+
+    # ASCII characters from TTF font, 18 pixels, 4 bits per pixel, compressed
+    font_compiler.py DejaVuSans.ttf --size 18 --bpp 4 --rle -o DejaVu_Sans_18.c
+
+    # Only characters used by application texts, with kerning pairs
+    font_compiler.py Roboto.ttf --size 24 --bpp 2 --text "Settings" \\
+        --text-file strings.txt --kerning --name Roboto_24_App -o Roboto_24_App.c
+
+    # BDF font, characters 0x20 to 0x7E
+    font_compiler.py ter-u16n.bdf --range 0x20-0x7E -o Terminus_16.c
+
+Characters are trimmed to their bounding box. When selected characters
+do not form single continuous range, sparse font with character codes
+table is generated.
+"""
+
+import argparse
+import ctypes
+import ctypes.util
+import os
+import re
+import sys
+
+BPP_FLAGS = {
+    1: "0",
+    2: "GUI_FLAG_FONT_AA",
+    4: "GUI_FLAG_FONT_AA4",
+    8: "GUI_FLAG_FONT_AA8",
+}
+
+RLE_REPEAT = 0x80                   # Must match GUI_FONT_RLE_REPEAT
+RLE_SOLID = 0x40                    # Must match GUI_FONT_RLE_SOLID
+RLE_LITERAL_MAX = 0x80              # Must match GUI_FONT_RLE_LITERAL_MAX
+RLE_REPEAT_MAX = 0x40               # Must match GUI_FONT_RLE_REPEAT_MAX
+
+
+class Glyph:
+    """Rasterized character with coverage values between 0 and 255"""
+
+    def __init__(self, code, width, height, left, top, advance, pixels):
+        self.code = code
+        self.width = width          # Bitmap width
+        self.height = height        # Bitmap height
+        self.left = left            # Bitmap left offset from pen position
+        self.top = top              # Bitmap top row above baseline
+        self.advance = advance      # Pen advance in pixels
+        self.pixels = pixels        # List of rows, each row list of coverage values
+
+    def trim(self):
+        """Remove empty rows and columns around glyph"""
+        rows = [y for y in range(self.height) if any(self.pixels[y])]
+        if not rows:
+            self.width = self.height = 0
+            self.pixels = []
+            return
+        cols = [x for x in range(self.width) if any(r[x] for r in self.pixels)]
+        y1, y2, x1, x2 = rows[0], rows[-1] + 1, cols[0], cols[-1] + 1
+        self.pixels = [r[x1:x2] for r in self.pixels[y1:y2]]
+        self.left += x1
+        self.top -= y1
+        self.width = x2 - x1
+        self.height = y2 - y1
+
+
+class Font:
+    """Loaded font with glyphs and vertical metrics"""
+
+    def __init__(self, family, glyphs, ascent=None, descent=None, kerning=None):
+        self.family = family
+        self.glyphs = glyphs        # Dictionary code -> Glyph
+        self.ascent = ascent        # Pixels above baseline, from glyphs when not known
+        self.descent = descent      # Pixels below baseline, from glyphs when not known
+        self.kerning = kerning      # Function (left, right) -> offset or None
+
+
+#
+# BDF loader
+#
+def load_bdf(path):
+    glyphs = {}
+    family = os.path.splitext(os.path.basename(path))[0]
+    with open(path, "r", encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    code = advance = ascent = descent = None
+    bbx = (0, 0, 0, 0)
+    for line in lines:
+        parts = line.split()
+        if not parts:
+            continue
+        key = parts[0]
+        if key == "FAMILY_NAME":
+            family = line.split(None, 1)[1].strip().strip('"')
+        elif key == "FONT_ASCENT":
+            ascent = int(parts[1])
+        elif key == "FONT_DESCENT":
+            descent = int(parts[1])
+        elif key == "ENCODING":
+            code = int(parts[1])
+        elif key == "DWIDTH":
+            advance = int(parts[1])
+        elif key == "BBX":
+            bbx = tuple(int(v) for v in parts[1:5])
+        elif key == "BITMAP":
+            w, h, xoff, yoff = bbx
+            pixels = []
+            for _ in range(h):
+                bits = int(next(lines).strip() or "0", 16)
+                nbits = ((w + 7) // 8) * 8
+                pixels.append([255 if (bits >> (nbits - 1 - x)) & 1 else 0 for x in range(w)])
+            if code is not None and code >= 0:
+                glyphs[code] = Glyph(code, w, h, xoff, yoff + h, advance if advance is not None else w, pixels)
+            code = advance = None
+    return Font(family, glyphs, ascent, descent)
+
+
+#
+# TTF loader with FreeType over ctypes
+#
+FT_Pos = ctypes.c_long
+FT_Fixed = ctypes.c_long
+
+
+class FT_Generic(ctypes.Structure):
+    _fields_ = [("data", ctypes.c_void_p), ("finalizer", ctypes.c_void_p)]
+
+
+class FT_Vector(ctypes.Structure):
+    _fields_ = [("x", FT_Pos), ("y", FT_Pos)]
+
+
+class FT_BBox(ctypes.Structure):
+    _fields_ = [("xMin", FT_Pos), ("yMin", FT_Pos), ("xMax", FT_Pos), ("yMax", FT_Pos)]
+
+
+class FT_Bitmap(ctypes.Structure):
+    _fields_ = [("rows", ctypes.c_uint), ("width", ctypes.c_uint), ("pitch", ctypes.c_int),
+                ("buffer", ctypes.POINTER(ctypes.c_ubyte)), ("num_grays", ctypes.c_ushort),
+                ("pixel_mode", ctypes.c_ubyte), ("palette_mode", ctypes.c_ubyte),
+                ("palette", ctypes.c_void_p)]
+
+
+class FT_Glyph_Metrics(ctypes.Structure):
+    _fields_ = [(n, FT_Pos) for n in ("width", "height", "horiBearingX", "horiBearingY",
+                                      "horiAdvance", "vertBearingX", "vertBearingY", "vertAdvance")]
+
+
+class FT_GlyphSlotRec(ctypes.Structure):
+    _fields_ = [("library", ctypes.c_void_p), ("face", ctypes.c_void_p), ("next", ctypes.c_void_p),
+                ("glyph_index", ctypes.c_uint), ("generic", FT_Generic), ("metrics", FT_Glyph_Metrics),
+                ("linearHoriAdvance", FT_Fixed), ("linearVertAdvance", FT_Fixed),
+                ("advance", FT_Vector), ("format", ctypes.c_uint), ("bitmap", FT_Bitmap),
+                ("bitmap_left", ctypes.c_int), ("bitmap_top", ctypes.c_int)]
+
+
+class FT_Size_Metrics(ctypes.Structure):
+    _fields_ = [("x_ppem", ctypes.c_ushort), ("y_ppem", ctypes.c_ushort),
+                ("x_scale", FT_Fixed), ("y_scale", FT_Fixed), ("ascender", FT_Pos),
+                ("descender", FT_Pos), ("height", FT_Pos), ("max_advance", FT_Pos)]
+
+
+class FT_SizeRec(ctypes.Structure):
+    _fields_ = [("face", ctypes.c_void_p), ("generic", FT_Generic), ("metrics", FT_Size_Metrics)]
+
+
+class FT_FaceRec(ctypes.Structure):
+    _fields_ = [("num_faces", ctypes.c_long), ("face_index", ctypes.c_long),
+                ("face_flags", ctypes.c_long), ("style_flags", ctypes.c_long),
+                ("num_glyphs", ctypes.c_long), ("family_name", ctypes.c_char_p),
+                ("style_name", ctypes.c_char_p), ("num_fixed_sizes", ctypes.c_int),
+                ("available_sizes", ctypes.c_void_p), ("num_charmaps", ctypes.c_int),
+                ("charmaps", ctypes.c_void_p), ("generic", FT_Generic), ("bbox", FT_BBox),
+                ("units_per_EM", ctypes.c_ushort), ("ascender", ctypes.c_short),
+                ("descender", ctypes.c_short), ("height", ctypes.c_short),
+                ("max_advance_width", ctypes.c_short), ("max_advance_height", ctypes.c_short),
+                ("underline_position", ctypes.c_short), ("underline_thickness", ctypes.c_short),
+                ("glyph", ctypes.POINTER(FT_GlyphSlotRec)), ("size", ctypes.POINTER(FT_SizeRec))]
+
+
+FT_LOAD_RENDER = 1 << 2
+FT_LOAD_MONOCHROME = 1 << 12
+FT_LOAD_TARGET_MONO = 2 << 16
+FT_PIXEL_MODE_MONO = 1
+FT_KERNING_DEFAULT = 0
+
+
+def load_ttf(path, size, mono, codes):
+    libname = ctypes.util.find_library("freetype") or "libfreetype.so.6"
+    try:
+        ft = ctypes.CDLL(libname)
+    except OSError:
+        sys.exit("error: FreeType library not found, TTF fonts require libfreetype")
+
+    lib = ctypes.c_void_p()
+    face_p = ctypes.POINTER(FT_FaceRec)()
+    if ft.FT_Init_FreeType(ctypes.byref(lib)):
+        sys.exit("error: cannot initialize FreeType")
+    if ft.FT_New_Face(lib, path.encode(), ctypes.c_long(0), ctypes.byref(face_p)):
+        sys.exit("error: cannot open font %s" % path)
+    if ft.FT_Set_Pixel_Sizes(face_p, 0, size):
+        sys.exit("error: cannot set font size %d" % size)
+    face = face_p.contents
+
+    flags = FT_LOAD_RENDER
+    if mono:
+        flags |= FT_LOAD_MONOCHROME | FT_LOAD_TARGET_MONO
+
+    glyphs = {}
+    for code in codes:
+        if not ft.FT_Get_Char_Index(face_p, ctypes.c_ulong(code)):
+            continue
+        if ft.FT_Load_Char(face_p, ctypes.c_ulong(code), ctypes.c_int32(flags)):
+            continue
+        slot = face.glyph.contents
+        bm = slot.bitmap
+        pixels = []
+        for y in range(bm.rows):
+            row = []
+            for x in range(bm.width):
+                if bm.pixel_mode == FT_PIXEL_MODE_MONO:
+                    v = 255 if (bm.buffer[y * bm.pitch + x // 8] >> (7 - x % 8)) & 1 else 0
+                else:
+                    v = bm.buffer[y * bm.pitch + x]
+                row.append(v)
+            pixels.append(row)
+        glyphs[code] = Glyph(code, bm.width, bm.rows, slot.bitmap_left, slot.bitmap_top,
+                             (slot.advance.x + 32) >> 6, pixels)
+
+    def kerning(left, right):
+        vec = FT_Vector()
+        li = ft.FT_Get_Char_Index(face_p, ctypes.c_ulong(left))
+        ri = ft.FT_Get_Char_Index(face_p, ctypes.c_ulong(right))
+        if ft.FT_Get_Kerning(face_p, li, ri, FT_KERNING_DEFAULT, ctypes.byref(vec)):
+            return 0
+        return int(round(vec.x / 64.0))
+
+    family = (face.family_name or b"Font").decode("latin-1")
+    if face.style_name and face.style_name not in (b"Regular", b"Book"):
+        family += " " + face.style_name.decode("latin-1")
+    metrics = face.size.contents.metrics
+    return Font(family, glyphs, (metrics.ascender + 63) >> 6, (-metrics.descender + 63) >> 6,
+                kerning if face.face_flags & (1 << 6) else None)
+
+
+#
+# Character selection
+#
+def parse_ranges(values):
+    codes = set()
+    for value in values:
+        for part in value.split(","):
+            a, _, b = part.partition("-")
+            a = int(a, 0)
+            b = int(b, 0) if b else a
+            codes.update(range(a, b + 1))
+    return codes
+
+
+def select_codes(args):
+    codes = parse_ranges(args.range) if args.range else set()
+    texts = list(args.text or [])
+    for name in args.text_file or []:
+        with open(name, "r", encoding="utf-8") as f:
+            texts.append(f.read())
+    for text in texts:
+        codes.update(ord(ch) for ch in text if ch not in "\r\n")
+    if not codes:
+        codes = set(range(0x20, 0x7F))      # Default ASCII printable characters
+    if texts:
+        codes.update((0x20, ord("?")))      # Space and fallback character
+    return sorted(c for c in codes if c <= 0xFFFF)
+
+
+#
+# Encoding
+#
+def quantize(pixels, bpp):
+    top = (1 << bpp) - 1
+    if bpp == 1:
+        return [[1 if v >= 128 else 0 for v in row] for row in pixels]
+    return [[(v * top + 127) // 255 for v in row] for row in pixels]
+
+
+def pack(values, bpp):
+    out, byte, bits = [], 0, 0
+    for v in values:
+        byte = (byte << bpp) | v
+        bits += bpp
+        if bits == 8:
+            out.append(byte)
+            byte, bits = 0, 0
+    if bits:
+        out.append(byte << (8 - bits))
+    return out
+
+
+def encode_raw(rows, bpp):
+    out = []
+    for row in rows:
+        out.extend(pack(row, bpp))          # Each line starts on byte boundary
+    return out
+
+
+def encode_rle(rows, bpp):
+    px = [v for row in rows for v in row]
+    top = (1 << bpp) - 1
+    min_repeat = 16 // bpp + 2              # Shorter runs are cheaper as literal values
+
+    def repeat_len(i):
+        if px[i] not in (0, top):
+            return 0
+        j = i
+        while j < len(px) and px[j] == px[i] and j - i < RLE_REPEAT_MAX:
+            j += 1
+        return j - i
+
+    out, i = [], 0
+    while i < len(px):
+        n = repeat_len(i)
+        if n >= min_repeat or (n and n == len(px) - i):
+            out.append(RLE_REPEAT | (RLE_SOLID if px[i] else 0) | (n - 1))
+            i += n
+            continue
+        j = i + 1
+        while j < len(px) and j - i < RLE_LITERAL_MAX and repeat_len(j) < min_repeat:
+            j += 1
+        out.append(j - i - 1)
+        out.extend(pack(px[i:j], bpp))
+        i = j
+    return out
+
+
+def format_data(data, bpp, rle, row_bytes):
+    if not data:
+        return ["    0x00,"]
+    if not rle and bpp <= 2:               # Use bit macros for readability, one line per glyph row
+        macros = ["".join("X" if (b >> (7 - k)) & 1 else "_" for k in range(8)) for b in data]
+        return ["    " + ", ".join(macros[i:i + row_bytes]) + "," for i in range(0, len(macros), row_bytes)]
+    return ["    " + ", ".join("0x%02X" % b for b in data[i:i + 12]) + "," for i in range(0, len(data), 12)]
+
+
+#
+# Output
+#
+def c_name(text):
+    return re.sub(r"[^0-9A-Za-z_]", "_", text)
+
+
+def compile_font(font, codes, args):
+    glyphs = [font.glyphs[c] for c in codes if c in font.glyphs]
+    missing = [c for c in codes if c not in font.glyphs]
+    if not glyphs:
+        sys.exit("error: none of selected characters exists in font")
+    for g in glyphs:
+        g.trim()
+
+    ascent = max([g.top for g in glyphs if g.height] + [font.ascent or 0])
+    descent = max([g.height - g.top for g in glyphs if g.height] + [font.descent or 0])
+    size = args.line_height or (ascent + descent)
+    name = args.name or c_name("%s_%d" % (font.family.replace(" ", "_"), args.size or size))
+    display = args.display_name or font.family
+    flags = [BPP_FLAGS[args.bpp]] if args.bpp > 1 else []
+    if args.rle:
+        flags.append("GUI_FLAG_FONT_RLE")
+
+    lines = ["#include \"gui/gui.h\"", ""]
+    table, total = [], 0
+    for g in glyphs:
+        values = quantize(g.pixels, args.bpp)
+        data = encode_rle(values, args.bpp) if args.rle else encode_raw(values, args.bpp)
+        total += len(data)
+        lines.append("gui_const uint8_t Font_%s_%04x[%d] = {" % (name, g.code, max(1, len(data))))
+        lines.extend(format_data(data, args.bpp, args.rle, (g.width * args.bpp + 7) // 8))
+        lines.extend(["};", ""])
+
+        x_pos = max(0, g.left)
+        x_margin = max(0, g.advance - x_pos - g.width)
+        y_pos = ascent - g.top if g.height else 0
+        table.append("{%4d, %4d, %2d, %4d, %4d, Font_%s_%04x}," % (
+            g.width, g.height, min(x_pos, 255), y_pos, min(x_margin, 255), name, g.code))
+
+    lines.append("gui_const gui_font_char_t %s_CharTable[] = {" % name)
+    lines.extend(table)
+    lines.extend(["};", ""])
+
+    first, last = glyphs[0].code, glyphs[-1].code
+    sparse = last - first + 1 != len(glyphs)
+    if sparse:
+        lines.append("gui_const uint16_t %s_Codes[] = {" % name)
+        gc = [g.code for g in glyphs]
+        lines.extend("    " + ", ".join("0x%04X" % c for c in gc[i:i + 8]) + "," for i in range(0, len(gc), 8))
+        lines.extend(["};", ""])
+
+    pairs = []
+    if args.kerning and font.kerning is not None:
+        kcodes = [g.code for g in glyphs if not chr(g.code).isspace()]
+        for left in kcodes:
+            for right in kcodes:
+                k = font.kerning(left, right)
+                if k:
+                    pairs.append((left, right, max(-128, min(127, k))))
+        if pairs:
+            lines.append("gui_const gui_font_kern_t %s_Kerning[] = {" % name)
+            lines.extend("    {0x%04X, 0x%04X, %3d}," % p for p in pairs)
+            lines.extend(["};", ""])
+    elif args.kerning:
+        print("warning: font has no kerning table", file=sys.stderr)
+
+    lines.extend([
+        "gui_const gui_font_t GUI_Font_%s = {" % name,
+        "    _GT(\"%s\")," % display.replace("\"", "\\\""),
+        "    %d," % size,
+        "    0x%02x," % first,
+        "    0x%02x," % last,
+        "    %s," % (" | ".join(flags) if flags else "0"),
+        "    %s_CharTable," % name,
+        "    %s," % ("%s_Codes" % name if sparse else "NULL"),
+        "    %d," % (len(glyphs) if sparse else 0),
+        "    %s," % ("%s_Kerning" % name if pairs else "NULL"),
+        "    %d" % len(pairs),
+        "};",
+        "",
+    ])
+
+    print("%s: %d characters, %d bytes of character data, %d kerning pairs%s" % (
+        "GUI_Font_" + name, len(glyphs), total, len(pairs),
+        (", %d characters not in font" % len(missing)) if missing else ""), file=sys.stderr)
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert BDF or TTF/OTF font to EasyGUI font C source")
+    parser.add_argument("font", help="Input font file (.bdf, .ttf, .otf)")
+    parser.add_argument("-o", "--output", help="Output C file, standard output when not set")
+    parser.add_argument("-s", "--size", type=int, help="Font size in pixels, required for TTF/OTF fonts")
+    parser.add_argument("-b", "--bpp", type=int, choices=sorted(BPP_FLAGS), default=1, help="Bits per pixel")
+    parser.add_argument("-r", "--range", action="append", help="Character range, such as 0x20-0x7E. Can be repeated")
+    parser.add_argument("-t", "--text", action="append", help="Include characters used in text. Can be repeated")
+    parser.add_argument("-f", "--text-file", action="append", help="Include characters used in UTF-8 text file. Can be repeated")
+    parser.add_argument("--rle", action="store_true", help="Run-length encode character data")
+    parser.add_argument("--kerning", action="store_true", help="Generate kerning pairs table")
+    parser.add_argument("--name", help="C identifier suffix, used as GUI_Font_<name>")
+    parser.add_argument("--display-name", help="Font name stored in font structure")
+    parser.add_argument("--line-height", type=int, help="Font size field, ascent plus descent when not set")
+    args = parser.parse_args()
+
+    codes = select_codes(args)
+    if args.font.lower().endswith(".bdf"):
+        font = load_bdf(args.font)
+    else:
+        if not args.size:
+            parser.error("--size is required for TTF/OTF fonts")
+        font = load_ttf(args.font, args.size, args.bpp == 1, codes)
+
+    out = compile_font(font, codes, args)
+    if args.output:
+        with open(args.output, "w", newline="\n") as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,48 @@
+/**
+ * \file            gui_config.h
+ * \brief           Configuration for golden image tool
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+#ifndef __GUI_CONFIG_H
+#define __GUI_CONFIG_H
+
+/*
+ * Golden image tool runs on host with headless driver,
+ * drawing functions are called directly from main thread
+ */
+#define GUI_CFG_OS                              0
+#define GUI_CFG_USE_ALPHA                       1
+#define GUI_CFG_USE_KEYBOARD                    1
+#define GUI_CFG_SYS_PORT                        GUI_SYS_PORT_POSIX
+
+/* After user configuration, call default config to merge config together */
+#include "gui/gui_config_default.h"
+
+#endif /* __GUI_CONFIG_H */
@@ -0,0 +1,1625 @@
+/**
+ * \file            gui_golden.c
+ * \brief           Pixel-exact golden image comparison of drawing functions and widgets
+ */
+
+/*
+ * Copyright (c) 2017 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of EasyGUI library.
+ *
+ * Author:          Tilen Majerle <tilen@majerle.eu>
+ */
+
+/*
+ * Tool renders every public gui_draw_* primitive and every widget on headless frame buffer
+ * and compares result pixel by pixel with golden images, saved as binary PPM files.
+ *
+ * Primitives are drawn in multiple sizes, including 1 pixel wide shapes and shapes crossing
+ * screen edges. Each primitive is drawn twice, once with full screen clipping region
+ * and once with clipping region smaller than screen ("_clip" suffix).
+ *
+ * For each failed case, actual image and diff image are written to output directory.
+ * In diff image, different pixels are red and equal pixels are dimmed golden pixels.
+ *
+ * Golden images for ARGB8888 and RGB565 frame buffers are stored in "golden/32" and "golden/16".
+ * Makefile in this directory builds the tool and compares all configurations,
+ * including portable C kernels and tile renderer:
+ *
+ *  make check                      Compare, fails if any case differs
+ *  make update                     Write golden images after intended change of drawing output
+ *
+ * Golden images can also be generated on known good revision with -u,
+ * then tool is run against the same golden directory after every change in drawing code:
+ *
+ *  gui_golden -u -g golden         Write golden images
+ *  gui_golden -g golden -o out     Compare, exit code is 1 if any case differs
+ *
+ * Build from repository root, together with all sources from "src/gui" and "src/widget":
+ *
+ *  gcc -O2 -Itools/golden -Isrc/include tools/golden/gui_golden.c $GUI_SOURCES \
+ *      src/fonts/Arial_Bold_AA.c src/fonts/Calibri_Bold.c \
+ *      src/system/gui_ll_headless.c src/system/gui_ll_soft.c src/system/gui_sys_posix.c -lm -o gui_golden
+ *
+ * Usage:
+ *
+ *  gui_golden [-u] [-g DIR] [-o DIR] [-f FILTER] [-p PIXEL_SIZE]
+ *
+ *  -u: Write golden images instead of comparing
+ *  -g: Golden images directory, default "golden"
+ *  -o: Output directory for actual and diff images of failed cases, default "."
+ *  -f: Run only cases with name containing FILTER
+ *  -p: Bytes per pixel, 2 for RGB565 or 4 for ARGB8888 (default),
+ *      use separate golden directory for each pixel size
+ *
+ * Add -DGUI_CFG_LL_SOFT_USE_SIMD=0 to verify portable C kernels against the same golden images.
+ * Add -DGUI_CFG_USE_RENDER_TILES=1 to verify tile renderer against the same golden images,
+ * widgets are then drawn with clipping region of each tile.
+ */
+#include "gui/gui.h"
+#include "gui/gui_draw.h"
+#include "widget/gui_widgets.h"
+#include "system/gui_ll_headless.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GOLDEN_WIDTH                    200
+#define GOLDEN_HEIGHT                   150
+#define GOLDEN_BG                       0xFFE0E0E0  /* Background for primitives */
+#define GOLDEN_IMG_SIZE                 64          /* Maximal size of test image */
+
+extern gui_const gui_font_t GUI_Font_Arial_Bold_18;
+extern gui_const gui_font_t GUI_Font_Calibri_Bold_8;
+
+static gui_font_t font_kerning;                 /* Arial with kerning pairs */
+
+/**
+ * \brief           Function to draw single shape at position
+ */
+typedef void (*golden_shape_fn)(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size);
+
+/**
+ * \brief           Golden image case
+ */
+typedef struct {
+    const char* name;                           /*!< Case name and golden file name */
+    golden_shape_fn shape_fn;                   /*!< Shape drawn in multiple sizes and positions */
+    void (*scene_fn)(const gui_display_t* disp);/*!< Custom scene, used when shape is `NULL` */
+    gui_handle_p (*widget_fn)(gui_handle_p parent); /*!< Widget creation, used when shape and scene are `NULL` */
+} golden_case_t;
+
+static uint8_t* img_data[3];                    /* Image data for 16, 24 and 32 bits per pixel */
+static gui_color_t img_palette[256];            /* Palette for indexed images, entry `0` is transparent */
+static uint8_t pixel_size = 4;
+static const gui_char text[] = "EasyGUI 0123 Ag";
+static const gui_char text_kerning[] = "AVATAR To Wo Ty.";
+
+/* Kerning pairs, sorted by left and right character */
+static const gui_font_kern_t kerning[] = {
+    {'A', 'T', -2}, {'A', 'V', -2}, {'T', 'A', -2}, {'T', 'o', -3},
+    {'V', 'A', -2}, {'W', 'o', -2}, {'y', '.', -1},
+};
+
+/**
+ * \brief           Font created from built-in font in other data format
+ */
+typedef struct {
+    gui_font_t font;                            /*!< Created font */
+    const gui_font_t* src;                      /*!< Built-in font with the same characters */
+    uint8_t flags;                              /*!< Format flags of created font */
+    void* mem;                                  /*!< Allocated characters and data */
+} golden_font_t;
+
+static golden_font_t fonts[] = {
+    {{0}, &GUI_Font_Calibri_Bold_8, GUI_FLAG_FONT_RLE, NULL},
+    {{0}, &GUI_Font_Arial_Bold_18,  GUI_FLAG_FONT_AA | GUI_FLAG_FONT_RLE, NULL},
+    {{0}, &GUI_Font_Arial_Bold_18,  GUI_FLAG_FONT_AA4, NULL},
+    {{0}, &GUI_Font_Arial_Bold_18,  GUI_FLAG_FONT_AA8 | GUI_FLAG_FONT_RLE, NULL},
+};
+
+/*******************************************/
+/*               Primitives                */
+/*******************************************/
+
+static void
+shape_setpixel(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_setpixel(disp, x, y, GUI_COLOR_RED);
+    gui_draw_setpixel(disp, x + size - 1, y + size - 1, GUI_COLOR_BLUE);
+}
+
+static void
+shape_hline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_hline(disp, x, y, size, GUI_COLOR_GREEN);
+}
+
+static void
+shape_vline(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_vline(disp, x, y, size, GUI_COLOR_GREEN);
+}
+
+static void
+shape_line(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_line(disp, x, y, x + size - 1, y + size - 1, GUI_COLOR_GREEN);
+    gui_draw_line(disp, x + size - 1, y, x + size / 3, y + size - 1, GUI_COLOR_BLUE);
+    gui_draw_line(disp, x, y + size / 2, x + size - 1, y + size / 2, GUI_COLOR_RED);
+}
+
+static void
+shape_line_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_line_aa(disp, x, y, x + size - 1, y + size / 3, GUI_COLOR_GREEN);
+    gui_draw_line_aa(disp, x + size - 1, y, x + size / 3, y + size - 1, GUI_COLOR_BLUE);
+    gui_draw_line_aa(disp, x, y + size - 1, x + size / 5, y, GUI_COLOR_RED);
+}
+
+static void
+shape_rectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_rectangle(disp, x, y, size, size, GUI_COLOR_BLUE);
+}
+
+static void
+shape_filledrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledrectangle(disp, x, y, size, size, GUI_COLOR_BLUE);
+}
+
+static void
+shape_filledrectangle_alpha(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledrectangle(disp, x, y, size, size, GUI_COLOR_ALPHA(GUI_COLOR_RED, GUI_COLOR_ALPHA_50));
+    gui_draw_filledrectangle(disp, x + size / 3, y + size / 3, size - size / 3, size - size / 3, GUI_COLOR_ALPHA(GUI_COLOR_BLUE, GUI_COLOR_ALPHA_25));
+}
+
+static void
+shape_rectangle_ex(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_rect_ex_t r = {0};
+
+    r.x = x;
+    r.y = y;
+    r.width = size;
+    r.height = size;
+    r.flags = GUI_FLAG_DRAW_FILLED;
+    r.color = GUI_COLOR_GREEN;
+    r.radius = size / 5;
+    gui_draw_rectangle_ex(disp, &r);
+}
+
+static void
+shape_rectangle3d(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_rectangle3d(disp, x, y, size, size / 2 + 1, GUI_DRAW_3D_State_Raised);
+    gui_draw_rectangle3d(disp, x, y + size / 2 + 1, size, size - size / 2 - 1, GUI_DRAW_3D_State_Lowered);
+}
+
+static void
+shape_roundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_roundedrectangle(disp, x, y, size, size, size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+shape_filledroundedrectangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledroundedrectangle(disp, x, y, size, size, size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+shape_circle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_circle(disp, x + size / 2, y + size / 2, size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+shape_filledcircle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledcircle(disp, x + size / 2, y + size / 2, size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+shape_roundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_roundedrectangle_aa(disp, x, y, size, size, size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+shape_filledroundedrectangle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledroundedrectangle_aa(disp, x, y, size, size, size / 4, GUI_COLOR_ORANGE);
+}
+
+static void
+shape_circle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_circle_aa(disp, x + size / 2, y + size / 2, size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+shape_filledcircle_aa(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledcircle_aa(disp, x + size / 2, y + size / 2, size / 2, GUI_COLOR_MAGENTA);
+}
+
+static void
+shape_circlecorner(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_circlecorner(disp, x + size / 2, y + size / 2, size / 2, GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_BR, GUI_COLOR_MAGENTA);
+    gui_draw_circlecorner(disp, x + size / 2, y + size / 2, size / 3, GUI_DRAW_CIRCLE_TR | GUI_DRAW_CIRCLE_BL, GUI_COLOR_BLUE);
+}
+
+static void
+shape_filledcirclecorner(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledcirclecorner(disp, x + size / 2, y + size / 2, size / 2, GUI_DRAW_CIRCLE_TL | GUI_DRAW_CIRCLE_BR, GUI_COLOR_MAGENTA);
+    gui_draw_filledcirclecorner(disp, x + size / 2, y + size / 2, size / 3, GUI_DRAW_CIRCLE_TR | GUI_DRAW_CIRCLE_BL, GUI_COLOR_BLUE);
+}
+
+static void
+shape_arc(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_arc(disp, x + size / 2, y + size / 2, size / 2, 1, 200, 340, GUI_COLOR_MAGENTA);
+    gui_draw_arc(disp, x + size / 2, y + size / 2, size / 2, size / 6 + 1, 300, 45, GUI_COLOR_BLUE);
+    gui_draw_arc(disp, x + size / 2, y + size / 2, size / 3, 2, 90, 180, GUI_COLOR_RED);
+}
+
+static void
+shape_pie(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_pie(disp, x + size / 2, y + size / 2, size / 2, 0, 100, GUI_COLOR_MAGENTA);
+    gui_draw_pie(disp, x + size / 2, y + size / 2, size / 2, 100, 190, GUI_COLOR_BLUE);
+    gui_draw_pie(disp, x + size / 2, y + size / 2, size / 2, 190, 360, GUI_COLOR_ORANGE);
+}
+
+static void
+shape_ring(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_ring(disp, x + size / 2, y + size / 2, size / 2, size / 5 + 1, GUI_COLOR_MAGENTA);
+}
+
+static void
+shape_triangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_triangle(disp, x, y + size - 1, x + size / 2, y, x + size - 1, y + size - 1, GUI_COLOR_CYAN);
+}
+
+static void
+shape_filledtriangle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_filledtriangle(disp, x, y + size - 1, x + size / 2, y, x + size - 1, y + size - 1, GUI_COLOR_CYAN);
+    gui_draw_filledtriangle(disp, x, y, x + size - 1, y + size / 3, x + size / 4, y + size - 1, GUI_COLOR_ALPHA(GUI_COLOR_BLUE, GUI_COLOR_ALPHA_50));
+}
+
+static void
+shape_poly(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_poly_t p[5];
+
+    p[0].x = x;                 p[0].y = y + size / 2;
+    p[1].x = x + size / 2;      p[1].y = y;
+    p[2].x = x + size - 1;      p[2].y = y + size / 2;
+    p[3].x = x + size / 2;      p[3].y = y + size - 1;
+    p[4] = p[0];
+    gui_draw_poly(disp, p, GUI_COUNT_OF(p), GUI_COLOR_BLACK);
+}
+
+static void
+shape_filledpoly(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_poly_t p[10];
+    gui_dim_t i, s = size - 1;
+
+    /* Comb with more points than fit on stack */
+    for (i = 0; i < 10; i += 2) {
+        p[i].x = x + i * s / 9;
+        p[i].y = y + (i & 2 ? s / 2 : 0);
+        p[i + 1].x = x + (i + 1) * s / 9;
+        p[i + 1].y = y + s;
+    }
+    gui_draw_filledpoly(disp, p, 10, GUI_COLOR_BLUE);
+
+    /* Concave arrow with horizontal edges */
+    p[0].x = x;                 p[0].y = y + s / 3;
+    p[1].x = x + s / 2;         p[1].y = y + s / 3;
+    p[2].x = x + s / 2;         p[2].y = y;
+    p[3].x = x + s;             p[3].y = y + s / 2;
+    p[4].x = x + s / 2;         p[4].y = y + s;
+    p[5].x = x + s / 2;         p[5].y = y + s - s / 3;
+    p[6].x = x;                 p[6].y = y + s - s / 3;
+    gui_draw_filledpoly(disp, p, 7, GUI_COLOR_DARKGREEN);
+
+    /* Self-intersecting star, center is outside with even-odd rule */
+    p[0].x = x + s / 2;         p[0].y = y;
+    p[1].x = x + s / 5;         p[1].y = y + s;
+    p[2].x = x + s;             p[2].y = y + s / 3;
+    p[3].x = x;                 p[3].y = y + s / 3;
+    p[4].x = x + s - s / 5;     p[4].y = y + s;
+    gui_draw_filledpoly(disp, p, 5, GUI_COLOR_RED);
+}
+
+static void
+shape_scrollbar(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_draw_sb_t sb;
+
+    gui_draw_scrollbar_init(&sb);
+    sb.x = x;
+    sb.y = y;
+    sb.width = size / 3 + 1;
+    sb.height = size;
+    sb.dir = GUI_DRAW_SB_DIR_VERTICAL;
+    sb.entriestotal = 100;
+    sb.entriesvisible = 10;
+    sb.entriestop = 30;
+    gui_draw_scrollbar(disp, &sb);
+}
+
+static void
+shape_image(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size, uint8_t bpp) {
+    gui_image_desc_t img;
+
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = size;
+    img.y_size = size;
+    img.bpp = bpp;
+    img.image = img_data[bpp / 8 - 2];
+    gui_draw_image((gui_display_t *)disp, x, y, &img);
+}
+
+static void
+shape_image16(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    shape_image(disp, x, y, size, 16);
+}
+
+static void
+shape_image24(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    shape_image(disp, x, y, size, 24);
+}
+
+static void
+shape_image32(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    shape_image(disp, x, y, size, 32);
+}
+
+/**
+ * \brief           Get pixel of test pattern for encoded images
+ * \note            Solid cells give long runs, other cells are 32-bit test image with alpha gradient
+ * \return          ARGB8888 color
+ */
+static gui_color_t
+image_pattern(size_t x, size_t y) {
+    static const gui_color_t cell_colors[] = {0xFFFF0000, 0x800000FF, 0xFF00C000, 0xFFFFFFFF};
+    const uint8_t* p;
+
+    if (((x / 8) + (y / 8)) & 0x01) {
+        return cell_colors[(x / 8 + y / 16) % GUI_COUNT_OF(cell_colors)];
+    }
+    p = &img_data[2][4 * (y * GOLDEN_IMG_SIZE + x)];
+    return ((gui_color_t)(0xFF - p[3]) << 24) | ((gui_color_t)p[0] << 16) | ((gui_color_t)p[1] << 8) | p[2];
+}
+
+static uint8_t*
+put_color32(uint8_t* out, gui_color_t c) {
+    out[0] = (uint8_t)c;
+    out[1] = (uint8_t)(c >> 8);
+    out[2] = (uint8_t)(c >> 16);
+    out[3] = (uint8_t)(c >> 24);
+    return out + 4;
+}
+
+/**
+ * \brief           Encode pixels with \ref GUI_IMAGE_FORMAT_RLE format
+ * \return          Pointer to end of encoded data
+ */
+static uint8_t*
+encode_rle(uint8_t* out, const gui_color_t* px, size_t count) {
+    size_t i = 0, n;
+
+    while (i < count) {
+        for (n = 1; i + n < count && n < GUI_IMAGE_RLE_RUN_MAX && px[i + n] == px[i]; n++) {}
+        if (n > 1) {
+            *out++ = (uint8_t)(GUI_IMAGE_RLE_REPEAT | (n - 1));
+            out = put_color32(out, px[i]);
+        } else {
+            /* Literal run ends where next repeated pixels start */
+            for (n = 1; i + n < count && n < GUI_IMAGE_RLE_RUN_MAX
+                && (i + n + 1 >= count || px[i + n] != px[i + n + 1]); n++) {}
+            *out++ = (uint8_t)(n - 1);
+            for (; n > 0; n--) {
+                out = put_color32(out, px[i++]);
+            }
+            continue;
+        }
+        i += n;
+    }
+    return out;
+}
+
+/**
+ * \brief           Encode pixels with \ref GUI_IMAGE_FORMAT_QOI format
+ * \return          Pointer to end of encoded data
+ */
+static uint8_t*
+encode_qoi(uint8_t* out, const gui_color_t* px, gui_dim_t width, gui_dim_t height) {
+    gui_color_t index[64] = {0}, prev = 0xFF000000UL, c;
+    size_t i, count = (size_t)width * height, run = 0, h;
+    int vr, vg, vb;
+
+    memcpy(out, "qoif", 4);
+    out[4] = out[5] = out[8] = out[9] = 0;
+    out[6] = (uint8_t)(width >> 8);
+    out[7] = (uint8_t)width;
+    out[10] = (uint8_t)(height >> 8);
+    out[11] = (uint8_t)height;
+    out[12] = 4;                                /* RGBA channels */
+    out[13] = 0;                                /* sRGB with linear alpha */
+    out += 14;
+    for (i = 0; i < count; i++) {
+        c = px[i];
+        if (c == prev) {
+            if (++run == 62 || i + 1 == count) {
+                *out++ = (uint8_t)(0xC0 | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            *out++ = (uint8_t)(0xC0 | (run - 1));
+            run = 0;
+        }
+        h = (((c >> 16) & 0xFF) * 3 + ((c >> 8) & 0xFF) * 5 + (c & 0xFF) * 7 + (c >> 24) * 11) & 0x3F;
+        if (index[h] == c) {
+            *out++ = (uint8_t)h;
+        } else if ((c >> 24) != (prev >> 24)) {
+            index[h] = c;
+            *out++ = 0xFF;
+            *out++ = (uint8_t)(c >> 16);
+            *out++ = (uint8_t)(c >> 8);
+            *out++ = (uint8_t)c;
+            *out++ = (uint8_t)(c >> 24);
+        } else {
+            index[h] = c;
+            vr = (signed char)(((c >> 16) & 0xFF) - ((prev >> 16) & 0xFF));
+            vg = (signed char)(((c >> 8) & 0xFF) - ((prev >> 8) & 0xFF));
+            vb = (signed char)((c & 0xFF) - (prev & 0xFF));
+            if (vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1) {
+                *out++ = (uint8_t)(0x40 | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2));
+            } else if (vg >= -32 && vg <= 31 && vr - vg >= -8 && vr - vg <= 7 && vb - vg >= -8 && vb - vg <= 7) {
+                *out++ = (uint8_t)(0x80 | (vg + 32));
+                *out++ = (uint8_t)(((vr - vg + 8) << 4) | (vb - vg + 8));
+            } else {
+                *out++ = 0xFE;
+                *out++ = (uint8_t)(c >> 16);
+                *out++ = (uint8_t)(c >> 8);
+                *out++ = (uint8_t)c;
+            }
+        }
+        prev = c;
+    }
+    memcpy(out, "\0\0\0\0\0\0\0\1", 8);           /* End marker */
+    return out + 8;
+}
+
+/**
+ * \brief           Encode test pattern of given size and draw it
+ */
+static void
+shape_image_encoded(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size, gui_image_format_t format) {
+    gui_image_desc_t img;
+    gui_color_t* px;
+    uint8_t* data;
+    size_t i, count = (size_t)size * size;
+
+    px = malloc(count * sizeof(*px));
+    data = malloc(5 * count + 32);              /* Worst case for both formats */
+    if (px != NULL && data != NULL) {
+        for (i = 0; i < count; i++) {
+            px[i] = image_pattern(i % size, i / size);
+        }
+        if (format == GUI_IMAGE_FORMAT_RLE) {
+            encode_rle(data, px, count);
+        } else {
+            encode_qoi(data, px, size, size);
+        }
+        memset(&img, 0x00, sizeof(img));
+        img.x_size = size;
+        img.y_size = size;
+        img.bpp = 32;
+        img.format = format;
+        img.image = data;
+        gui_draw_image((gui_display_t *)disp, x, y, &img);
+    }
+    free(px);
+    free(data);
+}
+
+static void
+shape_image_rle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    shape_image_encoded(disp, x, y, size, GUI_IMAGE_FORMAT_RLE);
+}
+
+static void
+shape_image_qoi(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    shape_image_encoded(disp, x, y, size, GUI_IMAGE_FORMAT_QOI);
+}
+
+/**
+ * \brief           Draw raw 32-bit test pattern with premultiplied colors and transparent columns
+ */
+static void
+shape_image_premultiplied(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+    gui_color_t c;
+    uint8_t* data;
+    uint32_t a;
+    size_t i, count = (size_t)size * size;
+
+    if ((data = malloc(4 * count)) == NULL) {
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        c = (i % size) % 16 < 12 ? image_pattern(i % size, i / size) : 0;
+        a = c >> 24;
+        data[4 * i + 0] = (uint8_t)((((c >> 16) & 0xFF) * a + 127) / 255);
+        data[4 * i + 1] = (uint8_t)((((c >> 8) & 0xFF) * a + 127) / 255);
+        data[4 * i + 2] = (uint8_t)(((c & 0xFF) * a + 127) / 255);
+        data[4 * i + 3] = (uint8_t)(0xFF - a);
+    }
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = size;
+    img.y_size = size;
+    img.bpp = 32;
+    img.image = data;
+    img.flags = GUI_IMAGE_FLAG_PREMULTIPLIED;
+    gui_draw_image((gui_display_t *)disp, x, y, &img);
+    free(data);
+}
+
+/**
+ * \brief           Set descriptor of raw 32-bit test image
+ */
+static void
+image_raw32(gui_image_desc_t* img, gui_dim_t x_size, gui_dim_t y_size) {
+    memset(img, 0x00, sizeof(*img));
+    img->x_size = x_size;
+    img->y_size = y_size;
+    img->bpp = 32;
+    img->image = img_data[2];
+}
+
+static void
+shape_image_scaled(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+
+    image_raw32(&img, 16, 16);
+    gui_draw_image_scaled((gui_display_t *)disp, x, y, size, size * 2 / 3 + 1, &img, GUI_IMAGE_FILTER_NEAREST);
+}
+
+static void
+shape_image_scaled_bilinear(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+
+    image_raw32(&img, 16, 16);
+    gui_draw_image_scaled((gui_display_t *)disp, x, y, size, size * 2 / 3 + 1, &img, GUI_IMAGE_FILTER_BILINEAR);
+}
+
+/**
+ * \brief           Draw image rotated by 90, 180 or 270 degrees, depending on size
+ */
+static void
+shape_image_rotated(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+
+    image_raw32(&img, size, size / 2 + 1);
+    gui_draw_image_rotated((gui_display_t *)disp, x, y, &img, (gui_image_rotate_t)(GUI_IMAGE_ROTATE_90 + size % 3));
+}
+
+static void
+shape_image_part(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+
+    image_raw32(&img, GOLDEN_IMG_SIZE, GOLDEN_IMG_SIZE);
+    gui_draw_image_part((gui_display_t *)disp, x, y, &img, 10, 5, size, size);
+}
+
+/**
+ * \brief           Draw part of QOI image, rotated and scaled with bilinear filter
+ */
+static void
+shape_image_blit_qoi(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+    gui_image_blit_t b;
+    gui_color_t px[24 * 24];
+    uint8_t data[5 * 24 * 24 + 32];
+    size_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(px); i++) {
+        px[i] = image_pattern(i % 24, i / 24);
+    }
+    encode_qoi(data, px, 24, 24);
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = 24;
+    img.y_size = 24;
+    img.bpp = 32;
+    img.format = GUI_IMAGE_FORMAT_QOI;
+    img.image = data;
+
+    gui_draw_image_blit_init(&b);
+    b.src_x = 4;
+    b.src_y = 2;
+    b.src_width = 16;
+    b.src_height = 20;
+    b.width = size;
+    b.height = size;
+    b.rotate = GUI_IMAGE_ROTATE_90;
+    b.filter = GUI_IMAGE_FILTER_BILINEAR;
+    gui_draw_image_blit((gui_display_t *)disp, x, y, &img, &b);
+}
+
+/**
+ * \brief           Draw rotated part of RLE image, which ends with last pixel of image
+ * \note            Encoded data is copied to memory of exact size to detect reads after image end
+ */
+static void
+shape_image_blit_rle(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+    gui_image_blit_t b;
+    gui_color_t px[24 * 24];
+    uint8_t tmp[5 * 24 * 24], *data;
+    size_t i, len;
+
+    for (i = 0; i < GUI_COUNT_OF(px); i++) {
+        px[i] = image_pattern(i % 24, i / 24);
+    }
+    len = (size_t)(encode_rle(tmp, px, GUI_COUNT_OF(px)) - tmp);
+    if ((data = malloc(len)) == NULL) {
+        return;
+    }
+    memcpy(data, tmp, len);
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = 24;
+    img.y_size = 24;
+    img.bpp = 32;
+    img.format = GUI_IMAGE_FORMAT_RLE;
+    img.image = data;
+
+    gui_draw_image_blit_init(&b);
+    b.src_x = 5;
+    b.src_y = 0;
+    b.src_width = 19;
+    b.src_height = 24;
+    b.width = size;
+    b.height = size;
+    b.rotate = GUI_IMAGE_ROTATE_90;
+    gui_draw_image_blit((gui_display_t *)disp, x, y, &img, &b);
+    free(data);
+}
+
+/**
+ * \brief           Draw RLE image with trimmed transparent border, scaled and rotated depending on size
+ * \note            Image data is 14x17 part of 24x24 original image
+ */
+static void
+shape_image_trimmed(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    gui_image_desc_t img;
+    gui_image_blit_t b;
+    gui_color_t px[14 * 17];
+    uint8_t tmp[5 * 14 * 17], *data;
+    size_t i, len;
+
+    for (i = 0; i < GUI_COUNT_OF(px); i++) {
+        px[i] = image_pattern(5 + i % 14, 3 + i / 14);
+    }
+    len = (size_t)(encode_rle(tmp, px, GUI_COUNT_OF(px)) - tmp);
+    if ((data = malloc(len)) == NULL) {
+        return;
+    }
+    memcpy(data, tmp, len);
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = 14;
+    img.y_size = 17;
+    img.bpp = 32;
+    img.format = GUI_IMAGE_FORMAT_RLE;
+    img.image = data;
+    img.x_offset = 5;
+    img.y_offset = 3;
+    img.width = 24;
+    img.height = 24;
+
+    gui_draw_image_blit_init(&b);
+    b.width = size;
+    b.height = size * 2 / 3 + 1;
+    b.rotate = (gui_image_rotate_t)(size % 4);
+    b.filter = size & 0x01 ? GUI_IMAGE_FILTER_BILINEAR : GUI_IMAGE_FILTER_NEAREST;
+    gui_draw_image_blit((gui_display_t *)disp, x, y, &img, &b);
+    free(data);
+}
+
+/**
+ * \brief           Draw indexed image, bits per pixel depend on size
+ */
+static void
+shape_image_indexed(const gui_display_t* disp, gui_dim_t x, gui_dim_t y, gui_dim_t size) {
+    static const uint8_t bpps[] = {1, 2, 4, 8};
+    gui_image_desc_t img;
+    uint8_t* data;
+    uint8_t bpp = bpps[size % 4];
+    size_t i, j, stride = ((size_t)size * bpp + 7) / 8;
+
+    if ((data = calloc(stride * size, 1)) == NULL) {
+        return;
+    }
+    for (i = 0; i < (size_t)size; i++) {
+        for (j = 0; j < (size_t)size; j++) {
+            uint8_t idx = (uint8_t)((j / 4 + i / 4 * 3) & ((1U << bpp) - 1));
+
+            data[i * stride + j * bpp / 8] |= (uint8_t)(idx << (8 - bpp - (j * bpp) % 8));
+        }
+    }
+    memset(&img, 0x00, sizeof(img));
+    img.x_size = size;
+    img.y_size = size;
+    img.bpp = bpp;
+    img.format = GUI_IMAGE_FORMAT_INDEXED;
+    img.palette = img_palette;
+    img.image = data;
+    gui_draw_image((gui_display_t *)disp, x, y, &img);
+    free(data);
+}
+
+/**
+ * \brief           Draw text in box with selected alignment
+ */
+static void
+draw_text(const gui_display_t* disp, const gui_font_t* font, const gui_char* str, gui_dim_t x, gui_dim_t y,
+            gui_dim_t width, gui_dim_t height, uint8_t align, uint8_t flags) {
+    gui_draw_text_t f;
+
+    gui_draw_text_init(&f);
+    f.x = x;
+    f.y = y;
+    f.width = width;
+    f.height = height;
+    f.align = align;
+    f.flags = flags;
+    f.color1width = width / 2;
+    f.color1 = GUI_COLOR_BLACK;
+    f.color2 = GUI_COLOR_BLUE;
+    gui_draw_rectangle(disp, x - 1, y - 1, width + 2, height + 2, GUI_COLOR_GRAY);
+    gui_draw_writetext(disp, font, str, &f);
+}
+
+/**
+ * \brief           Draw text scene with font in different alignments and positions
+ */
+static void
+scene_text(const gui_display_t* disp, const gui_font_t* font, const gui_char* str) {
+    gui_dim_t h = font->size + 2;
+
+    draw_text(disp, font, str, 5, 5, 150, h, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, 0);
+    draw_text(disp, font, str, 5, 10 + h, 150, h, GUI_HALIGN_CENTER | GUI_VALIGN_CENTER, 0);
+    draw_text(disp, font, str, 5, 15 + 2 * h, 150, h, GUI_HALIGN_RIGHT | GUI_VALIGN_BOTTOM, 0);
+    draw_text(disp, font, str, 5, 20 + 3 * h, 60, 3 * h, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, GUI_FLAG_TEXT_MULTILINE);
+    draw_text(disp, font, str, 70, 20 + 3 * h, 40, h, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, 0);    /* Cut by box */
+    draw_text(disp, font, str, -20, GOLDEN_HEIGHT - h / 2, 120, h, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, 0); /* Cut by screen */
+    draw_text(disp, font, str, GOLDEN_WIDTH - 60, 20 + 3 * h, 120, h, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, 0);
+}
+
+static void
+scene_text_aa(const gui_display_t* disp) {
+    scene_text(disp, &GUI_Font_Arial_Bold_18, text);
+}
+
+static void
+scene_text_mono(const gui_display_t* disp) {
+    scene_text(disp, &GUI_Font_Calibri_Bold_8, text);
+}
+
+static void
+scene_text_rle(const gui_display_t* disp) {
+    scene_text(disp, &fonts[0].font, text);
+}
+
+static void
+scene_text_rle_aa(const gui_display_t* disp) {
+    scene_text(disp, &fonts[1].font, text);
+}
+
+static void
+scene_text_aa4(const gui_display_t* disp) {
+    scene_text(disp, &fonts[2].font, text);
+}
+
+static void
+scene_text_aa8(const gui_display_t* disp) {
+    scene_text(disp, &fonts[3].font, text);
+}
+
+/**
+ * \brief           Draw text with kerning pairs, first line without kerning for comparison
+ */
+static void
+scene_text_kerning(const gui_display_t* disp) {
+    draw_text(disp, &GUI_Font_Arial_Bold_18, text_kerning, 70, 110, 125, 20, GUI_HALIGN_LEFT | GUI_VALIGN_TOP, 0);
+    scene_text(disp, &font_kerning, text_kerning);
+}
+
+/*******************************************/
+/*                 Widgets                 */
+/*******************************************/
+
+static gui_handle_p
+widget_button(gui_handle_p parent) {
+    gui_handle_p h = gui_button_create(0, 10, 10, 120, 40, parent, NULL, 0);
+    gui_widget_settext(h, _GT("Button"));
+    gui_button_setborderradius(gui_button_create(0, 10, 60, 120, 40, parent, NULL, 0), 10);
+    return h;
+}
+
+static gui_handle_p
+widget_checkbox(gui_handle_p parent) {
+    gui_handle_p h = gui_checkbox_create(0, 10, 10, 180, 30, parent, NULL, 0);
+    gui_widget_settext(h, _GT("Checked"));
+    gui_checkbox_setchecked(h, 1);
+    gui_widget_settext(gui_checkbox_create(0, 10, 50, 180, 30, parent, NULL, 0), _GT("Unchecked"));
+    return h;
+}
+
+static gui_handle_p
+widget_radio(gui_handle_p parent) {
+    gui_handle_p h = gui_radio_create(0, 10, 10, 180, 30, parent, NULL, 0);
+    gui_widget_settext(h, _GT("Selected"));
+    gui_radio_setselected(h);
+    gui_widget_settext(gui_radio_create(0, 10, 50, 180, 30, parent, NULL, 0), _GT("Other"));
+    return h;
+}
+
+static gui_handle_p
+widget_edittext(gui_handle_p parent) {
+    gui_handle_p h = gui_edittext_create(0, 10, 10, 180, 36, parent, NULL, 0);
+    gui_widget_alloctextmemory(h, 64);
+    gui_widget_settext(h, _GT("Edit text"));
+    h = gui_edittext_create(0, 10, 56, 180, 80, parent, NULL, 0);
+    gui_edittext_setmultiline(h, 1);
+    gui_widget_alloctextmemory(h, 64);
+    gui_widget_settext(h, _GT("Multi line\r\nedit text"));
+    return h;
+}
+
+static gui_handle_p
+widget_edittext_trans(gui_handle_p parent) {
+    gui_handle_p h = gui_edittext_create(0, 0, 0, GOLDEN_WIDTH, 36, parent, NULL, 0);
+    gui_edittext_setcolor(h, GUI_EDITTEXT_COLOR_BG, GUI_COLOR_TRANS);
+    gui_widget_alloctextmemory(h, 64);
+    gui_widget_settext(h, _GT("Edit text"));
+    return h;
+}
+
+static gui_handle_p
+widget_progbar(gui_handle_p parent) {
+    gui_handle_p h = gui_progbar_create(0, 10, 10, 180, 30, parent, NULL, 0);
+    gui_progbar_setvalue(h, 35);
+    h = gui_progbar_create(0, 10, 50, 180, 30, parent, NULL, 0);
+    gui_progbar_setpercentmode(h, 1);
+    gui_progbar_setvalue(h, 70);
+    return h;
+}
+
+static gui_handle_p
+widget_slider(gui_handle_p parent) {
+    gui_handle_p h = gui_slider_create(0, 10, 10, 150, 30, parent, NULL, 0);
+    gui_slider_setvalue(h, 30);
+    h = gui_slider_create(0, 170, 10, 20, 130, parent, NULL, 0);
+    gui_slider_setmode(h, GUI_SLIDER_MODE_TOP_BOTTOM);
+    gui_slider_setvalue(h, 60);
+    return h;
+}
+
+static gui_handle_p
+widget_led(gui_handle_p parent) {
+    gui_handle_p h = gui_led_create(0, 10, 10, 30, 30, parent, NULL, 0);
+    gui_led_set(h, 1);
+    h = gui_led_create(0, 50, 10, 30, 30, parent, NULL, 0);
+    gui_led_settype(h, GUI_LED_TYPE_CIRCLE);
+    gui_led_set(h, 1);
+    gui_led_create(0, 90, 10, 30, 30, parent, NULL, 0);
+    return h;
+}
+
+static gui_handle_p
+widget_listbox(gui_handle_p parent) {
+    gui_handle_p h = gui_listbox_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_listbox_addstring(h, _GT("Item 1"));
+    gui_listbox_addstring(h, _GT("Item 2"));
+    gui_listbox_addstring(h, _GT("Item 3"));
+    gui_listbox_addstring(h, _GT("Item 4"));
+    gui_listbox_addstring(h, _GT("Item 5"));
+    gui_listbox_addstring(h, _GT("Item 6"));
+    gui_listbox_addstring(h, _GT("Item 7"));
+    gui_listbox_setselection(h, 1);
+    return h;
+}
+
+static gui_handle_p
+widget_listbox_trans(gui_handle_p parent) {
+    gui_handle_p h = gui_listbox_create(0, 0, 0, GOLDEN_WIDTH, 80, parent, NULL, 0);
+    gui_listbox_setcolor(h, GUI_LISTBOX_COLOR_BG, GUI_COLOR_TRANS);
+    gui_listbox_addstring(h, _GT("Item 1"));
+    gui_listbox_addstring(h, _GT("Item 2"));
+    gui_listbox_addstring(h, _GT("Item 3"));
+    gui_listbox_setselection(h, 1);
+    return h;
+}
+
+static gui_handle_p
+widget_dropdown(gui_handle_p parent) {
+    gui_handle_p h = gui_dropdown_create(0, 10, 10, 180, 36, parent, NULL, 0);
+    gui_dropdown_addstring(h, _GT("Selected item"));
+    gui_dropdown_addstring(h, _GT("Other item"));
+    gui_dropdown_setselection(h, 0);
+    return h;
+}
+
+static gui_handle_p
+widget_textview(gui_handle_p parent) {
+    gui_handle_p h = gui_textview_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_widget_settext(h, _GT("Text view wraps long text to multiple lines\r\nand breaks lines on new line characters."));
+    gui_textview_sethalign(h, GUI_TEXTVIEW_HALIGN_CENTER);
+    return h;
+}
+
+static gui_handle_p
+widget_container(gui_handle_p parent) {
+    gui_handle_p h = gui_container_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_container_setcolor(h, GUI_CONTAINER_COLOR_BG, GUI_COLOR_DARKGRAY);
+    gui_widget_settext(gui_button_create(0, 10, 10, 100, 40, h, NULL, 0), _GT("Child"));
+    return h;
+}
+
+static gui_handle_p
+widget_container_trans(gui_handle_p parent) {
+    gui_handle_p h = gui_container_create(0, 0, 0, GOLDEN_WIDTH, 130, parent, NULL, 0);
+    gui_container_setcolor(h, GUI_CONTAINER_COLOR_BG, GUI_COLOR_TRANS);
+    gui_widget_settext(gui_button_create(0, 10, 10, 100, 40, h, NULL, 0), _GT("Child"));
+    return h;
+}
+
+static gui_handle_p
+widget_listcontainer(gui_handle_p parent) {
+    gui_handle_p h = gui_listcontainer_create(0, 0, 0, GOLDEN_WIDTH, 130, parent, NULL, 0);
+    gui_widget_settext(gui_button_create(0, 10, 10, 100, 40, h, NULL, 0), _GT("Child"));
+    return h;
+}
+
+static gui_handle_p
+widget_window(gui_handle_p parent) {
+    gui_handle_p h = gui_window_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_widget_settext(h, _GT("Window"));
+    gui_widget_settext(gui_button_create(0, 10, 10, 100, 40, h, NULL, 0), _GT("Child"));
+    return h;
+}
+
+static gui_handle_p
+widget_window_alpha(gui_handle_p parent) {
+    gui_handle_p h = widget_window(parent);
+    gui_widget_setalpha(h, 0x80);
+    return h;
+}
+
+static gui_handle_p
+graph_create(gui_handle_p parent, uint8_t aa) {
+    gui_handle_p h = gui_graph_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_graph_data_p data;
+    int16_t i;
+
+    gui_graph_setaxes(h, 0, 100, -50, 50);
+    gui_graph_zoomreset(h);
+    data = gui_graph_data_create(0, GUI_GRAPH_TYPE_XY, 11);
+    if (data != NULL) {
+        for (i = 0; i <= 10; i++) {
+            gui_graph_data_addvalue(data, i * 10, (int16_t)((i * 37) % 90 - 45));
+        }
+        gui_graph_data_setcolor(data, GUI_COLOR_RED);
+        gui_graph_data_setantialias(data, aa);
+        gui_graph_attachdata(h, data);
+    }
+    return h;
+}
+
+static gui_handle_p
+widget_graph(gui_handle_p parent) {
+    return graph_create(parent, 0);
+}
+
+static gui_handle_p
+widget_graph_aa(gui_handle_p parent) {
+    return graph_create(parent, 1);
+}
+
+static gui_handle_p
+widget_listview(gui_handle_p parent) {
+    gui_handle_p h = gui_listview_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    gui_listview_row_p row;
+    size_t i;
+
+    gui_widget_setfont(h, &GUI_Font_Calibri_Bold_8);
+    gui_listview_addcolumn(h, _GT("Name"), 80);
+    gui_listview_addcolumn(h, _GT("Value"), 80);
+    for (i = 0; i < 12; i++) {
+        row = gui_listview_addrow(h);
+        gui_listview_setitemstring(h, row, 0, _GT("Row"));
+        gui_listview_setitemstring(h, row, 1, i & 1 ? _GT("Odd") : _GT("Even"));
+    }
+    gui_listview_setselection(h, 2);
+    return h;
+}
+
+static gui_handle_p
+widget_debugbox(gui_handle_p parent) {
+    gui_handle_p h = gui_debugbox_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    size_t i;
+
+    gui_widget_setfont(h, &GUI_Font_Calibri_Bold_8);
+    for (i = 0; i < 20; i++) {
+        gui_debugbox_addstring(h, i & 1 ? _GT("Odd debug line") : _GT("Even debug line"));
+    }
+    return h;
+}
+
+static gui_handle_p
+widget_image(gui_handle_p parent) {
+    static gui_image_desc_t img[3];
+    gui_handle_p h = NULL;
+    size_t i;
+
+    for (i = 0; i < 3; i++) {
+        img[i].x_size = 48;
+        img[i].y_size = 48;
+        img[i].bpp = (uint8_t)(16 + 8 * i);
+        img[i].image = img_data[i];
+        h = gui_image_create(0, 10 + 60 * (float)i, 10, 48, 48, parent, NULL, 0);
+        gui_image_setsource(h, &img[i]);
+    }
+    return h;
+}
+
+/**
+ * \brief           Image widgets partly above top edge of transparent container,
+ *                  drawn to virtual layer narrower than screen
+ */
+static gui_handle_p
+widget_image_alpha(gui_handle_p parent) {
+    static gui_image_desc_t img[3];
+    gui_handle_p h = gui_container_create(0, 10, 10, 180, 130, parent, NULL, 0);
+    size_t i;
+
+    gui_container_setcolor(h, GUI_CONTAINER_COLOR_BG, GUI_COLOR_DARKGRAY);
+    gui_widget_setalpha(h, 0xA0);
+    for (i = 0; i < 3; i++) {
+        img[i].x_size = 48;
+        img[i].y_size = 48;
+        img[i].bpp = (uint8_t)(16 + 8 * i);
+        img[i].image = img_data[i];
+        gui_image_setsource(gui_image_create(0, 10 + 55 * (float)i, -20, 48, 48, h, NULL, 0), &img[i]);
+    }
+    return h;
+}
+
+/**
+ * \brief           Image widgets larger and smaller than image, with both filters
+ */
+static gui_handle_p
+widget_image_scaled(gui_handle_p parent) {
+    static gui_image_desc_t img;
+    gui_handle_p h = NULL;
+    size_t i;
+
+    img.x_size = 48;
+    img.y_size = 48;
+    img.bpp = 32;
+    img.image = img_data[2];
+    for (i = 0; i < 4; i++) {
+        h = gui_image_create(0, 10 + 100 * (float)(i / 2), 10 + 100 * (float)(i % 2), i & 1 ? 32 : 96, i & 1 ? 24 : 80, parent, NULL, 0);
+        gui_image_setsource(h, &img);
+        gui_image_setfilter(h, i < 2 ? GUI_IMAGE_FILTER_NEAREST : GUI_IMAGE_FILTER_BILINEAR);
+    }
+    return h;
+}
+
+static const golden_case_t
+cases[] = {
+    {"setpixel",                shape_setpixel,                 NULL, NULL},
+    {"hline",                   shape_hline,                    NULL, NULL},
+    {"vline",                   shape_vline,                    NULL, NULL},
+    {"line",                    shape_line,                     NULL, NULL},
+    {"line_aa",                 shape_line_aa,                  NULL, NULL},
+    {"rectangle",               shape_rectangle,                NULL, NULL},
+    {"filledrectangle",         shape_filledrectangle,          NULL, NULL},
+    {"filledrectangle_alpha",   shape_filledrectangle_alpha,    NULL, NULL},
+    {"rectangle_ex",            shape_rectangle_ex,             NULL, NULL},
+    {"rectangle3d",             shape_rectangle3d,              NULL, NULL},
+    {"roundedrectangle",        shape_roundedrectangle,         NULL, NULL},
+    {"filledroundedrectangle",  shape_filledroundedrectangle,   NULL, NULL},
+    {"circle",                  shape_circle,                   NULL, NULL},
+    {"filledcircle",            shape_filledcircle,             NULL, NULL},
+    {"roundedrectangle_aa",     shape_roundedrectangle_aa,      NULL, NULL},
+    {"filledroundedrectangle_aa", shape_filledroundedrectangle_aa, NULL, NULL},
+    {"circle_aa",               shape_circle_aa,                NULL, NULL},
+    {"filledcircle_aa",         shape_filledcircle_aa,          NULL, NULL},
+    {"circlecorner",            shape_circlecorner,             NULL, NULL},
+    {"filledcirclecorner",      shape_filledcirclecorner,       NULL, NULL},
+    {"arc",                     shape_arc,                      NULL, NULL},
+    {"pie",                     shape_pie,                      NULL, NULL},
+    {"ring",                    shape_ring,                     NULL, NULL},
+    {"triangle",                shape_triangle,                 NULL, NULL},
+    {"filledtriangle",          shape_filledtriangle,           NULL, NULL},
+    {"poly",                    shape_poly,                     NULL, NULL},
+    {"filledpoly",              shape_filledpoly,               NULL, NULL},
+    {"scrollbar",               shape_scrollbar,                NULL, NULL},
+    {"image16",                 shape_image16,                  NULL, NULL},
+    {"image24",                 shape_image24,                  NULL, NULL},
+    {"image32",                 shape_image32,                  NULL, NULL},
+    {"image_premultiplied",     shape_image_premultiplied,      NULL, NULL},
+    {"image_indexed",           shape_image_indexed,            NULL, NULL},
+    {"image_rle",               shape_image_rle,                NULL, NULL},
+    {"image_qoi",               shape_image_qoi,                NULL, NULL},
+    {"image_scaled",            shape_image_scaled,             NULL, NULL},
+    {"image_scaled_bilinear",   shape_image_scaled_bilinear,    NULL, NULL},
+    {"image_rotated",           shape_image_rotated,            NULL, NULL},
+    {"image_part",              shape_image_part,               NULL, NULL},
+    {"image_blit_qoi",          shape_image_blit_qoi,           NULL, NULL},
+    {"image_blit_rle",          shape_image_blit_rle,           NULL, NULL},
+    {"image_trimmed",           shape_image_trimmed,            NULL, NULL},
+    {"writetext_aa",            NULL,   scene_text_aa,          NULL},
+    {"writetext",               NULL,   scene_text_mono,        NULL},
+    {"writetext_rle",           NULL,   scene_text_rle,         NULL},
+    {"writetext_rle_aa",        NULL,   scene_text_rle_aa,      NULL},
+    {"writetext_aa4",           NULL,   scene_text_aa4,         NULL},
+    {"writetext_aa8_rle",       NULL,   scene_text_aa8,         NULL},
+    {"writetext_kerning",       NULL,   scene_text_kerning,     NULL},
+    {"widget_button",           NULL,   NULL,   widget_button},
+    {"widget_checkbox",         NULL,   NULL,   widget_checkbox},
+    {"widget_radio",            NULL,   NULL,   widget_radio},
+    {"widget_edittext",         NULL,   NULL,   widget_edittext},
+    {"widget_edittext_trans",   NULL,   NULL,   widget_edittext_trans},
+    {"widget_progbar",          NULL,   NULL,   widget_progbar},
+    {"widget_slider",           NULL,   NULL,   widget_slider},
+    {"widget_led",              NULL,   NULL,   widget_led},
+    {"widget_listbox",          NULL,   NULL,   widget_listbox},
+    {"widget_listbox_trans",    NULL,   NULL,   widget_listbox_trans},
+    {"widget_dropdown",         NULL,   NULL,   widget_dropdown},
+    {"widget_textview",         NULL,   NULL,   widget_textview},
+    {"widget_container",        NULL,   NULL,   widget_container},
+    {"widget_container_trans",  NULL,   NULL,   widget_container_trans},
+    {"widget_listcontainer",    NULL,   NULL,   widget_listcontainer},
+    {"widget_window",           NULL,   NULL,   widget_window},
+    {"widget_window_alpha",     NULL,   NULL,   widget_window_alpha},
+    {"widget_graph",            NULL,   NULL,   widget_graph},
+    {"widget_graph_aa",         NULL,   NULL,   widget_graph_aa},
+    {"widget_listview",         NULL,   NULL,   widget_listview},
+    {"widget_debugbox",         NULL,   NULL,   widget_debugbox},
+    {"widget_image",            NULL,   NULL,   widget_image},
+    {"widget_image_scaled",     NULL,   NULL,   widget_image_scaled},
+    {"widget_image_alpha",      NULL,   NULL,   widget_image_alpha},
+};
+
+/* Sizes of shapes in first row, from single pixel to large shapes */
+static const gui_dim_t sizes[] = {1, 2, 3, 4, 7, 12, 20, 33, 50};
+
+/**
+ * \brief           Draw shape in all sizes and in positions crossing screen edges
+ */
+static void
+draw_shapes(const gui_display_t* disp, golden_shape_fn fn) {
+    gui_dim_t x = 3;
+    size_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(sizes); i++) {
+        fn(disp, x, 3, sizes[i]);
+        x += sizes[i] + 3;
+    }
+    fn(disp, -15, 60, 45);                      /* Left edge */
+    fn(disp, 40, 60, 64);
+    fn(disp, GOLDEN_WIDTH - 25, 60, 45);        /* Right edge */
+    fn(disp, 120, GOLDEN_HEIGHT - 20, 45);      /* Bottom edge */
+    fn(disp, 168, -10, 28);                     /* Top edge */
+}
+
+/**
+ * \brief           Create test images with gradients and alpha
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+create_images(void) {
+    size_t i, count = GOLDEN_IMG_SIZE * GOLDEN_IMG_SIZE;
+
+    for (i = 0; i < 3; i++) {
+        if ((img_data[i] = malloc(count * (i + 2))) == NULL) {
+            return 0;
+        }
+    }
+    for (i = 0; i < count; i++) {
+        uint8_t r = (uint8_t)(i * 4), g = (uint8_t)(i / GOLDEN_IMG_SIZE * 4), b = (uint8_t)(i * 7 + i / 13);
+        uint16_t c16 = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+
+        img_data[0][2 * i + 0] = (uint8_t)c16;
+        img_data[0][2 * i + 1] = (uint8_t)(c16 >> 8);
+        img_data[1][3 * i + 0] = b;
+        img_data[1][3 * i + 1] = g;
+        img_data[1][3 * i + 2] = r;
+        img_data[2][4 * i + 0] = b;
+        img_data[2][4 * i + 1] = g;
+        img_data[2][4 * i + 2] = r;
+        img_data[2][4 * i + 3] = (uint8_t)(0x40 + (i % GOLDEN_IMG_SIZE) * 3);  /* Alpha gradient */
+    }
+    for (i = 1; i < GUI_COUNT_OF(img_palette); i++) {
+        img_palette[i] = (i % 5 ? 0xFF000000UL : 0x80000000UL)
+            | ((gui_color_t)(uint8_t)(i * 37) << 16) | ((gui_color_t)(uint8_t)(i * 91) << 8) | (uint8_t)(0xFF - i * 13);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Pack pixel values MSB first, starting on byte boundary
+ * \return          Pointer to end of packed data
+ */
+static uint8_t*
+font_pack(uint8_t* out, const uint8_t* values, size_t count, uint8_t bpp) {
+    size_t i;
+
+    memset(out, 0x00, (count * bpp + 7) / 8);
+    for (i = 0; i < count; i++) {
+        out[i * bpp / 8] |= (uint8_t)(values[i] << (8 - bpp - (i * bpp) % 8));
+    }
+    return out + (count * bpp + 7) / 8;
+}
+
+/**
+ * \brief           Encode character pixel values, check \ref GUI_FONT_RLE for format
+ * \return          Pointer to end of encoded data
+ */
+static uint8_t*
+font_encode_rle(uint8_t* out, const uint8_t* values, size_t count, uint8_t bpp) {
+    uint8_t max = (uint8_t)((1U << bpp) - 1);
+    size_t i = 0, n;
+
+    while (i < count) {
+        for (n = 1; i + n < count && n < GUI_FONT_RLE_REPEAT_MAX && values[i + n] == values[i]; n++) {}
+        if ((values[i] == 0 || values[i] == max) && n > 1) {
+            *out++ = (uint8_t)(GUI_FONT_RLE_REPEAT | (values[i] ? GUI_FONT_RLE_SOLID : 0) | (n - 1));
+        } else {
+            /* Literal run ends where next transparent or solid run starts */
+            for (n = 1; i + n < count && n < GUI_FONT_RLE_LITERAL_MAX
+                && !(i + n + 1 < count && values[i + n] == values[i + n + 1]
+                    && (values[i + n] == 0 || values[i + n] == max)); n++) {}
+            *out++ = (uint8_t)(n - 1);
+            out = font_pack(out, &values[i], n, bpp);
+        }
+        i += n;
+    }
+    return out;
+}
+
+/**
+ * \brief           Create font in format of flags from built-in font
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+create_font(golden_font_t* f) {
+    static uint8_t values[255 * 255];
+    const gui_font_t* src = f->src;
+    const gui_font_char_t* c;
+    gui_font_char_t* chars;
+    const uint8_t* in;
+    uint8_t* out, src_bpp, bpp, bits;
+    size_t i, count, x, y, size = 0;
+
+    count = src->codes != NULL ? src->codes_count : (size_t)(src->endchar - src->startchar + 1);
+    for (i = 0; i < count; i++) {
+        size += 2 * (size_t)src->data[i].x_size * src->data[i].y_size + 1;  /* Worst case for both formats */
+    }
+    if ((f->mem = malloc(count * sizeof(*chars) + size)) == NULL) {
+        return 0;
+    }
+    chars = f->mem;
+    out = (uint8_t *)&chars[count];
+
+    src_bpp = src->flags & GUI_FLAG_FONT_AA ? 2 : 1;
+    bpp = f->flags & GUI_FLAG_FONT_AA8 ? 8 : f->flags & GUI_FLAG_FONT_AA4 ? 4 : f->flags & GUI_FLAG_FONT_AA ? 2 : 1;
+    for (i = 0; i < count; i++) {
+        c = &src->data[i];
+        chars[i] = *c;
+        chars[i].data = out;
+
+        /* Read values of not encoded font, each line starts on byte boundary */
+        in = c->data;
+        for (y = 0; y < c->y_size; y++) {
+            for (x = 0, bits = 0; x < c->x_size; x++) {
+                if (!bits) {
+                    bits = 8;
+                }
+                bits -= src_bpp;
+                values[y * c->x_size + x] = (uint8_t)(((*in >> bits) & ((1U << src_bpp) - 1))
+                    * ((1U << bpp) - 1) / ((1U << src_bpp) - 1));
+                if (!bits || x + 1 == c->x_size) {
+                    in++;
+                }
+            }
+        }
+        if (f->flags & GUI_FLAG_FONT_RLE) {
+            out = font_encode_rle(out, values, (size_t)c->x_size * c->y_size, bpp);
+        } else {
+            for (y = 0; y < c->y_size; y++) {
+                out = font_pack(out, &values[y * c->x_size], c->x_size, bpp);
+            }
+        }
+    }
+    f->font = *src;
+    f->font.flags = f->flags;
+    f->font.data = chars;
+    return 1;
+}
+
+/**
+ * \brief           Create fonts in all formats
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+create_fonts(void) {
+    size_t i;
+
+    for (i = 0; i < GUI_COUNT_OF(fonts); i++) {
+        if (!create_font(&fonts[i])) {
+            return 0;
+        }
+    }
+    font_kerning = GUI_Font_Arial_Bold_18;
+    font_kerning.kerning = kerning;
+    font_kerning.kerning_count = GUI_COUNT_OF(kerning);
+    return 1;
+}
+
+/**
+ * \brief           Read drawing layer to RGB image
+ * \param[out]      rgb: Output image with 3 bytes per pixel
+ */
+static void
+capture_layer(uint8_t* rgb) {
+    gui_display_t disp = {0, 0, GOLDEN_WIDTH, GOLDEN_HEIGHT};
+    gui_color_t c;
+    gui_dim_t x, y;
+
+    for (y = 0; y < GOLDEN_HEIGHT; y++) {
+        for (x = 0; x < GOLDEN_WIDTH; x++, rgb += 3) {
+            c = gui_draw_getpixel(&disp, x, y);
+            rgb[0] = (uint8_t)(c >> 16);
+            rgb[1] = (uint8_t)(c >> 8);
+            rgb[2] = (uint8_t)c;
+        }
+    }
+}
+
+/**
+ * \brief           Read displayed frame to RGB image
+ * \param[out]      rgb: Output image with 3 bytes per pixel
+ */
+static void
+capture_frame(uint8_t* rgb) {
+    const uint8_t* fb = gui_ll_headless_getframe();
+    size_t i;
+
+    for (i = 0; i < (size_t)GOLDEN_WIDTH * GOLDEN_HEIGHT; i++, rgb += 3) {
+        if (pixel_size == 2) {
+            uint16_t c = (uint16_t)(fb[2 * i] | (fb[2 * i + 1] << 8));
+            rgb[0] = (uint8_t)(((c >> 11) & 0x1F) << 3);
+            rgb[1] = (uint8_t)(((c >> 5) & 0x3F) << 2);
+            rgb[2] = (uint8_t)((c & 0x1F) << 3);
+        } else {
+            rgb[0] = fb[4 * i + 2];
+            rgb[1] = fb[4 * i + 1];
+            rgb[2] = fb[4 * i + 0];
+        }
+    }
+}
+
+/**
+ * \brief           Process GUI until all changes are drawn
+ */
+static void
+settle(void) {
+    size_t i;
+
+    for (i = 0; i < 8; i++) {
+        gui_process();
+    }
+}
+
+/**
+ * \brief           Render case to RGB image
+ * \param[in]       c: Case to render
+ * \param[in]       clip: Set to `1` to use clipping region smaller than screen
+ * \param[out]      rgb: Output image with 3 bytes per pixel
+ */
+static void
+render(const golden_case_t* c, uint8_t clip, uint8_t* rgb) {
+    gui_display_t full = {0, 0, GOLDEN_WIDTH, GOLDEN_HEIGHT};
+    gui_display_t part = {17, 11, GOLDEN_WIDTH - 27, GOLDEN_HEIGHT - 19};
+
+    if (c->widget_fn != NULL) {
+        gui_handle_p parent;
+
+        /* Widgets are created on full screen container, removed together after capture */
+        parent = gui_container_create(0, 0, 0, GOLDEN_WIDTH, GOLDEN_HEIGHT, gui_window_getdesktop(), NULL, 0);
+        gui_container_setcolor(parent, GUI_CONTAINER_COLOR_BG, GOLDEN_BG);
+        c->widget_fn(parent);
+        settle();
+        capture_frame(rgb);
+        gui_widget_remove(&parent);
+        settle();
+    } else {
+        gui_draw_fillscreen(&full, GOLDEN_BG);
+        if (c->shape_fn != NULL) {
+            draw_shapes(clip ? &part : &full, c->shape_fn);
+        } else {
+            c->scene_fn(clip ? &part : &full);
+        }
+        capture_layer(rgb);
+    }
+}
+
+/**
+ * \brief           Write RGB image to binary PPM file
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+write_ppm(const char* path, const uint8_t* rgb) {
+    FILE* f = fopen(path, "wb");
+
+    if (f == NULL) {
+        return 0;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", GOLDEN_WIDTH, GOLDEN_HEIGHT);
+    fwrite(rgb, 3, (size_t)GOLDEN_WIDTH * GOLDEN_HEIGHT, f);
+    return fclose(f) == 0;
+}
+
+/**
+ * \brief           Read RGB image from binary PPM file
+ * \return          `1` on success, `0` when file does not exist or has different size
+ */
+static uint8_t
+read_ppm(const char* path, uint8_t* rgb) {
+    FILE* f = fopen(path, "rb");
+    int w, h, max;
+    uint8_t ok;
+
+    if (f == NULL) {
+        return 0;
+    }
+    ok = fscanf(f, "P6 %d %d %d", &w, &h, &max) == 3 && fgetc(f) != EOF
+        && w == GOLDEN_WIDTH && h == GOLDEN_HEIGHT && max == 255
+        && fread(rgb, 3, (size_t)w * h, f) == (size_t)w * h;
+    fclose(f);
+    return ok;
+}
+
+/**
+ * \brief           Compare image with golden image and write diff image when different
+ * \param[in]       name: Case name
+ * \param[in]       actual: Rendered image
+ * \param[in]       golden_dir: Golden images directory
+ * \param[in]       out_dir: Output directory for failed cases
+ * \return          `1` when images are equal, `0` otherwise
+ */
+static uint8_t
+compare(const char* name, const uint8_t* actual, const char* golden_dir, const char* out_dir) {
+    static uint8_t golden[GOLDEN_WIDTH * GOLDEN_HEIGHT * 3], diff[GOLDEN_WIDTH * GOLDEN_HEIGHT * 3];
+    int x, y, x1 = GOLDEN_WIDTH, y1 = GOLDEN_HEIGHT, x2 = -1, y2 = -1;
+    size_t i, count = 0;
+    char path[512];
+
+    sprintf(path, "%.400s/%s.ppm", golden_dir, name);
+    if (!read_ppm(path, golden)) {
+        printf("FAIL %-28s missing golden image %s\n", name, path);
+        return 0;
+    }
+    for (y = 0; y < GOLDEN_HEIGHT; y++) {
+        for (x = 0; x < GOLDEN_WIDTH; x++) {
+            i = 3 * ((size_t)y * GOLDEN_WIDTH + x);
+            if (memcmp(&actual[i], &golden[i], 3)) {
+                diff[i + 0] = 0xFF;
+                diff[i + 1] = 0x00;
+                diff[i + 2] = 0x00;
+                x1 = GUI_MIN(x1, x);
+                y1 = GUI_MIN(y1, y);
+                x2 = GUI_MAX(x2, x);
+                y2 = GUI_MAX(y2, y);
+                count++;
+            } else {                            /* Dimmed golden pixel for orientation */
+                diff[i + 0] = (uint8_t)(0x80 + golden[i + 0] / 4);
+                diff[i + 1] = (uint8_t)(0x80 + golden[i + 1] / 4);
+                diff[i + 2] = (uint8_t)(0x80 + golden[i + 2] / 4);
+            }
+        }
+    }
+    if (count == 0) {
+        printf("ok   %s\n", name);
+        return 1;
+    }
+
+    printf("FAIL %-28s %lu pixels differ in area (%d, %d) - (%d, %d)\n", name, (unsigned long)count, x1, y1, x2, y2);
+    sprintf(path, "%.400s/%s.actual.ppm", out_dir, name);
+    write_ppm(path, actual);
+    sprintf(path, "%.400s/%s.diff.ppm", out_dir, name);
+    write_ppm(path, diff);
+    return 0;
+}
+
+int
+main(int argc, char** argv) {
+    static uint8_t rgb[GOLDEN_WIDTH * GOLDEN_HEIGHT * 3];
+    const char* golden_dir = "golden", *out_dir = ".", *filter = NULL;
+    uint8_t update = 0, clip;
+    size_t c, failed = 0, passed = 0;
+    char name[64], path[512];
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-u")) {
+            update = 1;
+        } else if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            golden_dir = argv[++i];
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            pixel_size = (uint8_t)atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [-u] [-g DIR] [-o DIR] [-f FILTER] [-p PIXEL_SIZE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (pixel_size != 2 && pixel_size != 4) {
+        fprintf(stderr, "Invalid pixel size\n");
+        return 2;
+    }
+    if (!gui_ll_headless_setup(GOLDEN_WIDTH, GOLDEN_HEIGHT, pixel_size) || gui_init() != guiOK || !create_images() || !create_fonts()) {
+        fprintf(stderr, "GUI initialization failed\n");
+        return 2;
+    }
+    gui_widget_setfontdefault(&GUI_Font_Arial_Bold_18);
+    settle();                                   /* Draw empty desktop */
+
+    for (c = 0; c < GUI_COUNT_OF(cases); c++) {
+        if (filter != NULL && strstr(cases[c].name, filter) == NULL) {
+            continue;
+        }
+        for (clip = 0; clip < (cases[c].widget_fn == NULL ? 2 : 1); clip++) {
+            sprintf(name, "%s%s", cases[c].name, clip ? "_clip" : "");
+            render(&cases[c], clip, rgb);
+            if (update) {
+                sprintf(path, "%.400s/%s.ppm", golden_dir, name);
+                if (!write_ppm(path, rgb)) {
+                    fprintf(stderr, "Cannot write %s\n", path);
+                    return 2;
+                }
+                passed++;
+            } else if (compare(name, rgb, golden_dir, out_dir)) {
+                passed++;
+            } else {
+                failed++;
+            }
+        }
+    }
+    if (update) {
+        printf("%lu golden images written to %s\n", (unsigned long)passed, golden_dir);
+    } else {
+        printf("%lu passed, %lu failed\n", (unsigned long)passed, (unsigned long)failed);
+    }
+
+    for (i = 0; i < 3; i++) {
+        free(img_data[i]);
+    }
+    for (c = 0; c < GUI_COUNT_OF(fonts); c++) {
+        free(fonts[c].mem);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,513 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017 Tilen Majerle
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation
+# files (the "Software"), to deal in the Software without restriction,
+# including without limitation the rights to use, copy, modify, merge,
+# publish, distribute, sublicense, and/or sell copies of the Software,
+# and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+# AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+# HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+# This file is part of EasyGUI library.
+#
+# Author:          Tilen Majerle <tilen@majerle.eu>
+#
+"""
+EasyGUI image compiler
+
+Converts PNG images to C source file with gui_image_desc_t structures.
+PNG files are decoded directly, no python packages are required.
+
+Examples:
+
+    # Single icon, run-length encoded, transparent border removed
+    image_compiler.py icon_wifi.png --format rle --trim -o icon_wifi.c
+
+    # All images of application with options per image, header and size manifest
+    image_compiler.py --assets assets.json -o images.c --header images.h --manifest images.json
+
+Assets file is JSON list of images, paths are relative to assets file.
+Options not set for image are taken from command line:
+
+    [
+        {"file": "background.png", "format": "qoi"},
+        {"file": "icon_wifi.png", "name": "Wifi", "format": "indexed", "trim": true},
+        {"file": "button.png", "format": "raw32", "premultiply": true}
+    ]
+
+Formats:
+
+    raw16:      RGB565 pixels with blue in upper bits, alpha is dropped
+    raw24:      R, G, B bytes, alpha is dropped
+    raw32:      R, G, B bytes and inverted alpha byte
+    indexed:    Palette indices with 1, 2, 4 or 8 bits per pixel, ARGB8888 palette
+    rle:        Run-length encoded ARGB8888 pixels, see GUI_IMAGE_RLE
+    qoi:        QOI (Quite OK Image) file
+
+Manifest lists size of data for each image in selected format and in all
+other possible formats, so format can be chosen per image
+for its flash size and drawing speed. Output only depends on input files
+and options, manifest includes SHA-256 of each input file.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import re
+import struct
+import sys
+import zlib
+
+FORMATS = ("raw16", "raw24", "raw32", "indexed", "rle", "qoi")
+FORMAT_ENUM = {
+    "raw16": "GUI_IMAGE_FORMAT_RAW",
+    "raw24": "GUI_IMAGE_FORMAT_RAW",
+    "raw32": "GUI_IMAGE_FORMAT_RAW",
+    "indexed": "GUI_IMAGE_FORMAT_INDEXED",
+    "rle": "GUI_IMAGE_FORMAT_RLE",
+    "qoi": "GUI_IMAGE_FORMAT_QOI",
+}
+
+RLE_REPEAT = 0x80                   # Must match GUI_IMAGE_RLE_REPEAT
+RLE_RUN_MAX = 0x80                  # Must match GUI_IMAGE_RLE_RUN_MAX
+
+QOI_OP_INDEX = 0x00
+QOI_OP_DIFF = 0x40
+QOI_OP_LUMA = 0x80
+QOI_OP_RUN = 0xC0
+QOI_OP_RGB = 0xFE
+QOI_OP_RGBA = 0xFF
+
+
+class Image:
+    """Decoded image with ARGB8888 pixels, row by row"""
+
+    def __init__(self, width, height, pixels):
+        self.width = width
+        self.height = height
+        self.pixels = pixels        # List of width * height ARGB8888 values
+        self.x_offset = 0           # Position of pixels inside original image
+        self.y_offset = 0
+
+    def has_alpha(self):
+        return any((c >> 24) != 0xFF for c in self.pixels)
+
+    def trim(self):
+        """Remove fully transparent rows and columns around image"""
+        w, px = self.width, self.pixels
+        rows = [y for y in range(self.height) if any(c >> 24 for c in px[y * w:(y + 1) * w])]
+        if not rows:                # Keep single transparent pixel
+            self.width = self.height = 1
+            self.pixels = [0]
+            return
+        cols = [x for x in range(w) if any(px[y * w + x] >> 24 for y in rows)]
+        x1, x2, y1, y2 = cols[0], cols[-1] + 1, rows[0], rows[-1] + 1
+        self.pixels = [px[y * w + x] for y in range(y1, y2) for x in range(x1, x2)]
+        self.x_offset += x1
+        self.y_offset += y1
+        self.width = x2 - x1
+        self.height = y2 - y1
+
+
+#
+# PNG loader
+#
+def load_png(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG file" % path)
+
+    pos, idat, plte, trns = 8, [], None, None
+    while pos + 8 <= len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            plte = chunk
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat.append(chunk)
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNG is not supported, save it without interlacing" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bpp = max(1, channels * depth // 8)         # Bytes per pixel for filter
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(b"".join(idat))
+
+    # Remove filters, line by line
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        ft = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ft == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ft == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ft == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ft == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    # Convert samples to ARGB8888
+    pixels = []
+    for line in rows:
+        if depth < 8:
+            samples = [(line[i * depth // 8] >> (8 - depth - (i * depth) % 8)) & ((1 << depth) - 1)
+                       for i in range(width * channels)]
+        elif depth == 16:
+            samples = list(line[0::2])          # Upper byte of each sample
+        else:
+            samples = list(line)
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if ctype == 3:
+                i = s[0]
+                r, g, b = plte[3 * i:3 * i + 3]
+                a = trns[i] if trns is not None and i < len(trns) else 0xFF
+            else:
+                if ctype in (0, 4):
+                    v = s[0] * 255 // ((1 << depth) - 1) if depth < 8 else s[0]
+                    r = g = b = v
+                else:
+                    r, g, b = s[0:3]
+                a = s[-1] if ctype in (4, 6) else 0xFF
+                if trns is not None and ctype in (0, 2):
+                    key = struct.unpack(">%dH" % (len(trns) // 2), trns)
+                    if ctype == 0 and s[0] == (key[0] if depth < 8 else key[0] >> (depth - 8)):
+                        a = 0
+                    elif ctype == 2 and (r, g, b) == tuple(k >> (depth - 8) for k in key):
+                        a = 0
+            pixels.append((a << 24) | (r << 16) | (g << 8) | b)
+    return Image(width, height, pixels)
+
+
+#
+# Encoding
+#
+def premultiply(c):
+    a = c >> 24
+    r, g, b = (c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF
+    return (a << 24) | (((r * a + 127) // 255) << 16) | (((g * a + 127) // 255) << 8) | ((b * a + 127) // 255)
+
+
+def encode_raw16(img):
+    out = []
+    for c in img.pixels:
+        v = ((c & 0xF8) << 8) | ((c >> 5) & 0x07E0) | ((c >> 19) & 0x1F)
+        out.extend((v & 0xFF, v >> 8))
+    return out
+
+
+def encode_raw24(img):
+    out = []
+    for c in img.pixels:
+        out.extend(((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF))
+    return out
+
+
+def encode_raw32(img):
+    out = []
+    for c in img.pixels:
+        out.extend(((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, 0xFF - (c >> 24)))
+    return out
+
+
+def make_palette(img):
+    palette = []
+    for c in img.pixels:
+        if c not in palette:
+            palette.append(c)
+            if len(palette) > 256:
+                return None
+    return palette
+
+
+def encode_indexed(img, palette, bpp):
+    lookup = {c: i for i, c in enumerate(palette)}
+    out = []
+    for y in range(img.height):
+        byte, bits = 0, 0
+        for c in img.pixels[y * img.width:(y + 1) * img.width]:
+            byte = (byte << bpp) | lookup[c]
+            bits += bpp
+            if bits == 8:
+                out.append(byte)
+                byte, bits = 0, 0
+        if bits:                            # Each line starts on byte boundary
+            out.append(byte << (8 - bits))
+    return out
+
+
+def encode_rle(img):
+    px, out, i = img.pixels, [], 0
+
+    def color(c):
+        return [c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, c >> 24]
+
+    while i < len(px):
+        n = 1
+        while i + n < len(px) and n < RLE_RUN_MAX and px[i + n] == px[i]:
+            n += 1
+        if n > 1:
+            out.append(RLE_REPEAT | (n - 1))
+            out.extend(color(px[i]))
+        else:                               # Literal run ends where next repeated pixels start
+            while i + n < len(px) and n < RLE_RUN_MAX and (i + n + 1 >= len(px) or px[i + n] != px[i + n + 1]):
+                n += 1
+            out.append(n - 1)
+            for c in px[i:i + n]:
+                out.extend(color(c))
+        i += n
+    return out
+
+
+def encode_qoi(img):
+    out = list(b"qoif" + struct.pack(">IIBB", img.width, img.height, 4, 0))
+    index, prev, run = [0] * 64, 0xFF000000, 0
+    for i, c in enumerate(img.pixels):
+        if c == prev:
+            run += 1
+            if run == 62 or i + 1 == len(img.pixels):
+                out.append(QOI_OP_RUN | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(QOI_OP_RUN | (run - 1))
+            run = 0
+        a, r, g, b = c >> 24, (c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF
+        h = (r * 3 + g * 5 + b * 7 + a * 11) & 0x3F
+        if index[h] == c:
+            out.append(QOI_OP_INDEX | h)
+        elif a != prev >> 24:
+            out.extend((QOI_OP_RGBA, r, g, b, a))
+        else:
+            vr = ((r - ((prev >> 16) & 0xFF) + 128) & 0xFF) - 128
+            vg = ((g - ((prev >> 8) & 0xFF) + 128) & 0xFF) - 128
+            vb = ((b - (prev & 0xFF) + 128) & 0xFF) - 128
+            if -2 <= vr <= 1 and -2 <= vg <= 1 and -2 <= vb <= 1:
+                out.append(QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2))
+            elif -32 <= vg <= 31 and -8 <= vr - vg <= 7 and -8 <= vb - vg <= 7:
+                out.extend((QOI_OP_LUMA | (vg + 32), ((vr - vg + 8) << 4) | (vb - vg + 8)))
+            else:
+                out.extend((QOI_OP_RGB, r, g, b))
+        index[h] = c
+        prev = c
+    out.extend((0, 0, 0, 0, 0, 0, 0, 1))     # End marker
+    return out
+
+
+def index_bpp(colors):
+    for bpp in (1, 2, 4, 8):
+        if colors <= (1 << bpp):
+            return bpp
+    return None
+
+
+def encode(img, fmt, bpp=None):
+    """Encode image, return (data, palette, bits per pixel)"""
+    if fmt == "indexed":
+        palette = make_palette(img)
+        if palette is None:
+            raise ValueError("image has more than 256 colors, indexed format is not possible")
+        bpp = bpp or index_bpp(len(palette))
+        if len(palette) > (1 << bpp):
+            raise ValueError("image has %d colors, %d bits per pixel allow only %d" % (len(palette), bpp, 1 << bpp))
+        return encode_indexed(img, palette, bpp), palette, bpp
+    func = {"raw16": encode_raw16, "raw24": encode_raw24, "raw32": encode_raw32, "rle": encode_rle, "qoi": encode_qoi}[fmt]
+    return func(img), None, {"raw16": 16, "raw24": 24}.get(fmt, 32)
+
+
+#
+# Output
+#
+def c_name(text):
+    return re.sub(r"[^0-9A-Za-z_]", "_", text)
+
+
+def format_bytes(data):
+    return ["    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + "," for i in range(0, len(data), 16)]
+
+
+def load_assets(args):
+    """Get list of images with options, from assets file or command line"""
+    defaults = {"format": args.format, "bpp": args.bpp, "premultiply": args.premultiply, "trim": args.trim}
+    if args.assets:
+        with open(args.assets, "r", encoding="utf-8") as f:
+            entries = json.load(f)
+        base = os.path.dirname(args.assets)
+        assets = []
+        for e in entries:
+            a = dict(defaults)
+            a.update(e)
+            a["path"] = os.path.join(base, e["file"])
+            assets.append(a)
+    else:
+        if args.name and len(args.images) > 1:
+            sys.exit("error: --name can only be used with single image")
+        assets = [dict(defaults, file=p, path=p, name=args.name) for p in args.images]
+    for a in assets:
+        if a["format"] not in FORMATS:
+            sys.exit("error: %s: unknown format %s" % (a["file"], a["format"]))
+        if not a.get("name"):
+            a["name"] = os.path.splitext(os.path.basename(a["file"]))[0]
+        a["name"] = c_name(a["name"])
+    return assets
+
+
+def compile_image(asset, lines, header):
+    with open(asset["path"], "rb") as f:
+        digest = hashlib.sha256(f.read()).hexdigest()
+    img = load_png(asset["path"])
+    width, height = img.width, img.height
+    fmt, name = asset["format"], asset["name"]
+
+    img.pixels = [c if c >> 24 else 0 for c in img.pixels]     # Transparent pixels have single value
+    if asset["trim"]:
+        img.trim()
+    alpha = img.has_alpha()
+    premul = asset["premultiply"] and alpha and fmt not in ("raw16", "raw24")
+    if asset["premultiply"] and not premul:
+        print("warning: %s: premultiplied alpha is not used, image format has no alpha" % asset["file"], file=sys.stderr)
+    if alpha and fmt in ("raw16", "raw24"):
+        print("warning: %s: alpha channel is dropped for %s format" % (asset["file"], fmt), file=sys.stderr)
+    if premul:
+        img.pixels = [premultiply(c) for c in img.pixels]
+
+    try:
+        data, palette, bpp = encode(img, fmt, asset["bpp"] if fmt == "indexed" else None)
+    except ValueError as e:
+        sys.exit("error: %s: %s" % (asset["file"], e))
+
+    # Size of image in all possible formats, for choosing format per image
+    sizes = {}
+    for f in FORMATS:
+        if f == fmt:
+            sizes[f] = len(data) + 4 * len(palette or [])
+        elif f != "indexed" or make_palette(img) is not None:
+            d, p, _ = encode(img, f)
+            sizes[f] = len(d) + 4 * len(p or [])
+
+    flags = []
+    if premul:
+        flags.append("GUI_IMAGE_FLAG_PREMULTIPLIED")
+    if not alpha or fmt in ("raw16", "raw24"):
+        flags.append("GUI_IMAGE_FLAG_OPAQUE")    # Widget parent is not redrawn
+    desc = "GUI_Image_" + name
+    lines.append("/* %s: %dx%d, %s%s */" % (
+        os.path.basename(asset["file"]), img.width, img.height, fmt,
+        ", trimmed from %dx%d" % (width, height) if (img.width, img.height) != (width, height) else ""))
+    lines.append("static gui_const uint8_t %s_Data[%d] = {" % (desc, len(data)))
+    lines.extend(format_bytes(data))
+    lines.extend(["};", ""])
+    if palette is not None:
+        lines.append("static gui_const gui_color_t %s_Palette[%d] = {" % (desc, len(palette)))
+        lines.extend("    " + ", ".join("0x%08X" % c for c in palette[i:i + 6]) + "," for i in range(0, len(palette), 6))
+        lines.extend(["};", ""])
+    lines.extend([
+        "gui_const gui_image_desc_t %s = {" % desc,
+        "    %d," % img.width,
+        "    %d," % img.height,
+        "    %d," % bpp,
+        "    %s_Data," % desc,
+        "    %s," % FORMAT_ENUM[fmt],
+        "    %s," % ("%s_Palette" % desc if palette is not None else "NULL"),
+        "    %s," % (" | ".join(flags) if flags else "0"),
+        "    %d," % img.x_offset,
+        "    %d," % img.y_offset,
+        "    %d," % width,
+        "    %d" % height,
+        "};",
+        "",
+    ])
+    header.append("extern gui_const gui_image_desc_t %s;" % desc)
+
+    print("%s: %dx%d %s, %d bytes (raw32 %d bytes)" % (
+        desc, img.width, img.height, fmt, sizes[fmt], sizes["raw32"]), file=sys.stderr)
+    return {
+        "name": desc,
+        "file": asset["file"],
+        "sha256": digest,
+        "width": width,
+        "height": height,
+        "x_size": img.width,
+        "y_size": img.height,
+        "x_offset": img.x_offset,
+        "y_offset": img.y_offset,
+        "format": fmt,
+        "bpp": bpp,
+        "premultiplied": premul,
+        "bytes": sizes[fmt],
+        "sizes": sizes,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert PNG images to EasyGUI image C source")
+    parser.add_argument("images", nargs="*", help="Input PNG files")
+    parser.add_argument("-o", "--output", help="Output C file, standard output when not set")
+    parser.add_argument("-a", "--assets", help="JSON file with list of images and their options")
+    parser.add_argument("-f", "--format", choices=FORMATS, default="raw32", help="Image data format")
+    parser.add_argument("-b", "--bpp", type=int, choices=(1, 2, 4, 8), help="Bits per pixel for indexed format, "
+                        "smallest possible when not set")
+    parser.add_argument("--premultiply", action="store_true", help="Premultiply color channels by alpha")
+    parser.add_argument("--trim", action="store_true", help="Remove transparent border, keep position with offset")
+    parser.add_argument("--name", help="C identifier suffix, used as GUI_Image_<name>")
+    parser.add_argument("--header", help="Output header file with image declarations")
+    parser.add_argument("--manifest", help="Output JSON file with image sizes")
+    args = parser.parse_args()
+    if bool(args.images) == bool(args.assets):
+        parser.error("set either input images or --assets file")
+
+    lines, header, manifest = ["#include \"gui/gui.h\"", ""], [], []
+    for asset in load_assets(args):
+        manifest.append(compile_image(asset, lines, header))
+
+    out = "\n".join(lines)
+    if args.output:
+        with open(args.output, "w", newline="\n") as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+    if args.header:
+        guard = c_name(os.path.basename(args.header)).upper()
+        with open(args.header, "w", newline="\n") as f:
+            f.write("\n".join(["#ifndef %s" % guard, "#define %s" % guard, "", "#include \"gui/gui.h\"", ""]
+                              + header + ["", "#endif /* %s */" % guard, ""]))
+    if args.manifest:
+        with open(args.manifest, "w", newline="\n") as f:
+            json.dump({"images": manifest, "total_bytes": sum(m["bytes"] for m in manifest)}, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+
+if __name__ == "__main__":
+    main()